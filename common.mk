@@ -1,9 +1,16 @@
 # Common library includes
 ALLINC += common/src/
 
+# CAN node generation from DBC files
+# - Note this must be included before ChibiOS's rules, as they expand the list of sources.
+include common/make/dbc.mk
+
 # ChibiOS comilation
 include common/make/chibios.mk
 
+# Generated CAN node headers must exist before any object including them is compiled.
+$(OBJS): | $(DBC_HEADERS)
+
 # Board file generation
 include common/make/board.mk
 
@@ -0,0 +1,35 @@
+# DBC Code Generation ---------------------------------------------------------------------------------------------------------
+#
+# Generates a CAN node (header / source pair) from each DBC file listed in DBC_FILES, see common/tools/dbc_to_can_node.py for
+# details. Each node is named after its DBC file, and receives the messages transmitted by the DBC node of the same name (ex.
+# bms.dbc generates dbc_bms.h and dbc_bms.c, receiving the messages transmitted by the 'BMS' node). The generated sources are
+# added to the compilation, so this must be included before ChibiOS's rules.mk. As the objects are only defined by rules.mk,
+# common.mk orders them after the generated headers.
+
+# ChibiOS's rules.mk defaults the build directory, but is included after this.
+ifeq ($(BUILDDIR),)
+	BUILDDIR := build
+endif
+
+DBC_OUTPUT_DIR ?= $(BUILDDIR)/dbc
+
+DBC_SOURCES = $(patsubst %.dbc,$(DBC_OUTPUT_DIR)/dbc_%.c,$(notdir $(DBC_FILES)))
+DBC_HEADERS = $(patsubst %.dbc,$(DBC_OUTPUT_DIR)/dbc_%.h,$(notdir $(DBC_FILES)))
+
+CSRC += $(DBC_SOURCES)
+ALLINC += $(DBC_OUTPUT_DIR)
+
+vpath %.dbc $(sort $(dir $(DBC_FILES)))
+
+# The rules below precede ChibiOS's 'all', so the default goal is restored after them.
+DBC_DEFAULT_GOAL := $(.DEFAULT_GOAL)
+
+# Note a pattern rule with multiple targets generates all of them in one invocation.
+$(DBC_OUTPUT_DIR)/dbc_%.c $(DBC_OUTPUT_DIR)/dbc_%.h: %.dbc common/tools/dbc_to_can_node.py
+	python3 common/tools/dbc_to_can_node.py $< $(DBC_OUTPUT_DIR)
+
+dbc-files: $(DBC_SOURCES) $(DBC_HEADERS)
+
+.PHONY: dbc-files
+
+.DEFAULT_GOAL := $(DBC_DEFAULT_GOAL)
\ No newline at end of file
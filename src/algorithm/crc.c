@@ -0,0 +1,31 @@
+// Header
+#include "crc.h"
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+/// @brief Table of the CRC-32 (reflected polynomial 0xEDB88320) of each 4-bit value. A nibble-wise table is used over a
+/// byte-wise one to save flash, at the cost of 2 lookups per byte.
+static const uint32_t CRC32_TABLE [16] =
+{
+	0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+	0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+uint32_t crc32Update (uint32_t crc, const void* data, size_t size)
+{
+	const uint8_t* bytes = (const uint8_t*) data;
+
+	// Undo the final inversion of the previous CRC.
+	crc = ~crc;
+
+	for (size_t index = 0; index < size; ++index)
+	{
+		crc ^= bytes [index];
+		crc = (crc >> 4) ^ CRC32_TABLE [crc & 0x0F];
+		crc = (crc >> 4) ^ CRC32_TABLE [crc & 0x0F];
+	}
+
+	return ~crc;
+}
\ No newline at end of file
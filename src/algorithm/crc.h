@@ -0,0 +1,41 @@
+#ifndef CRC_H
+#define CRC_H
+
+// Cyclic Redundancy Check ----------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Functions for calculating cyclic redundancy checks. The CRC-32 is the standard (IEEE 802.3) variant, identical
+//   to that of zlib, Python's zlib.crc32 and binascii.crc32, etc.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// C Standard Library
+#include <stddef.h>
+#include <stdint.h>
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Calculates the CRC-32 of a block of data, continuing from the CRC-32 of any preceding data. This allows the CRC-32
+ * of data that is not contiguous in memory to be calculated in pieces.
+ * @param crc The CRC-32 of the preceding data, use 0 for the first block.
+ * @param data The data to calculate the CRC-32 of.
+ * @param size The size of the @c data , in bytes.
+ * @return The CRC-32 of the preceding data followed by @c data .
+ */
+uint32_t crc32Update (uint32_t crc, const void* data, size_t size);
+
+/**
+ * @brief Calculates the CRC-32 of a block of data.
+ * @param data The data to calculate the CRC-32 of.
+ * @param size The size of the @c data , in bytes.
+ * @return The CRC-32 of the data.
+ */
+static inline uint32_t crc32 (const void* data, size_t size)
+{
+	return crc32Update (0, data, size);
+}
+
+#endif // CRC_H
\ No newline at end of file
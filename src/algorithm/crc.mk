@@ -0,0 +1,9 @@
+ifndef CRC_MK
+define CRC_MK
+1
+endef
+
+# Add the module's source file to the compilation
+CSRC += common/src/algorithm/crc.c
+
+endif # CRC_MK
\ No newline at end of file
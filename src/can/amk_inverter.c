@@ -40,12 +40,21 @@
 
 // Message Flags --------------------------------------------------------------------------------------------------------------
 
+// Note the event flags of amk_inverter.h must match these positions.
 #define FLAG_COUNT					3
 
 #define MOTOR_FEEDBACK_FLAG_POS 	0x00
 #define POWER_CONSUMPTION_FLAG_POS	0x01
 #define TEMPERATURES_FLAG_POS		0x02
 
+/// @brief Offset of the ID of each message, indexed by the message's flag position.
+static const uint16_t MESSAGE_ID_OFFSETS [FLAG_COUNT] =
+{
+	[MOTOR_FEEDBACK_FLAG_POS]		= MOTOR_FEEDBACK_ID_OFFSET,
+	[POWER_CONSUMPTION_FLAG_POS]	= POWER_CONSUMPTION_ID_OFFSET,
+	[TEMPERATURES_FLAG_POS]			= TEMPERATURES_ID_OFFSET
+};
+
 // Message Packing ------------------------------------------------------------------------------------------------------------
 
 // AMK Control Word
@@ -67,25 +76,85 @@
 // Function Prototypes --------------------------------------------------------------------------------------------------------
 
 /**
- * @brief Sends the specified torque request to an AMK inverter.
+ * @brief Packs the frame fulfilling an energization request (see @c amkSendEnergizationRequest ).
+ * @param amk The inverter to request.
+ * @param frame The frame to pack.
+ * @param energized True if the inverter should be energized, false if de-energized.
+ * @param errorReset Indicates that if an error is present, a reset request should be packed in place of this message.
+ * @param result Written with the result of the request if no frame is to be transmitted.
+ * @return True if a frame was packed, false if no frame should be transmitted.
+ */
+bool amkPackEnergizationRequest (amkInverter_t* amk, CANTxFrame* frame, bool energized, bool errorReset, msg_t* result);
+
+/**
+ * @brief Packs the frame fulfilling a torque request (see @c amkSendTorqueRequest ).
+ * @param amk The inverter to request.
+ * @param frame The frame to pack.
+ * @param torqueRequest The amount of torque to request, in Nm.
+ * @param torqueLimitPositive The upper torque limit to apply, in Nm.
+ * @param torqueLimitNegative The lower torque limit to apply, in Nm.
+ * @param errorReset Indicates that if an error is present, a reset request should be packed in place of this message.
+ * @param result Written with the result of the request if no frame is to be transmitted.
+ * @return True if a frame was packed, false if no frame should be transmitted.
+ */
+bool amkPackTorqueRequest (amkInverter_t* amk, CANTxFrame* frame, float torqueRequest, float torqueLimitPositive,
+	float torqueLimitNegative, bool errorReset, msg_t* result);
+
+/**
+ * @brief Packs the frame fulfilling an error reset request (see @c amkSendErrorResetRequest ).
+ * @param amk The inverter to request.
+ * @param frame The frame to pack.
+ * @param result Written with the result of the request if no frame is to be transmitted.
+ * @return True if a frame was packed, false if no frame should be transmitted.
+ */
+bool amkPackErrorResetRequest (amkInverter_t* amk, CANTxFrame* frame, msg_t* result);
+
+/**
+ * @brief Transmits a packed motor request on an inverter's main driver and bridge driver.
  * @param amk The AMK inverter to send the message to.
- * @param inverterEnabled Indicates whether the inverter controller should be enabled (cannot be set until quitDcOn is
- * asserted).
- * @param dcEnabled Indicates whether the DC bus should be enabled (can be asserted any time).
- * @param driverEnabled Indicates whether the inverter driver should be enabled (cannot be asserted until quitInverter is
- * asserted).
- * @param errorReset Indicates whether any present errors should be reset (can only be asserted if all setpoints are 0).
- * @param torqueRequest The torque to request from the motor.
- * @param torqueLimitPositive The positive torque limit to specify.
- * @param torqueLimitNegative The negative torque limit to specify.
+ * @param frame The frame to transmit.
  * @param timeout The interval to timeout after.
- * @return The result of the CAN operation.
+ * @return The result of the CAN operation on the main driver.
  */
-msg_t amkSendMotorRequest (amkInverter_t* amk, bool inverterEnabled, bool dcEnabled, bool driverEnabled, bool errorReset,
-	float torqueRequest, float torqueLimitPositive, float torqueLimitNegative, sysinterval_t timeout);
+msg_t amkTransmitMotorRequest (amkInverter_t* amk, const CANTxFrame* frame, sysinterval_t timeout);
 
 int8_t amkReceiveHandler (void* node, CANRxFrame* frame);
 
+void amkTimeoutHandler (void* node);
+
+/**
+ * @brief Gets the state of an inverter, assuming the specified validity of its CAN node.
+ * @param amk The inverter to check the state of.
+ * @param valid Indicates whether the inverter's CAN node is valid.
+ * @return The state of the inverter.
+ */
+static amkInverterState_t getState (amkInverter_t* amk, bool valid);
+
+/**
+ * @brief Updates an inverter's contribution to its fleet, re-computing the fleet's aggregate.
+ * @note The inverter's CAN node should be locked beforehand.
+ * @param amk The inverter to update.
+ * @param valid Indicates whether the inverter's CAN node is valid.
+ */
+static void fleetUpdate (amkInverter_t* amk, bool valid);
+
+/**
+ * @brief Adds a value to a fleet range.
+ * @param range The range to add to.
+ * @param value The value to add.
+ */
+static void fleetRangeAdd (amkFleetRange_t* range, float value);
+
+/**
+ * @brief Gets the remainder of a timeout started at the specified time.
+ * @param timeStart The time the timeout started at.
+ * @param timeout The interval of the timeout.
+ * @return The remaining interval, @c TIME_IMMEDIATE if the timeout has elapsed.
+ */
+static sysinterval_t remainingTimeout (systime_t timeStart, sysinterval_t timeout);
+
+canId_t amkIdHandler (void* node, uint8_t index);
+
 // Functions ------------------------------------------------------------------------------------------------------------------
 
 void amkInit (amkInverter_t* amk, const amkInverterConfig_t* config)
@@ -94,24 +163,44 @@ void amkInit (amkInverter_t* amk, const amkInverterConfig_t* config)
 	amk->baseId = config->baseId;
 	amk->bridgeDriver = config->bridgeDriver;
 
+	// Join the fleet, if there is room.
+	amk->fleet = NULL;
+	if (config->fleet != NULL && config->fleet->count < AMK_GROUP_COUNT_MAX)
+	{
+		amk->fleet = config->fleet;
+		amk->fleetIndex = config->fleet->count;
+		++config->fleet->count;
+	}
+
 	// Initial values
 	amk->errorResetCount = 0;
 
+	// Enable the DWT cycle counter, used for timing group requests.
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
 	// Initialize the node
 	canNodeConfig_t canConfig =
 	{
-		.driver			= config->mainDriver,
-		.receiveHandler	= amkReceiveHandler,
-		.timeoutHandler	= NULL,
-		.timeoutPeriod	= config->timeoutPeriod,
-		.messageCount	= FLAG_COUNT
+		.driver					= config->mainDriver,
+		.receiveHandler			= amkReceiveHandler,
+		.timeoutHandler			= amkTimeoutHandler,
+		.idHandler				= amkIdHandler,
+		.timeoutPeriod			= config->timeoutPeriod,
+		.messageCount			= FLAG_COUNT,
+		.messageTimeoutPeriods	= config->messageTimeoutPeriods
 	};
 	canNodeInit ((canNode_t*) amk, &canConfig);
 }
 
 amkInverterState_t amkGetState (amkInverter_t* amk)
 {
-	if (amk->state != CAN_NODE_VALID)
+	return getState (amk, amk->state == CAN_NODE_VALID);
+}
+
+static amkInverterState_t getState (amkInverter_t* amk, bool valid)
+{
+	if (!valid)
 		return AMK_STATE_INVALID;
 	if (amk->error || !amk->systemReady)
 		return AMK_STATE_ERROR;
@@ -179,9 +268,234 @@ float amksGetCumulativePower (amkInverter_t* amks, uint32_t count)
 	return totalPower;
 }
 
+// Fleet Functions ------------------------------------------------------------------------------------------------------------
+
+void amkFleetInit (amkFleet_t* fleet)
+{
+	chMtxObjectInit (&fleet->mutex);
+	fleet->sequence = 0;
+	fleet->count = 0;
+
+	for (uint8_t index = 0; index < AMK_GROUP_COUNT_MAX; ++index)
+		fleet->members [index] = (amkFleetMember_t) { .state = AMK_STATE_INVALID };
+
+	fleet->aggregate = (amkFleetAggregate_t) { .state = AMK_STATE_INVALID };
+}
+
+void amkFleetGet (amkFleet_t* fleet, amkFleetAggregate_t* aggregate)
+{
+	for (uint8_t attempt = 0; attempt < CAN_NODE_SNAPSHOT_ATTEMPTS; ++attempt)
+	{
+		// If the aggregate is being modified, retry.
+		uint32_t sequence = fleet->sequence;
+		if ((sequence & 0b1) == 0b1)
+			continue;
+
+		__DMB ();
+		*aggregate = fleet->aggregate;
+		__DMB ();
+
+		// If the aggregate was not modified during the copy, it is consistent.
+		if (fleet->sequence == sequence)
+			return;
+	}
+
+	// Otherwise, the writer may have been pre-empted by this thread, wait for it to finish.
+	chMtxLock (&fleet->mutex);
+	*aggregate = fleet->aggregate;
+	chMtxUnlock (&fleet->mutex);
+}
+
+static void fleetUpdate (amkInverter_t* amk, bool valid)
+{
+	amkFleet_t* fleet = amk->fleet;
+
+	chMtxLock (&fleet->mutex);
+
+	// Mark the aggregate as being modified (odd sequence).
+	++fleet->sequence;
+	__DMB ();
+
+	// Update this inverter's contribution.
+	fleet->members [amk->fleetIndex] = (amkFleetMember_t)
+	{
+		.state					= getState (amk, valid),
+		.derating				= amk->derating,
+		.power					= amk->actualPower,
+		.temperatureInverter	= amk->temperatureInverter,
+		.temperatureMotor		= amk->temperatureMotor,
+		.dcBusVoltage			= amk->dcBusVoltage
+	};
+
+	// Re-compute the aggregate from the cached contributions. Sums are re-computed rather than adjusted by the difference, so
+	// rounding errors do not accumulate.
+	amkFleetAggregate_t* aggregate = &fleet->aggregate;
+	amkFleetMember_t* member = &fleet->members [0];
+	*aggregate = (amkFleetAggregate_t)
+	{
+		.state					= member->state,
+		.derating				= member->derating,
+		.power					= { member->power, member->power, member->power },
+		.temperatureInverter	= { member->temperatureInverter, member->temperatureInverter, member->temperatureInverter },
+		.temperatureMotor		= { member->temperatureMotor, member->temperatureMotor, member->temperatureMotor },
+		.dcBusVoltage			= { member->dcBusVoltage, member->dcBusVoltage, member->dcBusVoltage }
+	};
+
+	for (uint8_t index = 1; index < fleet->count; ++index)
+	{
+		member = &fleet->members [index];
+
+		// The global state is the highest priority (lowest value) state.
+		if (member->state < aggregate->state)
+			aggregate->state = member->state;
+		aggregate->derating |= member->derating;
+
+		fleetRangeAdd (&aggregate->power, member->power);
+		fleetRangeAdd (&aggregate->temperatureInverter, member->temperatureInverter);
+		fleetRangeAdd (&aggregate->temperatureMotor, member->temperatureMotor);
+		fleetRangeAdd (&aggregate->dcBusVoltage, member->dcBusVoltage);
+	}
+
+	// Mark the aggregate as no longer being modified (even sequence).
+	__DMB ();
+	++fleet->sequence;
+
+	chMtxUnlock (&fleet->mutex);
+}
+
+static void fleetRangeAdd (amkFleetRange_t* range, float value)
+{
+	if (value < range->min)
+		range->min = value;
+	if (value > range->max)
+		range->max = value;
+	range->sum += value;
+}
+
 // Transmit Functions ---------------------------------------------------------------------------------------------------------
 
 msg_t amkSendEnergizationRequest (amkInverter_t* amk, bool energized, bool errorReset, sysinterval_t timeout)
+{
+	CANTxFrame frame;
+	msg_t result;
+	if (!amkPackEnergizationRequest (amk, &frame, energized, errorReset, &result))
+		return result;
+
+	return amkTransmitMotorRequest (amk, &frame, timeout);
+}
+
+msg_t amkSendTorqueRequest (amkInverter_t* amk, float torqueRequest, float torqueLimitPositive, float torqueLimitNegative, bool errorReset,
+	sysinterval_t timeout)
+{
+	CANTxFrame frame;
+	msg_t result;
+	if (!amkPackTorqueRequest (amk, &frame, torqueRequest, torqueLimitPositive, torqueLimitNegative, errorReset, &result))
+		return result;
+
+	return amkTransmitMotorRequest (amk, &frame, timeout);
+}
+
+msg_t amkSendErrorResetRequest (amkInverter_t* amk, sysinterval_t timeout)
+{
+	CANTxFrame frame;
+	msg_t result;
+	if (!amkPackErrorResetRequest (amk, &frame, &result))
+		return result;
+
+	return amkTransmitMotorRequest (amk, &frame, timeout);
+}
+
+msg_t amksSendTorqueRequest (amkInverter_t* amks, uint32_t count, const float* torqueRequests, float torqueLimitPositive,
+	float torqueLimitNegative, bool errorReset, sysinterval_t timeout, uint32_t* skew)
+{
+	if (count > AMK_GROUP_COUNT_MAX)
+		return MSG_RESET;
+
+	CANTxFrame frames [AMK_GROUP_COUNT_MAX];
+	bool packed [AMK_GROUP_COUNT_MAX];
+	msg_t result = MSG_OK;
+
+	// Pack every frame up-front, so no locking or conversions are performed between transmissions.
+	for (uint32_t index = 0; index < count; ++index)
+	{
+		msg_t packResult = MSG_OK;
+		packed [index] = amkPackTorqueRequest (amks + index, frames + index, torqueRequests [index], torqueLimitPositive,
+			torqueLimitNegative, errorReset, &packResult);
+
+		if (!packed [index] && result == MSG_OK)
+			result = packResult;
+	}
+
+	msg_t transmitResult = amksTransmitMotorRequests (amks, count, frames, packed, timeout, skew);
+	if (result == MSG_OK)
+		result = transmitResult;
+
+	return result;
+}
+
+msg_t amksTransmitMotorRequests (amkInverter_t* amks, uint32_t count, const CANTxFrame* frames, const bool* packed,
+	sysinterval_t timeout, uint32_t* skew)
+{
+	msg_t result = MSG_OK;
+	systime_t timeStart = chVTGetSystemTimeX ();
+	uint32_t cyclesFirst = 0;
+	uint32_t cyclesLast = 0;
+	bool queued = false;
+
+	// Queue as many frames as there are free TX mailboxes, back-to-back. The system is locked so this thread cannot be
+	// pre-empted between frames.
+	uint32_t index = 0;
+	chSysLock ();
+	for (; index < count; ++index)
+	{
+		if (!packed [index])
+			continue;
+
+		// Note this returns true if no mailbox was free.
+		if (canTryTransmitI (amks [index].driver, CAN_ANY_MAILBOX, frames + index))
+			break;
+
+		cyclesLast = DWT->CYCCNT;
+		if (!queued)
+			cyclesFirst = cyclesLast;
+		queued = true;
+	}
+	chSysUnlock ();
+
+	// Queue any remaining frames as mailboxes are freed.
+	for (; index < count; ++index)
+	{
+		if (!packed [index])
+			continue;
+
+		msg_t transmitResult = canTransmitTimeout (amks [index].driver, CAN_ANY_MAILBOX, frames + index,
+			remainingTimeout (timeStart, timeout));
+		if (transmitResult != MSG_OK)
+		{
+			if (result == MSG_OK)
+				result = transmitResult;
+			continue;
+		}
+
+		cyclesLast = DWT->CYCCNT;
+		if (!queued)
+			cyclesFirst = cyclesLast;
+		queued = true;
+	}
+
+	// Transmit the bridge copies last, so they never delay the main bus.
+	for (index = 0; index < count; ++index)
+		if (packed [index] && amks [index].bridgeDriver != NULL)
+			canTransmitTimeout (amks [index].bridgeDriver, CAN_ANY_MAILBOX, frames + index,
+				remainingTimeout (timeStart, timeout));
+
+	if (skew != NULL)
+		*skew = cyclesLast - cyclesFirst;
+
+	return result;
+}
+
+bool amkPackEnergizationRequest (amkInverter_t* amk, CANTxFrame* frame, bool energized, bool errorReset, msg_t* result)
 {
 	canNodeLock ((canNode_t*) amk);
 	bool error = amk->error;
@@ -189,14 +503,15 @@ msg_t amkSendEnergizationRequest (amkInverter_t* amk, bool energized, bool error
 
 	// If an error is present and automatic reset is specified, send the reset request.
 	if (errorReset && error)
-		return amkSendErrorResetRequest (amk, timeout);
+		return amkPackErrorResetRequest (amk, frame, result);
 
 	// In order to energize, all setpoints must be set to 0.
-	return amkSendMotorRequest (amk, energized, true, energized, false, 0, 0, 0, timeout);
+	amkPackMotorRequest (amk, frame, energized, true, energized, false, 0, 0, 0);
+	return true;
 }
 
-msg_t amkSendTorqueRequest (amkInverter_t* amk, float torqueRequest, float torqueLimitPositive, float torqueLimitNegative, bool errorReset,
-	sysinterval_t timeout)
+bool amkPackTorqueRequest (amkInverter_t* amk, CANTxFrame* frame, float torqueRequest, float torqueLimitPositive,
+	float torqueLimitNegative, bool errorReset, msg_t* result)
 {
 	canNodeLock ((canNode_t*) amk);
 	bool energized = amk->state == CAN_NODE_VALID && amk->quitInverter;
@@ -205,19 +520,19 @@ msg_t amkSendTorqueRequest (amkInverter_t* amk, float torqueRequest, float torqu
 
 	// If an error is present and automatic reset is specified, send the reset request.
 	if (errorReset && error)
-		return amkSendErrorResetRequest (amk, timeout);
+		return amkPackErrorResetRequest (amk, frame, result);
 
 	// If the inverter isn't energized, send the request to energize.
 	if (!energized)
-		return amkSendEnergizationRequest (amk, true, errorReset, timeout);
+		return amkPackEnergizationRequest (amk, frame, true, errorReset, result);
 
 	// Otherwise, clamp and send the request.
 	amkClampTorqueRequest (&torqueRequest);
-	return amkSendMotorRequest (amk, true, true, true, false, torqueRequest, torqueLimitPositive, torqueLimitNegative,
-		timeout);
+	amkPackMotorRequest (amk, frame, true, true, true, false, torqueRequest, torqueLimitPositive, torqueLimitNegative);
+	return true;
 }
 
-msg_t amkSendErrorResetRequest (amkInverter_t* amk, sysinterval_t timeout)
+bool amkPackErrorResetRequest (amkInverter_t* amk, CANTxFrame* frame, msg_t* result)
 {
 	// TODO(Barach): This needs rework.
 
@@ -228,14 +543,16 @@ msg_t amkSendErrorResetRequest (amkInverter_t* amk, sysinterval_t timeout)
 	{
 		amk->errorResetCount = 0;
 		canNodeUnlock ((canNode_t*) amk);
-		return MSG_OK;
+		*result = MSG_OK;
+		return false;
 	}
 
 	// If the maximum number of reset requests has been made, do not attempt.
 	if (amk->errorResetCount >= ERROR_RESET_REQUEST_MAX_ATTEMPTS)
 	{
 		canNodeUnlock ((canNode_t*) amk);
-		return MSG_RESET;
+		*result = MSG_RESET;
+		return false;
 	}
 	++amk->errorResetCount;
 
@@ -244,11 +561,12 @@ msg_t amkSendErrorResetRequest (amkInverter_t* amk, sysinterval_t timeout)
 	amk->quitInverter	= false;
 	canNodeUnlock ((canNode_t*) amk);
 
-	return amkSendMotorRequest (amk, false, false, false, true, 0, 0, 0, timeout);
+	amkPackMotorRequest (amk, frame, false, false, false, true, 0, 0, 0);
+	return true;
 }
 
-msg_t amkSendMotorRequest (amkInverter_t* amk, bool inverterEnabled, bool dcEnabled, bool driverEnabled, bool errorReset,
-	float torqueRequest, float torqueLimitPositive, float torqueLimitNegative, sysinterval_t timeout)
+void amkPackMotorRequest (amkInverter_t* amk, CANTxFrame* frame, bool inverterEnabled, bool dcEnabled, bool driverEnabled,
+	bool errorReset, float torqueRequest, float torqueLimitPositive, float torqueLimitNegative)
 {
 	// Motor Request Message: (ID Offset 0x000)
 	//   Bytes 0 to 1: Control word (uint16_t).
@@ -271,7 +589,7 @@ msg_t amkSendMotorRequest (amkInverter_t* amk, bool inverterEnabled, bool dcEnab
 	int16_t torqueLimitPositiveInt	= TORQUE_TO_WORD (torqueLimitPositive);
 	int16_t torqueLimitNegativeInt	= TORQUE_TO_WORD (torqueLimitNegative);
 
-	CANTxFrame transmit =
+	*frame = (CANTxFrame)
 	{
 		.DLC = 8,
 		.IDE = CAN_IDE_STD,
@@ -284,15 +602,27 @@ msg_t amkSendMotorRequest (amkInverter_t* amk, bool inverterEnabled, bool dcEnab
 			torqueLimitNegativeInt
 		}
 	};
+}
 
+msg_t amkTransmitMotorRequest (amkInverter_t* amk, const CANTxFrame* frame, sysinterval_t timeout)
+{
 	// Transmit the message on the main driver and bridge driver.
-	msg_t result = canTransmitTimeout (amk->driver, CAN_ANY_MAILBOX, &transmit, timeout);
+	msg_t result = canTransmitTimeout (amk->driver, CAN_ANY_MAILBOX, frame, timeout);
 	if (amk->bridgeDriver != NULL)
-		canTransmitTimeout (amk->bridgeDriver, CAN_ANY_MAILBOX, &transmit, timeout);
+		canTransmitTimeout (amk->bridgeDriver, CAN_ANY_MAILBOX, frame, timeout);
 
 	return result;
 }
 
+static sysinterval_t remainingTimeout (systime_t timeStart, sysinterval_t timeout)
+{
+	if (timeout == TIME_INFINITE)
+		return TIME_INFINITE;
+
+	sysinterval_t elapsed = chTimeDiffX (timeStart, chVTGetSystemTimeX ());
+	return elapsed < timeout ? timeout - elapsed : TIME_IMMEDIATE;
+}
+
 // Receive Functions ----------------------------------------------------------------------------------------------------------
 
 void amkHandleMotorFeedback (amkInverter_t* amk, CANRxFrame* frame)
@@ -353,29 +683,52 @@ int8_t amkReceiveHandler (void* node, CANRxFrame* frame)
 {
 	amkInverter_t* amk = (amkInverter_t*) node;
 	uint16_t id = frame->SID;
+	int8_t index;
 
 	// Identify and handle the message.
 	if (id == amk->baseId + MOTOR_FEEDBACK_ID_OFFSET)
 	{
 		// Motor feedback message.
 		amkHandleMotorFeedback (amk, frame);
-		return MOTOR_FEEDBACK_FLAG_POS;
+		index = MOTOR_FEEDBACK_FLAG_POS;
 	}
-	if (id == amk->baseId + POWER_CONSUMPTION_ID_OFFSET)
+	else if (id == amk->baseId + POWER_CONSUMPTION_ID_OFFSET)
 	{
 		// Power consumption message.
 		amkHandlePowerConsumption (amk, frame);
-		return POWER_CONSUMPTION_FLAG_POS;
+		index = POWER_CONSUMPTION_FLAG_POS;
 	}
-	if (id == amk->baseId + TEMPERATURES_ID_OFFSET)
+	else if (id == amk->baseId + TEMPERATURES_ID_OFFSET)
 	{
 		// Temperatures message.
 		amkHandleTemperatures (amk, frame);
-		return TEMPERATURES_FLAG_POS;
+		index = TEMPERATURES_FLAG_POS;
 	}
 	else
 	{
 		// Message doesn't belong to this node.
 		return -1;
 	}
+
+	// Update the fleet. Note the node's state is only updated after this returns, so determine whether this message will
+	// complete it.
+	if (amk->fleet != NULL)
+		fleetUpdate (amk, amk->state == CAN_NODE_VALID || (amk->messageFlags | ((uint64_t) 1 << index)) == amk->validFlags);
+
+	return index;
+}
+
+void amkTimeoutHandler (void* node)
+{
+	amkInverter_t* amk = (amkInverter_t*) node;
+
+	// Mark the inverter as invalid in the fleet.
+	if (amk->fleet != NULL)
+		fleetUpdate (amk, false);
+}
+
+canId_t amkIdHandler (void* node, uint8_t index)
+{
+	amkInverter_t* amk = (amkInverter_t*) node;
+	return canIdStandard (amk->baseId + MESSAGE_ID_OFFSETS [index]);
 }
\ No newline at end of file
@@ -28,14 +28,37 @@
  */
 #define amkTorqueRequestValid(torque) ((torque) <= AMK_DRIVING_TORQUE_MAX && (torque) >= AMK_REGENERATIVE_TORQUE_MAX)
 
+/// @brief Event flag broadcast upon receiving the motor feedback message, see @c CAN_NODE_USE_EVENTS .
+#define AMK_EVENT_MOTOR_FEEDBACK	CAN_NODE_EVENT_MESSAGE (0)
+
+/// @brief Event flag broadcast upon receiving the power consumption message.
+#define AMK_EVENT_POWER_CONSUMPTION	CAN_NODE_EVENT_MESSAGE (1)
+
+/// @brief Event flag broadcast upon receiving the temperatures message.
+#define AMK_EVENT_TEMPERATURES		CAN_NODE_EVENT_MESSAGE (2)
+
+#ifndef AMK_GROUP_COUNT_MAX
+/// @brief The maximum number of inverters a group request may be sent to.
+#define AMK_GROUP_COUNT_MAX 4
+#endif // AMK_GROUP_COUNT_MAX
+
 // Datatypes ------------------------------------------------------------------------------------------------------------------
 
+typedef struct amkFleet amkFleet_t;
+
 typedef struct
 {
 	CANDriver*		mainDriver;
 	CANDriver*		bridgeDriver;
 	sysinterval_t	timeoutPeriod;
 	uint16_t		baseId;
+
+	/// @brief Fleet to aggregate the inverter's data into (see @c amkFleet_t ). May be @c NULL .
+	amkFleet_t*		fleet;
+
+	/// @brief Optional array of the timeout period of each message (see @c canNodeConfig_t ), indexed as the motor feedback,
+	/// power consumption, and temperatures messages. Use @c NULL to only time-out the node as a whole.
+	const sysinterval_t* messageTimeoutPeriods;
 } amkInverterConfig_t;
 
 /**
@@ -60,6 +83,80 @@ typedef enum
 	AMK_STATE_READY_ENERGIZED = 7
 } amkInverterState_t;
 
+/**
+ * @brief The range and total of a value across a fleet of inverters.
+ */
+typedef struct
+{
+	float min;
+	float max;
+	float sum;
+} amkFleetRange_t;
+
+/**
+ * @brief The aggregate data of a fleet of inverters, see @c amkFleet_t .
+ */
+typedef struct
+{
+	/// @brief The global state of the fleet, that is, the highest priority state of any inverter (see @c amksGetState ).
+	amkInverterState_t state;
+
+	/// @brief Indicates whether any inverter is de-rating its output torque.
+	bool derating;
+
+	/// @brief The actual mechanical power consumption of the inverters, in Watts.
+	amkFleetRange_t power;
+
+	/// @brief The temperatures of the inverters, in C.
+	amkFleetRange_t temperatureInverter;
+
+	/// @brief The temperatures of the motors, in C.
+	amkFleetRange_t temperatureMotor;
+
+	/// @brief The measured voltages of the DC buses, in V.
+	amkFleetRange_t dcBusVoltage;
+} amkFleetAggregate_t;
+
+/**
+ * @brief The data of a single inverter, as contributed to a fleet.
+ */
+typedef struct
+{
+	amkInverterState_t state;
+	bool derating;
+	float power;
+	float temperatureInverter;
+	float temperatureMotor;
+	float dcBusVoltage;
+} amkFleetMember_t;
+
+/**
+ * @brief Aggregate of the data of a group of inverters, updated by each inverter's receive handler. Rather than scanning
+ * (and locking) every inverter upon each read, as @c amksGetState and @c amksGetCumulativePower do, readers copy the
+ * pre-computed aggregate (see @c amkFleetGet ). Like a CAN node, the fleet has a sequence counter, so the aggregate can be
+ * copied without blocking the inverters' receive handlers.
+ * @note An inverter's state is only updated in the fleet upon receiving a message or timing-out. An inverter whose messages
+ * become partially stale (see @c CAN_NODE_INCOMPLETE ) retains its state until either occurs. Like
+ * @c amksGetCumulativePower , a timed-out inverter's last values remain in the aggregate.
+ */
+struct amkFleet
+{
+	/// @brief Mutex serializing the receive handlers of the inverters.
+	mutex_t mutex;
+
+	/// @brief Sequence counter, odd while the aggregate is being modified.
+	volatile uint32_t sequence;
+
+	/// @brief The number of inverters in the fleet.
+	uint8_t count;
+
+	/// @brief The data contributed by each inverter, indexed in order of initialization.
+	amkFleetMember_t members [AMK_GROUP_COUNT_MAX];
+
+	/// @brief The aggregate of the @c members .
+	amkFleetAggregate_t aggregate;
+};
+
 typedef struct
 {
 	CAN_NODE_FIELDS;
@@ -67,6 +164,12 @@ typedef struct
 
 	CANDriver* bridgeDriver;
 
+	/// @brief The fleet the inverter belongs to, if any.
+	amkFleet_t* fleet;
+
+	/// @brief The index of the inverter within its @c fleet .
+	uint8_t fleetIndex;
+
 	uint16_t errorResetCount;
 
 	/// @brief Indicates whether the inverter is ready and error-free.
@@ -121,6 +224,12 @@ typedef struct
 
 // Functions ------------------------------------------------------------------------------------------------------------------
 
+/**
+ * @brief Initializes an inverter using the specified configuration. If the configuration specifies a fleet, the inverter is
+ * added to it.
+ * @param amk The inverter to initialize.
+ * @param config The configuration to use.
+ */
 void amkInit (amkInverter_t* amk, const amkInverterConfig_t* config);
 
 /**
@@ -138,6 +247,17 @@ amkInverterState_t amkGetState (amkInverter_t* amk);
  */
 amkInverterState_t amkGetStateLock (amkInverter_t* amk);
 
+/**
+ * @brief Copies a consistent snapshot of the inverter without locking it. The snapshot may be used with any of the non-locking
+ * functions of this module (ex. @c amkGetState ). See @c canNodeCopy for details.
+ * @param amk The inverter to copy.
+ * @param snapshot The inverter to copy into.
+ */
+static inline void amkGetSnapshot (amkInverter_t* amk, amkInverter_t* snapshot)
+{
+	canNodeGetSnapshot (amk, snapshot);
+}
+
 /**
  * @brief Gets the current state of the inverter, indicating whether or not it is valid (not in an error state).
  * @note The CAN node should be locked beforehand.
@@ -177,6 +297,7 @@ inline bool amkClampTorqueRequest (float* torque)
 
 /**
  * @brief Gets the global state of a group of inverters.
+ * @note This locks each inverter, prefer @c amkFleetGet if called frequently.
  * @param amks The array of inverters to check the state of.
  * @param count The number of elements in @c amks .
  * @return The global state of the group of inverters.
@@ -185,12 +306,28 @@ amkInverterState_t amksGetState (amkInverter_t* amks, uint32_t count);
 
 /**
  * @brief Gets the global power consumption of a group of inverters.
+ * @note This locks each inverter, prefer @c amkFleetGet if called frequently.
  * @param amks The array of inverters to get the power of.
  * @param count The number of elements in @c amks .
  * @return The total amount of power being consumed, in Watts.
  */
 float amksGetCumulativePower (amkInverter_t* amks, uint32_t count);
 
+// Fleet Functions ------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes an empty fleet. Must be called before initializing the inverters belonging to it.
+ * @param fleet The fleet to initialize.
+ */
+void amkFleetInit (amkFleet_t* fleet);
+
+/**
+ * @brief Copies a consistent snapshot of a fleet's aggregate data, without locking any inverter.
+ * @param fleet The fleet to read.
+ * @param aggregate The aggregate to copy into.
+ */
+void amkFleetGet (amkFleet_t* fleet, amkFleetAggregate_t* aggregate);
+
 // Transmit Functions ---------------------------------------------------------------------------------------------------------
 
 /**
@@ -225,4 +362,60 @@ msg_t amkSendTorqueRequest (amkInverter_t* amk, float torqueRequest, float torqu
  */
 msg_t amkSendErrorResetRequest (amkInverter_t* amk, sysinterval_t timeout);
 
+/**
+ * @brief Sends a torque request to each inverter of a group, minimizing the skew between the inverters receiving their
+ * requests. Each inverter is requested as by @c amkSendTorqueRequest , however every frame is packed before any is
+ * transmitted. The frames are then queued into the free TX mailboxes back-to-back, with any remaining frames queued as soon as
+ * a mailbox is freed. The copies for each inverter's bridge driver are only transmitted once every frame has been queued on
+ * the main bus.
+ * @note The bxCAN peripheral has 3 TX mailboxes, so for groups larger than 3, the last frame is only queued once the first
+ * has been transmitted. Mailboxes occupied by other threads' frames will further delay the group.
+ * @param amks The array of inverters to request.
+ * @param count The number of elements in @c amks . Must not exceed @c AMK_GROUP_COUNT_MAX .
+ * @param torqueRequests The amount of torque to request from each inverter, in Nm. Indexed the same as @c amks .
+ * @param torqueLimitPositive The upper torque limit to apply, in Nm.
+ * @param torqueLimitNegative The lower torque limit to apply, in Nm.
+ * @param errorReset Indicates that if an error is present, a reset request should be delivered in place of an inverter's
+ * message.
+ * @param timeout The interval to timeout after, bounding the whole group (including the bridge copies).
+ * @param skew Written with the number of CPU cycles between the first and last frames being queued on the main bus. May be
+ * @c NULL .
+ * @return @c MSG_OK if every inverter was requested successfully, otherwise the first failing result.
+ */
+msg_t amksSendTorqueRequest (amkInverter_t* amks, uint32_t count, const float* torqueRequests, float torqueLimitPositive,
+	float torqueLimitNegative, bool errorReset, sysinterval_t timeout, uint32_t* skew);
+
+/**
+ * @brief Packs the specified motor request for an AMK inverter, without transmitting it. Used to pre-pack the requests of a
+ * group of inverters (see @c amksTransmitMotorRequests ).
+ * @param amk The AMK inverter to send the message to.
+ * @param frame The frame to pack.
+ * @param inverterEnabled Indicates whether the inverter controller should be enabled (cannot be set until quitDcOn is
+ * asserted).
+ * @param dcEnabled Indicates whether the DC bus should be enabled (can be asserted any time).
+ * @param driverEnabled Indicates whether the inverter driver should be enabled (cannot be asserted until quitInverter is
+ * asserted).
+ * @param errorReset Indicates whether any present errors should be reset (can only be asserted if all setpoints are 0).
+ * @param torqueRequest The torque to request from the motor.
+ * @param torqueLimitPositive The positive torque limit to specify.
+ * @param torqueLimitNegative The negative torque limit to specify.
+ */
+void amkPackMotorRequest (amkInverter_t* amk, CANTxFrame* frame, bool inverterEnabled, bool dcEnabled, bool driverEnabled,
+	bool errorReset, float torqueRequest, float torqueLimitPositive, float torqueLimitNegative);
+
+/**
+ * @brief Transmits pre-packed motor requests to a group of inverters, minimizing the skew between them. See
+ * @c amksSendTorqueRequest for details.
+ * @param amks The array of inverters to transmit to.
+ * @param count The number of elements in @c amks .
+ * @param frames The frame to transmit to each inverter. Indexed the same as @c amks .
+ * @param packed Indicates whether each frame should be transmitted. Indexed the same as @c amks .
+ * @param timeout The interval to timeout after, bounding the whole group (including the bridge copies).
+ * @param skew Written with the number of CPU cycles between the first and last frames being queued on the main bus. May be
+ * @c NULL .
+ * @return @c MSG_OK if every frame was transmitted successfully, otherwise the first failing result.
+ */
+msg_t amksTransmitMotorRequests (amkInverter_t* amks, uint32_t count, const CANTxFrame* frames, const bool* packed,
+	sysinterval_t timeout, uint32_t* skew);
+
 #endif // AMK_INVERTER_H
\ No newline at end of file
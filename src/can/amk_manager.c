@@ -0,0 +1,230 @@
+// Header
+#include "amk_manager.h"
+
+// Function Prototypes --------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Advances the state machine of an inverter, packing the motor request to transmit this period.
+ * @param manager The manager of the inverter.
+ * @param index The index of the inverter.
+ * @param frame The frame to pack.
+ * @param energized Indicates whether the inverter should be energized.
+ * @param torqueRequest The torque to request, in Nm.
+ * @param timeCurrent The current system time.
+ */
+static void packRequest (amkManager_t* manager, uint8_t index, CANTxFrame* frame, bool energized, float torqueRequest,
+	systime_t timeCurrent);
+
+// Thread Entrypoint ----------------------------------------------------------------------------------------------------------
+
+THD_FUNCTION (amkManagerThread, arg)
+{
+	// Only argument is the manager
+	amkManager_t* manager = (amkManager_t*) arg;
+	const amkManagerConfig_t* config = manager->config;
+
+	// Set the name
+	chRegSetThreadName (config->name);
+
+	CANTxFrame frames [AMK_GROUP_COUNT_MAX];
+	bool packed [AMK_GROUP_COUNT_MAX];
+	float torqueRequests [AMK_GROUP_COUNT_MAX];
+
+	systime_t timePrevious = chVTGetSystemTimeX ();
+
+	while (true)
+	{
+		systime_t timeCurrent = chVTGetSystemTimeX ();
+
+		// Copy the posted request
+		chMtxLock (&manager->mutex);
+		bool energized = manager->energized;
+		systime_t requestTime = manager->requestTime;
+		for (uint8_t index = 0; index < config->amkCount; ++index)
+			torqueRequests [index] = manager->torqueRequests [index];
+		bool clearFaults = manager->clearFaults;
+		manager->clearFaults = false;
+		chMtxUnlock (&manager->mutex);
+
+		if (clearFaults)
+		{
+			for (uint8_t index = 0; index < config->amkCount; ++index)
+			{
+				manager->inverters [index].faulted		= false;
+				manager->inverters [index].resetCount	= 0;
+				manager->inverters [index].resetDelay	= config->resetDelayMin;
+			}
+		}
+
+		// If the request is stale, request zero torque.
+		bool stale = chTimeDiffX (requestTime, timeCurrent) > config->requestTimeout;
+
+		// Pack every request, then transmit them as a group.
+		for (uint8_t index = 0; index < config->amkCount; ++index)
+		{
+			packRequest (manager, index, frames + index, energized, stale ? 0.0f : torqueRequests [index], timeCurrent);
+			packed [index] = true;
+		}
+
+		// Bound the group by the remainder of the period, so a congested or bus-off bus cannot delay the next period.
+		sysinterval_t elapsed = chTimeDiffX (timePrevious, chVTGetSystemTimeX ());
+		sysinterval_t timeout = elapsed < config->period ? config->period - elapsed : TIME_IMMEDIATE;
+		if (amksTransmitMotorRequests (config->amks, config->amkCount, frames, packed, timeout, &manager->skew) != MSG_OK)
+			++manager->transmitErrorCount;
+
+		if (chTimeDiffX (timePrevious, chVTGetSystemTimeX ()) >= config->period)
+			++manager->overrunCount;
+
+		// Sleep until the next period.
+		timePrevious = chThdSleepUntilWindowed (timePrevious, chTimeAddX (timePrevious, config->period));
+	}
+}
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+bool amkManagerInit (amkManager_t* manager, const amkManagerConfig_t* config)
+{
+	if (config->amkCount > AMK_GROUP_COUNT_MAX)
+		return false;
+
+	manager->config				= config;
+	manager->energized			= false;
+	manager->clearFaults		= false;
+	manager->requestTime		= chVTGetSystemTimeX ();
+	manager->skew				= 0;
+	manager->transmitErrorCount	= 0;
+	manager->overrunCount		= 0;
+	chMtxObjectInit (&manager->mutex);
+
+	for (uint8_t index = 0; index < AMK_GROUP_COUNT_MAX; ++index)
+	{
+		manager->torqueRequests [index] = 0.0f;
+
+		amkManagerInverter_t* inverter = manager->inverters + index;
+		inverter->resetCount	= 0;
+		inverter->resetDelay	= config->resetDelayMin;
+		inverter->resetTime		= manager->requestTime;
+		inverter->errorTime		= manager->requestTime;
+		inverter->faulted		= false;
+	}
+
+	return true;
+}
+
+void amkManagerStart (amkManager_t* manager, void* workingArea, size_t workingAreaSize, tprio_t priority)
+{
+	chThdCreateStatic (workingArea, workingAreaSize, priority, amkManagerThread, manager);
+}
+
+void amkManagerRequest (amkManager_t* manager, bool energized, const float* torqueRequests)
+{
+	chMtxLock (&manager->mutex);
+
+	manager->energized = energized;
+	for (uint8_t index = 0; index < manager->config->amkCount; ++index)
+	{
+		float torqueRequest = energized ? torqueRequests [index] : 0.0f;
+		amkClampTorqueRequest (&torqueRequest);
+		manager->torqueRequests [index] = torqueRequest;
+	}
+	manager->requestTime = chVTGetSystemTimeX ();
+
+	chMtxUnlock (&manager->mutex);
+}
+
+void amkManagerClearFaults (amkManager_t* manager)
+{
+	// The error handling state is owned by the manager's thread, so only flag it to be cleared.
+	chMtxLock (&manager->mutex);
+	manager->clearFaults = true;
+	chMtxUnlock (&manager->mutex);
+}
+
+static void packRequest (amkManager_t* manager, uint8_t index, CANTxFrame* frame, bool energized, float torqueRequest,
+	systime_t timeCurrent)
+{
+	const amkManagerConfig_t* config = manager->config;
+	amkInverter_t* amk = config->amks + index;
+	amkManagerInverter_t* inverter = manager->inverters + index;
+
+	canNodeLock ((canNode_t*) amk);
+	amkInverterState_t state = amkGetState (amk);
+	bool quitDcOn = amk->quitDcOn;
+	bool error = amk->error;
+	canNodeUnlock ((canNode_t*) amk);
+
+	switch (state)
+	{
+	case AMK_STATE_INVALID:
+		// No feedback, de-energize the inverter.
+		amkPackMotorRequest (amk, frame, false, false, false, false, 0, 0, 0);
+		return;
+
+	case AMK_STATE_ERROR:
+		// The error state also indicates the inverter is not ready. Without an error there is nothing to reset, so hold the
+		// inverter de-energized without counting it against the reset attempts.
+		if (!error)
+		{
+			amkPackMotorRequest (amk, frame, false, false, false, false, 0, 0, 0);
+			return;
+		}
+
+		inverter->errorTime = timeCurrent;
+
+		// If the reset attempts are exhausted, leave the inverter de-energized.
+		if (config->resetAttemptMax != 0 && inverter->resetCount >= config->resetAttemptMax)
+		{
+			inverter->faulted = true;
+			amkPackMotorRequest (amk, frame, false, false, false, false, 0, 0, 0);
+			return;
+		}
+
+		// Wait for the delay between reset attempts, requesting the reset bit be cleared in the meantime (the inverter resets
+		// upon the bit's rising edge).
+		if (inverter->resetCount != 0 && chTimeDiffX (inverter->resetTime, timeCurrent) < inverter->resetDelay)
+		{
+			amkPackMotorRequest (amk, frame, false, false, false, false, 0, 0, 0);
+			return;
+		}
+
+		// Back off the delay for the next attempt.
+		if (inverter->resetCount != 0)
+		{
+			inverter->resetDelay *= 2;
+			if (inverter->resetDelay > config->resetDelayMax)
+				inverter->resetDelay = config->resetDelayMax;
+		}
+		++inverter->resetCount;
+		inverter->resetTime = timeCurrent;
+
+		amkPackMotorRequest (amk, frame, false, false, false, true, 0, 0, 0);
+		return;
+
+	default:
+		// The inverter has been error-free for long enough, reset the backoff.
+		if (inverter->resetCount != 0 && chTimeDiffX (inverter->errorTime, timeCurrent) >= config->resetDelayMax)
+		{
+			inverter->resetCount	= 0;
+			inverter->resetDelay	= config->resetDelayMin;
+			inverter->faulted		= false;
+		}
+
+		if (!energized)
+		{
+			// De-energize, leaving the DC bus enabled.
+			amkPackMotorRequest (amk, frame, false, true, false, false, 0, 0, 0);
+		}
+		else if (state == AMK_STATE_READY_ENERGIZED)
+		{
+			// Energized, request the torque.
+			amkPackMotorRequest (amk, frame, true, true, true, false, torqueRequest, config->torqueLimitPositive,
+				config->torqueLimitNegative);
+		}
+		else
+		{
+			// Enable the DC bus, then the inverter once the DC bus is acknowledged. All setpoints must be zero.
+			amkPackMotorRequest (amk, frame, quitDcOn, true, quitDcOn, false, 0, 0, 0);
+		}
+		return;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+#ifndef AMK_MANAGER_H
+#define AMK_MANAGER_H
+
+// AMK Inverter Manager -------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Thread object managing a group of AMK inverters on behalf of the control code. Rather than each torque request
+//   driving the inverter's handshake (see @c amkSendTorqueRequest ), the control code only posts the desired torque of each
+//   inverter (see @c amkManagerRequest ), and the manager's thread transmits the motor request of every inverter each period.
+//   This keeps the message cadence the inverters require (5 ms) regardless of the timing of the control loop.
+//
+//   Each period, the manager advances each inverter's state machine based on its state (see @c amkGetState ):
+//   - Invalid (no feedback) - The inverter is de-energized, with all setpoints zeroed.
+//   - Error - An error reset is requested. If the error persists, the reset is repeated after a delay that doubles upon each
+//     attempt (up to a maximum). Once the maximum number of attempts is made, the inverter is left de-energized.
+//     An inverter that is not ready, but has no error, is held de-energized without attempting a reset.
+//   - Ready - If energization is requested, the DC bus is enabled. Once acknowledged (quitDcOn), the inverter is enabled.
+//   - Energized - The posted torque request is transmitted.
+//
+//   If the control code stops posting requests (ex. the control thread faults), the manager requests zero torque once the
+//   last request is older than the configured timeout.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// Includes
+#include "amk_inverter.h"
+
+// ChibiOS
+#include "ch.h"
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+#define AMK_MANAGER_WORKING_AREA(name) THD_WORKING_AREA (name, 512)
+
+typedef struct
+{
+	/// @brief Name to give the manager's thread, used for debugging.
+	const char* name;
+
+	/// @brief The array of inverters to manage. Must be initialized.
+	amkInverter_t* amks;
+
+	/// @brief The number of elements in the @c amks array. Must not exceed @c AMK_GROUP_COUNT_MAX .
+	uint8_t amkCount;
+
+	/// @brief The period to transmit the motor requests at. The inverters expect a request at least every 5 ms.
+	sysinterval_t period;
+
+	/// @brief The upper torque limit to apply to each torque request, in Nm.
+	float torqueLimitPositive;
+
+	/// @brief The lower torque limit to apply to each torque request, in Nm.
+	float torqueLimitNegative;
+
+	/// @brief The maximum age of a posted request before zero torque is requested instead.
+	sysinterval_t requestTimeout;
+
+	/// @brief The delay between the first and second error reset requests.
+	sysinterval_t resetDelayMin;
+
+	/// @brief The maximum delay between consecutive error reset requests. An inverter that has remained error-free for this
+	/// long is considered recovered.
+	sysinterval_t resetDelayMax;
+
+	/// @brief The maximum number of consecutive error reset requests to make, use 0 for unlimited.
+	uint16_t resetAttemptMax;
+} amkManagerConfig_t;
+
+typedef struct
+{
+	/// @brief The number of consecutive error reset requests made.
+	uint16_t resetCount;
+
+	/// @brief The delay before the next error reset request.
+	sysinterval_t resetDelay;
+
+	/// @brief The time the last error reset request was made at.
+	systime_t resetTime;
+
+	/// @brief The time the inverter was last in the error state.
+	systime_t errorTime;
+
+	/// @brief Indicates whether the maximum number of error reset requests has been made without the error clearing.
+	bool faulted;
+} amkManagerInverter_t;
+
+typedef struct
+{
+	const amkManagerConfig_t* config;
+
+	/// @brief Mutex protecting the posted request.
+	mutex_t mutex;
+
+	/// @brief Indicates whether the inverters should be energized.
+	bool energized;
+
+	/// @brief The torque to request from each inverter, in Nm. Indexed the same as the @c amks array.
+	float torqueRequests [AMK_GROUP_COUNT_MAX];
+
+	/// @brief The time the last request was posted at.
+	systime_t requestTime;
+
+	/// @brief Indicates the faulted state of each inverter should be cleared, see @c amkManagerClearFaults .
+	bool clearFaults;
+
+	/// @brief The state of each inverter's error handling. Indexed the same as the @c amks array.
+	amkManagerInverter_t inverters [AMK_GROUP_COUNT_MAX];
+
+	/// @brief The skew of the last group of transmitted requests, in CPU cycles (see @c amksTransmitMotorRequests ).
+	uint32_t skew;
+
+	/// @brief The number of periods in which a request could not be transmitted.
+	uint32_t transmitErrorCount;
+
+	/// @brief The number of periods that could not be completed within the period, delaying the next.
+	uint32_t overrunCount;
+} amkManager_t;
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes a manager using the specified configuration. The inverters are initially requested to be de-energized.
+ * @param manager The manager to initialize.
+ * @param config The configuration to use.
+ * @return False if the configuration is invalid, true otherwise.
+ */
+bool amkManagerInit (amkManager_t* manager, const amkManagerConfig_t* config);
+
+/**
+ * @brief Starts the thread of a manager.
+ * @param manager The manager to start, must be initialized.
+ * @param workingArea The working area to provide the thread. Should be instanced using the @c AMK_MANAGER_WORKING_AREA macro.
+ * @param workingAreaSize The size of the thread's @c workingArea . Should be obtained using @c sizeof(workingArea) .
+ * @param priority The priority to assign the thread. Should exceed the priority of the control thread posting requests.
+ */
+void amkManagerStart (amkManager_t* manager, void* workingArea, size_t workingAreaSize, tprio_t priority);
+
+/**
+ * @brief Posts a request to the inverters of a manager. The request is transmitted by the manager's thread, once each inverter
+ * is energized.
+ * @param manager The manager to post to.
+ * @param energized Indicates whether the inverters should be energized. If false, the inverters are de-energized.
+ * @param torqueRequests The torque to request from each inverter, in Nm. Indexed the same as the @c amks array. Clamped to
+ * the requestable range. May be @c NULL if @c energized is false.
+ */
+void amkManagerRequest (amkManager_t* manager, bool energized, const float* torqueRequests);
+
+/**
+ * @brief Clears the faulted state of each inverter, so error resets are re-attempted. Takes effect upon the manager's next
+ * period.
+ * @param manager The manager to reset.
+ */
+void amkManagerClearFaults (amkManager_t* manager);
+
+#endif // AMK_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,12 @@
+ifndef AMK_MANAGER_MK
+define AMK_MANAGER_MK
+1
+endef
+
+# Include the module's common dependencies
+include common/src/can/amk_inverter.mk
+
+# Add the module's source file to the compilation
+CSRC += common/src/can/amk_manager.c
+
+endif # AMK_MANAGER_MK
\ No newline at end of file
@@ -9,6 +9,13 @@
 #define STATUS_MESSAGE_FLAG_POS 0x00
 #define POWER_MESSAGE_FLAG_POS	0x01
 
+/// @brief The ID of each message, indexed by the message's flag position.
+static const uint16_t MESSAGE_IDS [] =
+{
+	[STATUS_MESSAGE_FLAG_POS]	= STATUS_MESSAGE_ID,
+	[POWER_MESSAGE_FLAG_POS]	= POWER_MESSAGE_ID
+};
+
 // Conversions ----------------------------------------------------------------------------------------------------------------
 
 // Voltage (V)
@@ -27,6 +34,8 @@
 
 int8_t bmsReceiveHandler (void *node, CANRxFrame *frame);
 
+canId_t bmsIdHandler (void* node, uint8_t index);
+
 // Functions ------------------------------------------------------------------------------------------------------------------
 
 void bmsInit (bms_t* bms, const bmsConfig_t* config)
@@ -34,11 +43,13 @@ void bmsInit (bms_t* bms, const bmsConfig_t* config)
 	// Initialize the CAN node
 	canNodeConfig_t nodeConfig =
 	{
-		.driver			= config->driver,
-		.receiveHandler	= bmsReceiveHandler,
-		.timeoutHandler	= NULL,
-		.timeoutPeriod	= config->timeoutPeriod,
-		.messageCount	= 2
+		.driver					= config->driver,
+		.receiveHandler			= bmsReceiveHandler,
+		.timeoutHandler			= NULL,
+		.idHandler				= bmsIdHandler,
+		.timeoutPeriod			= config->timeoutPeriod,
+		.messageCount			= 2,
+		.messageTimeoutPeriods	= config->messageTimeoutPeriods
 	};
 	canNodeInit ((canNode_t*) bms, &nodeConfig);
 }
@@ -94,4 +105,10 @@ int8_t bmsReceiveHandler (void *node, CANRxFrame *frame)
 		// Message doesn't belong to this node.
 		return -1;
 	}
+}
+
+canId_t bmsIdHandler (void* node, uint8_t index)
+{
+	(void) node;
+	return canIdStandard (MESSAGE_IDS [index]);
 }
\ No newline at end of file
@@ -19,6 +19,10 @@ typedef struct
 {
 	CANDriver*		driver;
 	sysinterval_t	timeoutPeriod;
+
+	/// @brief Optional array of the timeout period of each message (see @c canNodeConfig_t ), indexed as the status and power
+	/// messages. Use @c NULL to only time-out the node as a whole.
+	const sysinterval_t* messageTimeoutPeriods;
 } bmsConfig_t;
 
 typedef struct
@@ -66,4 +70,14 @@ void bmsInit (bms_t* bms, const bmsConfig_t* config);
  */
 float bmsGetPowerLock (bms_t* bms);
 
+/**
+ * @brief Copies a consistent snapshot of the BMS without locking it. See @c canNodeCopy for details.
+ * @param bms The BMS to copy.
+ * @param snapshot The BMS to copy into.
+ */
+static inline void bmsGetSnapshot (bms_t* bms, bms_t* snapshot)
+{
+	canNodeGetSnapshot (bms, snapshot);
+}
+
 #endif // BMS_H
\ No newline at end of file
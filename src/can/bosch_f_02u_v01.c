@@ -25,6 +25,14 @@
 #define MESSAGE_2_FLAG_POS	0x01
 #define MESSAGE_3_FLAG_POS	0x02
 
+/// @brief The ID of each message, indexed by the message's flag position.
+static const uint16_t MESSAGE_IDS [] =
+{
+	[MESSAGE_1_FLAG_POS]	= MESSAGE_1_ID,
+	[MESSAGE_2_FLAG_POS]	= MESSAGE_2_ID,
+	[MESSAGE_3_FLAG_POS]	= MESSAGE_3_ID
+};
+
 // Receive Functions ----------------------------------------------------------------------------------------------------------
 
 static void handleMessage1 (boschF02uV01_t* imu, CANRxFrame* frame)
@@ -68,6 +76,12 @@ static int8_t receiveHandler (void* node, CANRxFrame* frame)
 	return -1;
 }
 
+static canId_t idHandler (void* node, uint8_t index)
+{
+	(void) node;
+	return canIdStandard (MESSAGE_IDS [index]);
+}
+
 // Public Functions -----------------------------------------------------------------------------------------------------------
 
 void boschF02uV01Init (boschF02uV01_t* imu, const boschF02uV01Config_t* config)
@@ -75,11 +89,13 @@ void boschF02uV01Init (boschF02uV01_t* imu, const boschF02uV01Config_t* config)
 	// Initialize the CAN node
 	canNodeConfig_t nodeConfig =
 	{
-		.driver			= config->driver,
-		.receiveHandler	= receiveHandler,
-		.timeoutHandler	= NULL,
-		.timeoutPeriod	= config->timeoutPeriod,
-		.messageCount	= 3
+		.driver					= config->driver,
+		.receiveHandler			= receiveHandler,
+		.timeoutHandler			= NULL,
+		.idHandler				= idHandler,
+		.timeoutPeriod			= config->timeoutPeriod,
+		.messageCount			= 3,
+		.messageTimeoutPeriods	= config->messageTimeoutPeriods
 	};
 	canNodeInit ((canNode_t*) imu, &nodeConfig);
 }
\ No newline at end of file
@@ -20,6 +20,10 @@ typedef struct
 {
 	CANDriver*		driver;
 	sysinterval_t	timeoutPeriod;
+
+	/// @brief Optional array of the timeout period of each message (see @c canNodeConfig_t ), indexed as messages 1, 2, and 3
+	/// (IDs 0x174, 0x178, and 0x17C). Use @c NULL to only time-out the node as a whole.
+	const sysinterval_t* messageTimeoutPeriods;
 } boschF02uV01Config_t;
 
 /// @brief Struct representing the Bosch F 02U V01 511-02 IMU.
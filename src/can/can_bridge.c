@@ -0,0 +1,137 @@
+// Header
+#include "can_bridge.h"
+
+// C Standard Library
+#include <string.h>
+
+// Thread Entrypoint ----------------------------------------------------------------------------------------------------------
+
+THD_FUNCTION (canBridgeThread, arg)
+{
+	// Only argument is the bridge
+	canBridge_t* bridge = (canBridge_t*) arg;
+
+	// Set the name
+	chRegSetThreadName (bridge->config->name);
+
+	CANRxFrame rxFrame;
+
+	while (true)
+	{
+		// Block until a message is forwarded
+		if (!canQueuePop (&bridge->queue, &rxFrame, TIME_INFINITE))
+			continue;
+
+		// Copy the received frame into a transmit frame.
+		CANTxFrame txFrame =
+		{
+			.IDE	= rxFrame.IDE,
+			.RTR	= rxFrame.RTR,
+			.DLC	= rxFrame.DLC
+		};
+		if (rxFrame.IDE == CAN_IDE_EXT)
+			txFrame.EID = rxFrame.EID;
+		else
+			txFrame.SID = rxFrame.SID;
+		memcpy (txFrame.data8, rxFrame.data8, rxFrame.DLC);
+
+		// Re-transmit the frame on the destination bus.
+		if (canTransmitTimeout (bridge->config->driver, CAN_ANY_MAILBOX, &txFrame, bridge->config->transmitTimeout) == MSG_OK)
+			++bridge->transmitCount;
+		else
+			++bridge->timeoutCount;
+	}
+}
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+void canBridgeInit (canBridge_t* bridge, const canBridgeConfig_t* config)
+{
+	bridge->config			= config;
+	bridge->transmitCount	= 0;
+	bridge->timeoutCount	= 0;
+
+	canQueueInit (&bridge->queue, config->buffer, config->bufferSize, config->overflowPolicy);
+}
+
+void canBridgeStart (canBridge_t* bridge, void* workingArea, size_t workingAreaSize, tprio_t priority)
+{
+	chThdCreateStatic (workingArea, workingAreaSize, priority, canBridgeThread, bridge);
+}
+
+/**
+ * @brief Applies a rate-limited rule to a message.
+ * @return True if the message should be forwarded, false if it should be discarded.
+ */
+static bool rateLimit (canBridgeRule_t* rule, canId_t id, systime_t timeCurrent)
+{
+	// Find the identifier's slot, or the least recently used slot if the identifier has none.
+	canBridgeRuleSlot_t* slot = &rule->slots [0];
+	for (uint8_t index = 0; index < CAN_BRIDGE_RULE_SLOT_COUNT; ++index)
+	{
+		canBridgeRuleSlot_t* candidate = &rule->slots [index];
+
+		if (candidate->used && candidate->id == id)
+		{
+			// Discard the message if the identifier was forwarded too recently.
+			if (chTimeDiffX (candidate->timeForwarded, timeCurrent) < rule->minInterval)
+				return false;
+
+			candidate->timeForwarded = timeCurrent;
+			return true;
+		}
+
+		if (!candidate->used)
+		{
+			if (slot->used)
+				slot = candidate;
+		}
+		else if (slot->used && chTimeDiffX (candidate->timeForwarded, timeCurrent) > chTimeDiffX (slot->timeForwarded, timeCurrent))
+		{
+			slot = candidate;
+		}
+	}
+
+	// First message of this identifier, claim the slot.
+	slot->id			= id;
+	slot->timeForwarded	= timeCurrent;
+	slot->used			= true;
+	return true;
+}
+
+bool canBridgeRulesCheck (canBridgeRule_t* rules, uint16_t ruleCount, const CANRxFrame* frame, systime_t timeCurrent)
+{
+	if (rules == NULL)
+		return true;
+
+	canId_t id = canIdFromFrame (frame);
+	for (uint16_t index = 0; index < ruleCount; ++index)
+	{
+		canBridgeRule_t* rule = &rules [index];
+
+		// Check the rule matches.
+		if (id < rule->idLow || id > rule->idHigh || (id & rule->mask) != rule->value)
+			continue;
+
+		++rule->hitCount;
+
+		if (rule->minInterval == 0)
+			return true;
+
+		if (!rateLimit (rule, id, timeCurrent))
+		{
+			++rule->decimateCount;
+			return false;
+		}
+
+		return true;
+	}
+
+	// No rule matched.
+	return false;
+}
+
+bool canBridgeForward (canBridge_t* bridge, const CANRxFrame* frame)
+{
+	return canQueuePush (&bridge->queue, frame);
+}
\ No newline at end of file
@@ -0,0 +1,158 @@
+#ifndef CAN_BRIDGE_H
+#define CAN_BRIDGE_H
+
+// CAN Bridge -----------------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Object for re-transmitting received CAN messages on another CAN bus. This is used to virtually bridge two CAN
+//   busses, while maintaining electrical separation. Messages are forwarded into a bounded queue (see @c canQueue_t ), which
+//   is serviced by the bridge's own thread. This way, a congested destination bus only fills the queue, rather than stalling
+//   reception on the source bus. Note the bridge is uni-directional, to create a bi-directional bridge, a separate bridge
+//   should be instanced for the other bus.
+//
+//   Which messages are forwarded can be restricted using a table of forwarding rules (see @c canBridgeRule_t ). Each rule
+//   matches a range of identifiers, optionally limiting the rate at which each identifier is forwarded.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// Includes
+#include "can_id.h"
+#include "can_queue.h"
+
+// ChibiOS
+#include "hal.h"
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+#ifndef CAN_BRIDGE_RULE_SLOT_COUNT
+/// @brief The maximum number of distinct identifiers a single rate-limited rule can track. If a rule matches more
+/// identifiers than this, the least recently forwarded identifier's slot is re-used.
+#define CAN_BRIDGE_RULE_SLOT_COUNT 8
+#endif // CAN_BRIDGE_RULE_SLOT_COUNT
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+#define CAN_BRIDGE_WORKING_AREA(name) THD_WORKING_AREA (name, 512)
+
+/**
+ * @brief Slot tracking the last time a specific identifier was forwarded by a rate-limited rule.
+ */
+typedef struct
+{
+	canId_t id;
+	systime_t timeForwarded;
+	bool used;
+} canBridgeRuleSlot_t;
+
+/**
+ * @brief Rule of a forwarding table. A message matches a rule if its identifier is within the range [ @c idLow , @c idHigh ]
+ * and the bits of its identifier selected by @c mask are equal to @c value . Rules should be instanced in an array using
+ * designated initializers for the configuration fields, the remaining fields are used by the bridge and should be left zero.
+ */
+typedef struct
+{
+	/// @brief The lowest identifier matched by the rule (see @c canIdStandard and @c canIdExtended ).
+	canId_t idLow;
+
+	/// @brief The highest identifier matched by the rule.
+	canId_t idHigh;
+
+	/// @brief Mask of the identifier bits to compare against @c value . Leave 0 to match the entire range.
+	canId_t mask;
+
+	/// @brief The value of the identifier bits selected by @c mask .
+	canId_t value;
+
+	/// @brief The minimum interval between forwarding messages of the same identifier. Messages received sooner are discarded.
+	/// Leave 0 to forward every message.
+	sysinterval_t minInterval;
+
+	/// @brief The total number of messages that have matched the rule.
+	volatile uint32_t hitCount;
+
+	/// @brief The total number of matching messages that were discarded due to the rule's @c minInterval .
+	volatile uint32_t decimateCount;
+
+	/// @brief Forwarding times of the identifiers matched by the rule, only used if @c minInterval is non-zero.
+	canBridgeRuleSlot_t slots [CAN_BRIDGE_RULE_SLOT_COUNT];
+} canBridgeRule_t;
+
+typedef struct
+{
+	/// @brief Name to give the bridge's thread, used for debugging.
+	const char* name;
+
+	/// @brief The CAN driver to re-transmit messages on.
+	CANDriver* driver;
+
+	/// @brief The buffer to queue messages in.
+	CANRxFrame* buffer;
+
+	/// @brief The number of elements in @c buffer , that is, the maximum number of messages that may be waiting for
+	/// re-transmission.
+	uint16_t bufferSize;
+
+	/// @brief The action to take when a message is forwarded while the queue is full.
+	canQueueOverflowPolicy_t overflowPolicy;
+
+	/// @brief The timeout of each re-transmission. If a message cannot be transmitted within this interval, it is discarded.
+	sysinterval_t transmitTimeout;
+} canBridgeConfig_t;
+
+typedef struct
+{
+	/// @brief The configuration of the bridge.
+	const canBridgeConfig_t* config;
+
+	/// @brief The queue of messages waiting for re-transmission. The queue's counters are the number of messages forwarded to
+	/// the bridge and the number discarded due to overflow.
+	canQueue_t queue;
+
+	/// @brief The total number of messages re-transmitted.
+	volatile uint32_t transmitCount;
+
+	/// @brief The total number of messages discarded due to the transmission timing out.
+	volatile uint32_t timeoutCount;
+} canBridge_t;
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes a bridge using the specified configuration.
+ * @param bridge The bridge to initialize.
+ * @param config The configuration to use.
+ */
+void canBridgeInit (canBridge_t* bridge, const canBridgeConfig_t* config);
+
+/**
+ * @brief Creates the thread that services a bridge's queue.
+ * @param bridge The bridge to service. Must be initialized.
+ * @param workingArea The working area to provide the thread. One instance must be created per thread. Should be instanced
+ * using the @c CAN_BRIDGE_WORKING_AREA macro.
+ * @param workingAreaSize The size of the thread's @c workingArea . Should be obtained using @c sizeof(workingArea) .
+ * @param priority The priority to assign the thread.
+ */
+void canBridgeStart (canBridge_t* bridge, void* workingArea, size_t workingAreaSize, tprio_t priority);
+
+/**
+ * @brief Checks whether a message should be forwarded according to a table of forwarding rules. The first rule that matches
+ * the message is applied, messages that do not match any rule are not forwarded. Only to be called from a single thread.
+ * @param rules The array of rules to check. If @c NULL , all messages are forwarded.
+ * @param ruleCount The number of elements in @c rules .
+ * @param frame The message to check.
+ * @param timeCurrent The time the message was received at.
+ * @return True if the message should be forwarded, false otherwise.
+ */
+bool canBridgeRulesCheck (canBridgeRule_t* rules, uint16_t ruleCount, const CANRxFrame* frame, systime_t timeCurrent);
+
+/**
+ * @brief Forwards a received message to a bridge, queueing it for re-transmission. Only to be called from a single thread.
+ * @param bridge The bridge to forward to.
+ * @param frame The message to forward.
+ * @return True if the message was queued, false if it was discarded.
+ */
+bool canBridgeForward (canBridge_t* bridge, const CANRxFrame* frame);
+
+#endif // CAN_BRIDGE_H
\ No newline at end of file
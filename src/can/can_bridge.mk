@@ -0,0 +1,12 @@
+ifndef CAN_BRIDGE_MK
+define CAN_BRIDGE_MK
+1
+endef
+
+# Include the module's common dependencies
+include common/src/can/can_queue.mk
+
+# Add the module's source file to the compilation
+CSRC += common/src/can/can_bridge.c
+
+endif # CAN_BRIDGE_MK
\ No newline at end of file
@@ -0,0 +1,135 @@
+// Header
+#include "can_capture.h"
+
+// C Standard Library
+#include <string.h>
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+void canCaptureInit (canCapture_t* capture, const canCaptureConfig_t* config)
+{
+	capture->config = config;
+	canCaptureRestart (capture);
+}
+
+void canCaptureRestart (canCapture_t* capture)
+{
+	capture->writeCount		= 0;
+	capture->commitCount	= 0;
+	capture->stopCount		= 0;
+	capture->triggered		= false;
+}
+
+void canCaptureRecord (canCapture_t* capture, uint8_t channel, const CANRxFrame* frame, systime_t timeReceived)
+{
+	// Exit early if frozen. Note this is re-checked after reserving a record, as a trigger may occur in between.
+	if (capture->triggered && capture->writeCount >= capture->stopCount)
+		return;
+
+	// Reserve a record. This is atomic, so multiple threads may record concurrently.
+	uint32_t index = __atomic_fetch_add (&capture->writeCount, 1, __ATOMIC_RELAXED);
+	if (capture->triggered && index >= capture->stopCount)
+		return;
+
+	canCaptureRecord_t* record = &capture->config->buffer [index % capture->config->size];
+	record->time	= timeReceived;
+	record->id		= canIdFromFrame (frame);
+	record->dlc		= frame->DLC;
+	record->flags	= frame->RTR == CAN_RTR_REMOTE ? CAN_CAPTURE_FLAG_RTR : 0;
+	record->channel	= channel;
+	memcpy (record->data, frame->data8, sizeof (record->data));
+
+	// Publish the record. The barrier ensures the record is written before it is counted.
+	__DMB ();
+	__atomic_fetch_add (&capture->commitCount, 1, __ATOMIC_RELAXED);
+}
+
+void canCaptureTrigger (canCapture_t* capture)
+{
+	chSysLock ();
+	if (!capture->triggered)
+	{
+		capture->stopCount = capture->writeCount + capture->config->postTriggerCount;
+		__DMB ();
+		capture->triggered = true;
+	}
+	chSysUnlock ();
+}
+
+bool canCaptureIsFrozen (canCapture_t* capture)
+{
+	return capture->triggered && capture->commitCount >= capture->stopCount;
+}
+
+uint32_t canCaptureGetRecords (canCapture_t* capture, uint32_t* first)
+{
+	// Records past the stop count were reserved but discarded.
+	uint32_t count = capture->writeCount;
+	if (capture->triggered && count > capture->stopCount)
+		count = capture->stopCount;
+
+	// Only the last buffer's worth of records is held.
+	*first = count > capture->config->size ? count - capture->config->size : 0;
+	return count - *first;
+}
+
+const canCaptureRecord_t* canCaptureGetRecord (canCapture_t* capture, uint32_t index)
+{
+	return &capture->config->buffer [index % capture->config->size];
+}
+
+void canCaptureWrite (canCapture_t* capture, BaseSequentialStream* stream)
+{
+	uint32_t first;
+	uint32_t count = canCaptureGetRecords (capture, &first);
+
+	// Header
+	uint8_t header [16] = { 'C', 'C', 'A', 'P', CAN_CAPTURE_FORMAT_VERSION, sizeof (canCaptureRecord_t), 0, 0 };
+	uint32_t frequency = CH_CFG_ST_FREQUENCY;
+	memcpy (header + 8, &frequency, sizeof (frequency));
+	memcpy (header + 12, &count, sizeof (count));
+	streamWrite (stream, header, sizeof (header));
+
+	// Records, oldest first
+	for (uint32_t index = first; index < first + count; ++index)
+		streamWrite (stream, (const uint8_t*) canCaptureGetRecord (capture, index), sizeof (canCaptureRecord_t));
+}
+
+uint32_t canCaptureReplay (canCapture_t* capture, uint8_t channel, canNode_t** nodes, uint8_t nodeCount, bool realTime)
+{
+	uint32_t first;
+	uint32_t count = canCaptureGetRecords (capture, &first);
+	uint32_t handledCount = 0;
+
+	systime_t timeStart = chVTGetSystemTime ();
+	systime_t timeFirst = count != 0 ? canCaptureGetRecord (capture, first)->time : 0;
+
+	for (uint32_t index = first; index < first + count; ++index)
+	{
+		const canCaptureRecord_t* record = canCaptureGetRecord (capture, index);
+		if (record->channel != channel)
+			continue;
+
+		// Wait until the record's time, relative to the first record.
+		if (realTime)
+			chThdSleepUntilWindowed (timeStart, chTimeAddX (timeStart, chTimeDiffX (timeFirst, record->time)));
+
+		// Re-create the received frame.
+		CANRxFrame frame =
+		{
+			.DLC	= record->dlc,
+			.RTR	= (record->flags & CAN_CAPTURE_FLAG_RTR) != 0 ? CAN_RTR_REMOTE : CAN_RTR_DATA,
+			.IDE	= canIdIsExtended (record->id) ? CAN_IDE_EXT : CAN_IDE_STD
+		};
+		if (canIdIsExtended (record->id))
+			frame.EID = canIdGetValue (record->id);
+		else
+			frame.SID = canIdGetValue (record->id);
+		memcpy (frame.data8, record->data, sizeof (frame.data8));
+
+		if (canNodesReceive (nodes, nodeCount, &frame))
+			++handledCount;
+	}
+
+	return handledCount;
+}
\ No newline at end of file
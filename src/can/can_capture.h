@@ -0,0 +1,176 @@
+#ifndef CAN_CAPTURE_H
+#define CAN_CAPTURE_H
+
+// CAN Traffic Capture --------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Ring buffer recording received CAN messages, used to capture the bus traffic surrounding an event. Messages
+//   are recorded continuously, overwriting the oldest records, until the capture is triggered. After the trigger, a
+//   configurable number of further messages is recorded before the capture is frozen. The buffer then holds the messages
+//   preceding and following the trigger.
+//
+//   Recording is lock-free and may be performed by multiple threads (ex. the CAN threads of both busses), each record
+//   identifying the bus it was received on. A capture can be written to a stream (ex. the debug serial port) in a compact
+//   binary format, see tools/can_capture.py for converting captures into candump log files. Captures can also be replayed
+//   through a set of CAN nodes, for debugging node handlers without the original bus.
+//
+//   Binary format (little-endian):
+//   - Header (16 bytes): The magic string "CCAP", format version (u8), record size (u8), reserved (u16), system tick frequency
+//     in Hz (u32), record count (u32).
+//   - Records (20 bytes each, oldest first): Receive time in system ticks (u32), identifier (u32, see @c canId_t ), DLC (u8),
+//     flags (u8, bit 0: remote frame), channel (u8), reserved (u8), data (8 bytes).
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// Includes
+#include "can_id.h"
+#include "can_node.h"
+
+// ChibiOS
+#include "hal.h"
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+/// @brief The version of the binary format written by @c canCaptureWrite .
+#define CAN_CAPTURE_FORMAT_VERSION 1
+
+/// @brief Flag of a record indicating the message was a remote frame.
+#define CAN_CAPTURE_FLAG_RTR 0x01
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief A single recorded CAN message.
+ */
+typedef struct
+{
+	/// @brief The time the message was received at, in system ticks.
+	uint32_t time;
+
+	/// @brief The identifier of the message.
+	canId_t id;
+
+	/// @brief The data length code of the message.
+	uint8_t dlc;
+
+	/// @brief Flags of the message, see @c CAN_CAPTURE_FLAG_RTR .
+	uint8_t flags;
+
+	/// @brief The channel (bus) the message was received on.
+	uint8_t channel;
+
+	uint8_t reserved;
+
+	/// @brief The payload of the message.
+	uint8_t data [8];
+} canCaptureRecord_t;
+
+typedef struct
+{
+	/// @brief The buffer to store records in.
+	canCaptureRecord_t* buffer;
+
+	/// @brief The number of elements in @c buffer .
+	uint32_t size;
+
+	/// @brief The number of messages to record after the capture is triggered. The remainder of the buffer holds the messages
+	/// received before the trigger. Must not exceed @c size .
+	uint32_t postTriggerCount;
+} canCaptureConfig_t;
+
+typedef struct
+{
+	/// @brief The configuration of the capture.
+	const canCaptureConfig_t* config;
+
+	/// @brief The total number of records reserved since the capture was started. The record at index @c n is stored in
+	/// element @c n % @c size of the buffer.
+	volatile uint32_t writeCount;
+
+	/// @brief The number of records written into the buffer.
+	volatile uint32_t commitCount;
+
+	/// @brief Indicates whether the capture has been triggered.
+	volatile bool triggered;
+
+	/// @brief The number of records at which the capture is frozen, only valid once triggered.
+	volatile uint32_t stopCount;
+} canCapture_t;
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes a capture using the specified configuration. The capture begins recording immediately.
+ * @param capture The capture to initialize.
+ * @param config The configuration to use.
+ */
+void canCaptureInit (canCapture_t* capture, const canCaptureConfig_t* config);
+
+/**
+ * @brief Discards all records of a capture and begins recording again.
+ * @note This must not be called while another thread may be recording into the capture.
+ * @param capture The capture to restart.
+ */
+void canCaptureRestart (canCapture_t* capture);
+
+/**
+ * @brief Records a received message. Does nothing if the capture is frozen.
+ * @param capture The capture to record into.
+ * @param channel The channel (bus) the message was received on.
+ * @param frame The received message.
+ * @param timeReceived The time the message was received at.
+ */
+void canCaptureRecord (canCapture_t* capture, uint8_t channel, const CANRxFrame* frame, systime_t timeReceived);
+
+/**
+ * @brief Triggers a capture, such that it is frozen after @c postTriggerCount further messages are recorded. Does nothing if
+ * the capture was already triggered.
+ * @param capture The capture to trigger.
+ */
+void canCaptureTrigger (canCapture_t* capture);
+
+/**
+ * @brief Checks whether a capture has been triggered and all of its post-trigger records have been written.
+ * @param capture The capture to check.
+ * @return True if frozen, false otherwise.
+ */
+bool canCaptureIsFrozen (canCapture_t* capture);
+
+/**
+ * @brief Gets the records currently held by a capture.
+ * @param capture The capture to read.
+ * @param first Written to contain the index of the oldest record (see @c canCaptureGetRecord ).
+ * @return The number of records.
+ */
+uint32_t canCaptureGetRecords (canCapture_t* capture, uint32_t* first);
+
+/**
+ * @brief Gets a record of a capture by index.
+ * @param capture The capture to read.
+ * @param index The index of the record, in the range [ @c first , @c first + @c count ) of @c canCaptureGetRecords .
+ * @return The record.
+ */
+const canCaptureRecord_t* canCaptureGetRecord (canCapture_t* capture, uint32_t index);
+
+/**
+ * @brief Writes the records of a frozen capture to a stream in the binary format described above.
+ * @param capture The capture to write, should be frozen.
+ * @param stream The stream to write to.
+ */
+void canCaptureWrite (canCapture_t* capture, BaseSequentialStream* stream);
+
+/**
+ * @brief Replays the records of a capture through an array of CAN nodes, as if they were received by a CAN thread.
+ * @param capture The capture to replay, should be frozen.
+ * @param channel The channel of the records to replay, records of other channels are skipped.
+ * @param nodes The array of nodes to replay into.
+ * @param nodeCount The number of elements in @c nodes .
+ * @param realTime Indicates whether to replay the records with their original timing. If false, the records are replayed
+ * immediately.
+ * @return The number of records that were handled by a node.
+ */
+uint32_t canCaptureReplay (canCapture_t* capture, uint8_t channel, canNode_t** nodes, uint8_t nodeCount, bool realTime);
+
+#endif // CAN_CAPTURE_H
\ No newline at end of file
@@ -0,0 +1,12 @@
+ifndef CAN_CAPTURE_MK
+define CAN_CAPTURE_MK
+1
+endef
+
+# Include the module's common dependencies
+include common/src/can/can_node.mk
+
+# Add the module's source file to the compilation
+CSRC += common/src/can/can_capture.c
+
+endif # CAN_CAPTURE_MK
\ No newline at end of file
@@ -0,0 +1,404 @@
+// Header
+#include "can_filter.h"
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+/// @brief 16-bit filter bit indicating a remote frame.
+#define FILTER_16_RTR			(1 << 4)
+
+/// @brief 16-bit filter bit indicating an extended identifier.
+#define FILTER_16_IDE			(1 << 3)
+
+/// @brief 32-bit filter bit indicating a remote frame.
+#define FILTER_32_RTR			(1 << 1)
+
+/// @brief 32-bit filter bit indicating an extended identifier.
+#define FILTER_32_IDE			(1 << 2)
+
+/// @brief 32-bit filter bit that is reserved, always cleared in a received frame.
+#define FILTER_32_RESERVED		(1 << 0)
+
+/// @brief The number of standard identifiers fitting in a 16-bit list mode bank.
+#define STANDARD_LIST_PER_BANK	4
+
+/// @brief The number of standard identifier / mask pairs fitting in a 16-bit mask mode bank.
+#define STANDARD_MASK_PER_BANK	2
+
+/// @brief The number of extended identifiers fitting in a 32-bit list mode bank.
+#define EXTENDED_LIST_PER_BANK	2
+
+/// @brief The number of extended identifier / mask pairs fitting in a 32-bit mask mode bank.
+#define EXTENDED_MASK_PER_BANK	1
+
+// Register Packing -----------------------------------------------------------------------------------------------------------
+
+// Standard identifiers are packed in the 16-bit scale: STID[10:0] at bits 15:5, RTR at bit 4, IDE at bit 3.
+#define STANDARD_TO_FILTER_16(sid)		((uint32_t) (sid) << 5)
+#define STANDARD_MASK_TO_FILTER_16(m)	(((uint32_t) (m) << 5) | FILTER_16_RTR | FILTER_16_IDE)
+
+// Extended identifiers are packed in the 32-bit scale: EXID[28:0] at bits 31:3, IDE at bit 2, RTR at bit 1.
+#define EXTENDED_TO_FILTER_32(eid)		(((uint32_t) (eid) << 3) | FILTER_32_IDE)
+#define EXTENDED_MASK_TO_FILTER_32(m)	(((uint32_t) (m) << 3) | FILTER_32_IDE | FILTER_32_RTR)
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+/// @brief A single identifier / mask pair. Bits set in the mask must match the identifier.
+typedef struct
+{
+	canId_t id;
+	uint32_t mask;
+} entry_t;
+
+// Global Memory --------------------------------------------------------------------------------------------------------------
+
+// Working memory is static, as it may be larger than the stack of the calling thread.
+
+/// @brief Working set of entries.
+static entry_t entries [CAN_FILTER_ID_COUNT_MAX];
+
+/// @brief Filters of the exact standard identifiers, in the 16-bit scale.
+static uint32_t standardListFilters [CAN_FILTER_ID_COUNT_MAX];
+
+/// @brief Filters of the merged standard identifiers, in the 16-bit scale. The identifier is in the lower half, the mask in
+/// the upper half.
+static uint32_t standardMaskFilters [CAN_FILTER_ID_COUNT_MAX];
+
+/// @brief Filters of the exact extended identifiers, in the 32-bit scale.
+static uint32_t extendedListFilters [CAN_FILTER_ID_COUNT_MAX];
+
+/// @brief Filters of the merged extended identifiers, in the 32-bit scale. Stored as identifier / mask pairs.
+static uint32_t extendedMaskFilters [CAN_FILTER_ID_COUNT_MAX * 2];
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+static inline uint32_t domainMask (canId_t id)
+{
+	return canIdIsExtended (id) ? CAN_ID_EXTENDED_MASK : CAN_ID_STANDARD_MASK;
+}
+
+static inline bool entryIsExact (const entry_t* entry)
+{
+	return entry->mask == domainMask (entry->id);
+}
+
+static inline bool entryContains (const entry_t* outer, const entry_t* inner)
+{
+	// The outer entry accepts everything the inner entry does if each bit significant to the outer entry is also significant
+	// to the inner entry, and those bits match.
+	return canIdIsExtended (outer->id) == canIdIsExtended (inner->id)
+		&& (outer->mask & ~inner->mask) == 0
+		&& ((canIdGetValue (outer->id) ^ canIdGetValue (inner->id)) & outer->mask) == 0;
+}
+
+static inline uint32_t ceilDivide (uint32_t numerator, uint32_t denominator)
+{
+	return (numerator + denominator - 1) / denominator;
+}
+
+/**
+ * @brief Calculates the number of standard identifiers to place in mask mode banks (as exact matches) rather than list mode
+ * banks. Filling otherwise empty mask slots can save a bank.
+ * @param listCount The number of exact standard identifiers.
+ * @param maskCount The number of merged standard identifiers.
+ * @param bankCount Written to contain the resulting number of banks.
+ * @return The number of exact identifiers to move into mask mode banks.
+ */
+static uint16_t standardMaskOverflow (uint16_t listCount, uint16_t maskCount, uint16_t* bankCount)
+{
+	uint16_t bestMoved = 0;
+	*bankCount = ceilDivide (listCount, STANDARD_LIST_PER_BANK) + ceilDivide (maskCount, STANDARD_MASK_PER_BANK);
+
+	for (uint16_t moved = 1; moved <= listCount; ++moved)
+	{
+		uint16_t count = ceilDivide (listCount - moved, STANDARD_LIST_PER_BANK) +
+			ceilDivide (maskCount + moved, STANDARD_MASK_PER_BANK);
+
+		if (count < *bankCount)
+		{
+			*bankCount = count;
+			bestMoved = moved;
+		}
+	}
+
+	return bestMoved;
+}
+
+static uint16_t countBanks (uint16_t standardList, uint16_t standardMask, uint16_t extendedList, uint16_t extendedMask)
+{
+	uint16_t bankCount;
+	standardMaskOverflow (standardList, standardMask, &bankCount);
+	return bankCount + ceilDivide (extendedList, EXTENDED_LIST_PER_BANK) +
+		ceilDivide (extendedMask, EXTENDED_MASK_PER_BANK);
+}
+
+static entry_t entryMerge (const entry_t* a, const entry_t* b)
+{
+	// Only the bits that are significant in both entries, and equal in both entries, remain significant.
+	uint32_t mask = a->mask & b->mask & ~(canIdGetValue (a->id) ^ canIdGetValue (b->id));
+
+	return (entry_t)
+	{
+		.id		= (a->id & ~CAN_ID_EXTENDED_MASK) | (canIdGetValue (a->id) & mask),
+		.mask	= mask
+	};
+}
+
+static void emitBank (canFilterBank_t* bank, canFilterMode_t mode, canFilterScale_t scale, const uint32_t* filters,
+	uint8_t filterCount, uint8_t filtersPerBank)
+{
+	// Unused slots repeat the first filter, as empty slots would otherwise match identifier 0.
+	uint32_t slots [4];
+	for (uint8_t index = 0; index < filtersPerBank; ++index)
+		slots [index] = filters [index < filterCount ? index : 0];
+
+	bank->mode	= mode;
+	bank->scale	= scale;
+
+	if (scale == CAN_FILTER_SCALE_16)
+	{
+		bank->register1 = slots [0] | (slots [1] << 16);
+		bank->register2 = slots [2] | (slots [3] << 16);
+	}
+	else
+	{
+		bank->register1 = slots [0];
+		bank->register2 = slots [1];
+	}
+}
+
+int8_t canFilterPack (const canId_t* ids, uint16_t idCount, canFilterBank_t* banks, uint8_t bankCount)
+{
+	if (idCount > CAN_FILTER_ID_COUNT_MAX)
+		return -1;
+
+	// Initialize the working set, each identifier starts as an exact match. Duplicates are removed.
+	uint16_t entryCount = 0;
+	for (uint16_t idIndex = 0; idIndex < idCount; ++idIndex)
+	{
+		bool duplicate = false;
+		for (uint16_t entryIndex = 0; entryIndex < entryCount; ++entryIndex)
+			if (entries [entryIndex].id == ids [idIndex])
+				duplicate = true;
+
+		if (duplicate)
+			continue;
+
+		entries [entryCount] = (entry_t)
+		{
+			.id		= ids [idIndex],
+			.mask	= domainMask (ids [idIndex])
+		};
+		++entryCount;
+	}
+
+	// Count each category of entry.
+	uint16_t standardList = 0;
+	uint16_t standardMask = 0;
+	uint16_t extendedList = 0;
+	uint16_t extendedMask = 0;
+	for (uint16_t index = 0; index < entryCount; ++index)
+	{
+		if (canIdIsExtended (entries [index].id))
+			++extendedList;
+		else
+			++standardList;
+	}
+
+	// Merge entries until the result fits in the available banks.
+	while (countBanks (standardList, standardMask, extendedList, extendedMask) > bankCount)
+	{
+		int16_t bestA = -1;
+		int16_t bestB = -1;
+		uint16_t bestBanks = UINT16_MAX;
+		int8_t bestSpecificity = -1;
+
+		for (uint16_t a = 0; a < entryCount; ++a)
+		{
+			for (uint16_t b = a + 1; b < entryCount; ++b)
+			{
+				// Standard and extended identifiers cannot share a filter.
+				if (canIdIsExtended (entries [a].id) != canIdIsExtended (entries [b].id))
+					continue;
+
+				bool extended = canIdIsExtended (entries [a].id);
+				uint16_t exact = entryIsExact (&entries [a]) + entryIsExact (&entries [b]);
+
+				// Count the banks resulting from this merge, the merged entry is always a mask entry.
+				uint16_t mergedBanks = extended ?
+					countBanks (standardList, standardMask, extendedList - exact, extendedMask - (2 - exact) + 1) :
+					countBanks (standardList - exact, standardMask - (2 - exact) + 1, extendedList, extendedMask);
+
+				// Prefer merges that use fewer banks, then merges that accept fewer unwanted identifiers.
+				entry_t merged = entryMerge (&entries [a], &entries [b]);
+				int8_t specificity = __builtin_popcount (merged.mask);
+
+				if (mergedBanks < bestBanks || (mergedBanks == bestBanks && specificity > bestSpecificity))
+				{
+					bestA			= a;
+					bestB			= b;
+					bestBanks		= mergedBanks;
+					bestSpecificity	= specificity;
+				}
+			}
+		}
+
+		// If no merges are possible, the identifiers cannot be packed.
+		if (bestA < 0)
+			return -1;
+
+		// Replace the 1st entry with the merged entry and remove the 2nd.
+		entries [bestA] = entryMerge (&entries [bestA], &entries [bestB]);
+		entries [bestB] = entries [entryCount - 1];
+		--entryCount;
+
+		// Remove any other entries the merged entry now accepts.
+		for (uint16_t index = 0; index < entryCount; ++index)
+		{
+			if (index != (uint16_t) bestA && entryContains (&entries [bestA], &entries [index]))
+			{
+				entries [index] = entries [entryCount - 1];
+				--entryCount;
+
+				// The entry being merged into may have been moved.
+				if (bestA == entryCount)
+					bestA = index;
+				else
+					--index;
+			}
+		}
+
+		// Re-count each category of entry.
+		standardList = 0;
+		standardMask = 0;
+		extendedList = 0;
+		extendedMask = 0;
+		for (uint16_t index = 0; index < entryCount; ++index)
+		{
+			bool exact = entryIsExact (&entries [index]);
+			if (canIdIsExtended (entries [index].id))
+			{
+				extendedList += exact;
+				extendedMask += !exact;
+			}
+			else
+			{
+				standardList += exact;
+				standardMask += !exact;
+			}
+		}
+	}
+
+	// Determine how many exact standard identifiers should fill mask mode slots.
+	uint16_t standardBanks;
+	uint16_t standardMoved = standardMaskOverflow (standardList, standardMask, &standardBanks);
+
+	// Build the filter of each entry, sorting them by the type of bank they belong to.
+	standardList = 0;
+	standardMask = 0;
+	extendedList = 0;
+	extendedMask = 0;
+
+	for (uint16_t index = 0; index < entryCount; ++index)
+	{
+		entry_t* entry = &entries [index];
+		uint32_t value = canIdGetValue (entry->id);
+		bool exact = entryIsExact (entry);
+
+		if (canIdIsExtended (entry->id))
+		{
+			if (exact)
+			{
+				extendedListFilters [extendedList] = EXTENDED_TO_FILTER_32 (value);
+				++extendedList;
+			}
+			else
+			{
+				extendedMaskFilters [extendedMask * 2] = EXTENDED_TO_FILTER_32 (value);
+				extendedMaskFilters [extendedMask * 2 + 1] = EXTENDED_MASK_TO_FILTER_32 (entry->mask);
+				++extendedMask;
+			}
+		}
+		else
+		{
+			if (exact && standardMoved == 0)
+			{
+				standardListFilters [standardList] = STANDARD_TO_FILTER_16 (value);
+				++standardList;
+			}
+			else
+			{
+				if (exact)
+					--standardMoved;
+
+				standardMaskFilters [standardMask] = STANDARD_TO_FILTER_16 (value) |
+					(STANDARD_MASK_TO_FILTER_16 (entry->mask) << 16);
+				++standardMask;
+			}
+		}
+	}
+
+	// Emit the banks.
+	uint8_t bankIndex = 0;
+
+	for (uint16_t index = 0; index < standardList; index += STANDARD_LIST_PER_BANK)
+	{
+		emitBank (&banks [bankIndex], CAN_FILTER_MODE_LIST, CAN_FILTER_SCALE_16, &standardListFilters [index],
+			standardList - index, STANDARD_LIST_PER_BANK);
+		++bankIndex;
+	}
+
+	for (uint16_t index = 0; index < standardMask; index += STANDARD_MASK_PER_BANK)
+	{
+		// Each 16-bit mask mode filter occupies an entire register.
+		uint32_t first = standardMaskFilters [index];
+		uint32_t second = standardMaskFilters [index + 1 < standardMask ? index + 1 : index];
+
+		banks [bankIndex] = (canFilterBank_t)
+		{
+			.mode		= CAN_FILTER_MODE_MASK,
+			.scale		= CAN_FILTER_SCALE_16,
+			.register1	= first,
+			.register2	= second
+		};
+		++bankIndex;
+	}
+
+	for (uint16_t index = 0; index < extendedList; index += EXTENDED_LIST_PER_BANK)
+	{
+		emitBank (&banks [bankIndex], CAN_FILTER_MODE_LIST, CAN_FILTER_SCALE_32, &extendedListFilters [index],
+			extendedList - index, EXTENDED_LIST_PER_BANK);
+		++bankIndex;
+	}
+
+	for (uint16_t index = 0; index < extendedMask; ++index)
+	{
+		emitBank (&banks [bankIndex], CAN_FILTER_MODE_MASK, CAN_FILTER_SCALE_32, &extendedMaskFilters [index * 2], 2, 2);
+		++bankIndex;
+	}
+
+	return bankIndex;
+}
+
+canFilterBank_t canFilterAcceptAll (void)
+{
+	// 32-bit mask mode with an empty mask accepts everything.
+	return (canFilterBank_t)
+	{
+		.mode		= CAN_FILTER_MODE_MASK,
+		.scale		= CAN_FILTER_SCALE_32,
+		.register1	= 0,
+		.register2	= 0
+	};
+}
+
+canFilterBank_t canFilterRejectAll (void)
+{
+	// 32-bit list mode with the reserved bit (bit 0) set. Received frames always have this bit cleared, so never match.
+	return (canFilterBank_t)
+	{
+		.mode		= CAN_FILTER_MODE_LIST,
+		.scale		= CAN_FILTER_SCALE_32,
+		.register1	= FILTER_32_RESERVED,
+		.register2	= FILTER_32_RESERVED
+	};
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#ifndef CAN_FILTER_H
+#define CAN_FILTER_H
+
+// CAN Filter Packing ---------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Solver for packing a set of CAN message identifiers into the filter banks of the STM32's bxCAN peripheral.
+//   Identifiers are packed into list mode banks where possible (4 standard or 2 extended identifiers per bank). If the
+//   available banks are exhausted, identifiers are merged into mask mode banks, choosing the merges that accept the fewest
+//   unwanted identifiers.
+//
+//   Note this module has no dependency on ChibiOS, so it may also be compiled and tested on a host machine. See the
+//   @c can_thread module for applying the result to the hardware.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// Includes
+#include "can_id.h"
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+/// @brief The number of filter banks shared by CAN1 and CAN2 in the STM32F405.
+#define CAN_FILTER_BANK_COUNT 28
+
+#ifndef CAN_FILTER_ID_COUNT_MAX
+/// @brief The maximum number of identifiers that can be packed in a single call to @c canFilterPack .
+#define CAN_FILTER_ID_COUNT_MAX 64
+#endif // CAN_FILTER_ID_COUNT_MAX
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+typedef enum
+{
+	/// @brief The bank matches identifiers against an identifier / mask pair.
+	CAN_FILTER_MODE_MASK = 0,
+
+	/// @brief The bank matches identifiers against a list of exact identifiers.
+	CAN_FILTER_MODE_LIST = 1
+} canFilterMode_t;
+
+typedef enum
+{
+	/// @brief The bank is split into two 16-bit filters (standard identifiers only).
+	CAN_FILTER_SCALE_16 = 0,
+
+	/// @brief The bank is a single 32-bit filter.
+	CAN_FILTER_SCALE_32 = 1
+} canFilterScale_t;
+
+/**
+ * @brief The configuration of a single bxCAN filter bank. The register values are in the format of the bank's @c FxR1 and
+ * @c FxR2 registers, see the STM32F405 reference manual for details.
+ */
+typedef struct
+{
+	canFilterMode_t		mode;
+	canFilterScale_t	scale;
+	uint32_t			register1;
+	uint32_t			register2;
+} canFilterBank_t;
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Packs a set of identifiers into the minimum number of filter banks. If the identifiers do not fit into the specified
+ * number of banks, identifiers are merged into mask mode banks until they do. Remote frames are always rejected.
+ * @note This function is not re-entrant.
+ * @param ids The array of identifiers to accept. Duplicates are permitted.
+ * @param idCount The number of elements in @c ids . Must not exceed @c CAN_FILTER_ID_COUNT_MAX .
+ * @param banks Array to write the bank configurations into.
+ * @param bankCount The number of elements in @c banks , that is, the maximum number of banks to use.
+ * @return The number of banks used, or -1 if the identifiers could not be packed (either too many identifiers were given, or
+ * too few banks).
+ */
+int8_t canFilterPack (const canId_t* ids, uint16_t idCount, canFilterBank_t* banks, uint8_t bankCount);
+
+/**
+ * @brief Gets the configuration of a bank that accepts all frames.
+ * @return The bank configuration.
+ */
+canFilterBank_t canFilterAcceptAll (void);
+
+/**
+ * @brief Gets the configuration of a bank that rejects all frames. Used to occupy a bank that must exist, but should not
+ * accept anything.
+ * @return The bank configuration.
+ */
+canFilterBank_t canFilterRejectAll (void);
+
+#endif // CAN_FILTER_H
\ No newline at end of file
@@ -0,0 +1,9 @@
+ifndef CAN_FILTER_MK
+define CAN_FILTER_MK
+1
+endef
+
+# Add the module's source file to the compilation
+CSRC += common/src/can/can_filter.c
+
+endif # CAN_FILTER_MK
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef CAN_ID_H
+#define CAN_ID_H
+
+// CAN Identifier -------------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Packed representation of a CAN message identifier. Standard (11-bit) and extended (29-bit) identifiers are
+//   stored in a single integer, using the most significant bit to indicate which type the identifier is. Packed identifiers
+//   can be sorted and compared directly, and are distinct even when a standard and extended identifier share a value.
+//
+//   Note this module has no dependency on ChibiOS, so it may also be used by host-side code.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// C Standard Library
+#include <stdbool.h>
+#include <stdint.h>
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+/// @brief Packed CAN identifier. Use the macros below to create and decompose values of this type.
+typedef uint32_t canId_t;
+
+// Macros ---------------------------------------------------------------------------------------------------------------------
+
+/// @brief Bit indicating a packed identifier is an extended identifier.
+#define CAN_ID_EXTENDED_FLAG		0x80000000
+
+/// @brief Mask of the bits of a standard identifier.
+#define CAN_ID_STANDARD_MASK		0x000007FF
+
+/// @brief Mask of the bits of an extended identifier.
+#define CAN_ID_EXTENDED_MASK		0x1FFFFFFF
+
+/// @brief Creates a packed identifier from an 11-bit standard identifier.
+#define canIdStandard(sid)			((canId_t) ((sid) & CAN_ID_STANDARD_MASK))
+
+/// @brief Creates a packed identifier from a 29-bit extended identifier.
+#define canIdExtended(eid)			((canId_t) (((eid) & CAN_ID_EXTENDED_MASK) | CAN_ID_EXTENDED_FLAG))
+
+/// @brief Checks whether a packed identifier is an extended identifier.
+#define canIdIsExtended(id)			(((id) & CAN_ID_EXTENDED_FLAG) == CAN_ID_EXTENDED_FLAG)
+
+/// @brief Gets the numeric value (SID or EID) of a packed identifier.
+#define canIdGetValue(id)			((id) & CAN_ID_EXTENDED_MASK)
+
+/**
+ * @brief Gets the packed identifier of a ChibiOS CAN frame (either @c CANRxFrame or @c CANTxFrame ).
+ * @note This macro is only usable in code that includes the ChibiOS HAL.
+ */
+#define canIdFromFrame(frame)		((frame)->IDE == CAN_IDE_EXT ? canIdExtended ((frame)->EID) : canIdStandard ((frame)->SID))
+
+#endif // CAN_ID_H
\ No newline at end of file
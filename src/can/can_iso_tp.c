@@ -0,0 +1,425 @@
+// Header
+#include "can_iso_tp.h"
+
+// C Standard Library
+#include <string.h>
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+// Protocol control information (upper nibble of the first byte)
+#define PCI_SINGLE_FRAME		0x0
+#define PCI_FIRST_FRAME			0x1
+#define PCI_CONSECUTIVE_FRAME	0x2
+#define PCI_FLOW_CONTROL		0x3
+
+// Flow status of a flow control frame
+#define FLOW_STATUS_CONTINUE	0x0
+#define FLOW_STATUS_WAIT		0x1
+#define FLOW_STATUS_OVERFLOW	0x2
+
+/// @brief The largest message that can be sent in a single frame.
+#define SINGLE_FRAME_SIZE_MAX 7
+
+/// @brief The largest message that can be described by a standard (12-bit length) first frame.
+#define FIRST_FRAME_SIZE_MAX 4095
+
+/// @brief The number of data bytes in a consecutive frame.
+#define CONSECUTIVE_FRAME_SIZE 7
+
+// Function Prototypes --------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Transmits a message that does not fit in a single frame, segmenting it into a first frame and consecutive frames.
+ * @param link The link to transmit on.
+ * @param data The data of the message.
+ * @param size The size of the message, in bytes.
+ * @return True if successful, false otherwise.
+ */
+static bool transmitSegmented (canIsoTpLink_t* link, const uint8_t* data, uint16_t size);
+
+/**
+ * @brief Builds a frame to transmit on a link, padding any unused bytes.
+ * @param link The link to transmit on.
+ * @param data The data of the frame.
+ * @param size The number of bytes in @c data , at most 8.
+ * @param frame Written to contain the frame.
+ */
+static void buildFrame (canIsoTpLink_t* link, const uint8_t* data, uint8_t size, CANTxFrame* frame);
+
+/**
+ * @brief Transmits a frame on a link, padding any unused bytes. Blocks until a mailbox is available, or the link's transmit
+ * timeout expires.
+ * @param link The link to transmit on.
+ * @param data The data of the frame.
+ * @param size The number of bytes in @c data , at most 8.
+ * @return True if successful, false otherwise.
+ */
+static bool transmitFrame (canIsoTpLink_t* link, const uint8_t* data, uint8_t size);
+
+/**
+ * @brief Transmits a flow control frame on a link. As this is called from the CAN thread, it does not block: if no mailbox is
+ * available, the frame is dropped.
+ * @param link The link to transmit on.
+ * @param flowStatus The flow status to indicate.
+ * @return True if successful, false if no mailbox was available.
+ */
+static bool transmitFlowControl (canIsoTpLink_t* link, uint8_t flowStatus);
+
+/**
+ * @brief Converts an ISO-TP separation time into a system interval.
+ * @param separationTime The separation time, in the ISO-TP encoding.
+ * @return The equivalent interval.
+ */
+static sysinterval_t separationTimeToInterval (uint8_t separationTime);
+
+// Thread Entrypoint ----------------------------------------------------------------------------------------------------------
+
+THD_FUNCTION (canIsoTpThread, arg)
+{
+	// Only argument is the link
+	canIsoTpLink_t* link = (canIsoTpLink_t*) arg;
+
+	// Set the name
+	chRegSetThreadName (link->config->name);
+
+	while (true)
+	{
+		// Block until a message is received
+		chBSemWait (&link->rxSemaphore);
+		if (link->rxState != CAN_ISO_TP_RX_COMPLETE)
+			continue;
+
+		if (link->config->messageHandler != NULL)
+			link->config->messageHandler (link->config->object, link, link->config->buffer, link->rxSize);
+
+		// Release the buffer for the next message
+		link->rxState = CAN_ISO_TP_RX_IDLE;
+	}
+}
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+void canIsoTpInit (canIsoTpLink_t* link, const canIsoTpConfig_t* config)
+{
+	link->config			= config;
+	link->rxState			= CAN_ISO_TP_RX_IDLE;
+	link->rxSize			= 0;
+	link->rxCount			= 0;
+	link->txWaiting			= false;
+	link->rxMessageCount	= 0;
+	link->rxErrorCount		= 0;
+
+	chBSemObjectInit (&link->rxSemaphore, true);
+	chBSemObjectInit (&link->txSemaphore, true);
+}
+
+void canIsoTpStart (canIsoTpLink_t* link, void* workingArea, size_t workingAreaSize, tprio_t priority)
+{
+	chThdCreateStatic (workingArea, workingAreaSize, priority, canIsoTpThread, link);
+}
+
+bool canIsoTpReceive (canIsoTpLink_t* link, CANRxFrame* frame)
+{
+	if (canIdFromFrame (frame) != link->config->rxId || frame->DLC < 1)
+		return false;
+
+	uint8_t pci = frame->data8 [0] >> 4;
+	switch (pci)
+	{
+	case PCI_SINGLE_FRAME:
+	{
+		// Discard the message if the previous one is still being handled.
+		if (link->rxState == CAN_ISO_TP_RX_COMPLETE)
+		{
+			++link->rxErrorCount;
+			break;
+		}
+
+		uint8_t size = frame->data8 [0] & 0x0F;
+		if (size == 0 || size > SINGLE_FRAME_SIZE_MAX || size > frame->DLC - 1 || size > link->config->bufferSize)
+		{
+			link->rxState = CAN_ISO_TP_RX_IDLE;
+			++link->rxErrorCount;
+			break;
+		}
+
+		memcpy (link->config->buffer, frame->data8 + 1, size);
+		link->rxSize = size;
+		link->rxState = CAN_ISO_TP_RX_COMPLETE;
+		++link->rxMessageCount;
+		chBSemSignal (&link->rxSemaphore);
+		break;
+	}
+
+	case PCI_FIRST_FRAME:
+	{
+		if (frame->DLC < 8)
+			break;
+
+		// Reject the message if the previous one is still being handled.
+		if (link->rxState == CAN_ISO_TP_RX_COMPLETE)
+		{
+			++link->rxErrorCount;
+			transmitFlowControl (link, FLOW_STATUS_OVERFLOW);
+			break;
+		}
+
+		// Standard first frames have a 12-bit length, escaped first frames have a length of 0 followed by a 32-bit length.
+		uint32_t size = ((frame->data8 [0] & 0x0F) << 8) | frame->data8 [1];
+		uint8_t headerSize = 2;
+		if (size == 0)
+		{
+			size = ((uint32_t) frame->data8 [2] << 24) | ((uint32_t) frame->data8 [3] << 16) |
+				((uint32_t) frame->data8 [4] << 8) | frame->data8 [5];
+			headerSize = 6;
+		}
+
+		// Reject the message if it doesn't fit in the buffer.
+		if (size <= SINGLE_FRAME_SIZE_MAX || size > link->config->bufferSize)
+		{
+			link->rxState = CAN_ISO_TP_RX_IDLE;
+			++link->rxErrorCount;
+			transmitFlowControl (link, FLOW_STATUS_OVERFLOW);
+			break;
+		}
+
+		// Abort any message in progress
+		if (link->rxState == CAN_ISO_TP_RX_RECEIVING)
+			++link->rxErrorCount;
+
+		memcpy (link->config->buffer, frame->data8 + headerSize, 8 - headerSize);
+		link->rxSize			= size;
+		link->rxCount			= 8 - headerSize;
+		link->rxSequence		= 1;
+		link->rxBlockRemaining	= link->config->blockSize;
+		link->rxState			= CAN_ISO_TP_RX_RECEIVING;
+
+		// If the flow control frame cannot be sent, the sender will time-out, so abort the message.
+		if (!transmitFlowControl (link, FLOW_STATUS_CONTINUE))
+		{
+			link->rxState = CAN_ISO_TP_RX_IDLE;
+			++link->rxErrorCount;
+		}
+		break;
+	}
+
+	case PCI_CONSECUTIVE_FRAME:
+	{
+		if (link->rxState != CAN_ISO_TP_RX_RECEIVING)
+			break;
+
+		// Abort the message if a frame was lost.
+		if ((frame->data8 [0] & 0x0F) != link->rxSequence)
+		{
+			link->rxState = CAN_ISO_TP_RX_IDLE;
+			++link->rxErrorCount;
+			break;
+		}
+		link->rxSequence = (link->rxSequence + 1) & 0x0F;
+
+		uint16_t count = link->rxSize - link->rxCount;
+		if (count > CONSECUTIVE_FRAME_SIZE)
+			count = CONSECUTIVE_FRAME_SIZE;
+		if (count > frame->DLC - 1)
+		{
+			link->rxState = CAN_ISO_TP_RX_IDLE;
+			++link->rxErrorCount;
+			break;
+		}
+
+		memcpy (link->config->buffer + link->rxCount, frame->data8 + 1, count);
+		link->rxCount += count;
+
+		if (link->rxCount == link->rxSize)
+		{
+			// Message complete, pass it to the link's thread.
+			link->rxState = CAN_ISO_TP_RX_COMPLETE;
+			++link->rxMessageCount;
+			chBSemSignal (&link->rxSemaphore);
+		}
+		else if (link->config->blockSize != 0 && --link->rxBlockRemaining == 0)
+		{
+			// Block complete, allow the sender to continue. If the flow control frame cannot be sent, abort the message.
+			link->rxBlockRemaining = link->config->blockSize;
+			if (!transmitFlowControl (link, FLOW_STATUS_CONTINUE))
+			{
+				link->rxState = CAN_ISO_TP_RX_IDLE;
+				++link->rxErrorCount;
+			}
+		}
+		break;
+	}
+
+	case PCI_FLOW_CONTROL:
+		// Ignore flow control unless a transmission is waiting for it.
+		if (!link->txWaiting || frame->DLC < 3)
+			break;
+
+		link->txFlowStatus		= frame->data8 [0] & 0x0F;
+		link->txBlockSize		= frame->data8 [1];
+		link->txSeparationTime	= frame->data8 [2];
+		chBSemSignal (&link->txSemaphore);
+		break;
+
+	default:
+		break;
+	}
+
+	return true;
+}
+
+bool canIsoTpTransmit (canIsoTpLink_t* link, const uint8_t* data, uint16_t size)
+{
+	uint8_t frame [8];
+
+	// Small messages fit in a single frame.
+	if (size <= SINGLE_FRAME_SIZE_MAX)
+	{
+		frame [0] = (PCI_SINGLE_FRAME << 4) | size;
+		memcpy (frame + 1, data, size);
+		return transmitFrame (link, frame, size + 1);
+	}
+
+	// Accept flow control for the duration of the transmission, discarding any that is stale.
+	chBSemReset (&link->txSemaphore, true);
+	link->txWaiting = true;
+	bool result = transmitSegmented (link, data, size);
+	link->txWaiting = false;
+	return result;
+}
+
+static bool transmitSegmented (canIsoTpLink_t* link, const uint8_t* data, uint16_t size)
+{
+	uint8_t frame [8];
+
+	// First frame
+	uint16_t count;
+	if (size <= FIRST_FRAME_SIZE_MAX)
+	{
+		frame [0] = (PCI_FIRST_FRAME << 4) | (size >> 8);
+		frame [1] = size;
+		count = 6;
+		memcpy (frame + 2, data, count);
+	}
+	else
+	{
+		frame [0] = PCI_FIRST_FRAME << 4;
+		frame [1] = 0;
+		frame [2] = 0;
+		frame [3] = 0;
+		frame [4] = size >> 8;
+		frame [5] = size;
+		count = 2;
+		memcpy (frame + 6, data, count);
+	}
+
+	if (!transmitFrame (link, frame, 8))
+		return false;
+
+	uint8_t sequence = 1;
+	uint8_t waitCount = 0;
+	while (count < size)
+	{
+		// Wait for the receiver's flow control
+		if (chBSemWaitTimeout (&link->txSemaphore, link->config->flowControlTimeout) != MSG_OK)
+			return false;
+
+		// If the receiver is not ready, wait for the next flow control (up to a limit).
+		if (link->txFlowStatus == FLOW_STATUS_WAIT)
+		{
+			if (++waitCount > CAN_ISO_TP_WAIT_COUNT_MAX)
+				return false;
+
+			continue;
+		}
+
+		// Abort if the receiver rejected the message.
+		if (link->txFlowStatus != FLOW_STATUS_CONTINUE)
+			return false;
+
+		waitCount = 0;
+		uint8_t blockSize = link->txBlockSize;
+		sysinterval_t separation = separationTimeToInterval (link->txSeparationTime);
+
+		// Transmit consecutive frames until the block is complete. A block size of 0 means the remainder of the message.
+		for (uint8_t blockCount = 0; count < size && (blockSize == 0 || blockCount < blockSize); ++blockCount)
+		{
+			if (blockCount != 0 && separation != 0)
+				chThdSleep (separation);
+
+			uint16_t frameCount = size - count;
+			if (frameCount > CONSECUTIVE_FRAME_SIZE)
+				frameCount = CONSECUTIVE_FRAME_SIZE;
+
+			frame [0] = (PCI_CONSECUTIVE_FRAME << 4) | sequence;
+			memcpy (frame + 1, data + count, frameCount);
+			sequence = (sequence + 1) & 0x0F;
+
+			if (!transmitFrame (link, frame, frameCount + 1))
+				return false;
+
+			count += frameCount;
+		}
+	}
+
+	return true;
+}
+
+static void buildFrame (canIsoTpLink_t* link, const uint8_t* data, uint8_t size, CANTxFrame* frame)
+{
+	*frame = (CANTxFrame)
+	{
+		.IDE	= canIdIsExtended (link->config->txId) ? CAN_IDE_EXT : CAN_IDE_STD,
+		.RTR	= CAN_RTR_DATA,
+		.DLC	= 8
+	};
+
+	if (canIdIsExtended (link->config->txId))
+		frame->EID = canIdGetValue (link->config->txId);
+	else
+		frame->SID = canIdGetValue (link->config->txId);
+
+	memcpy (frame->data8, data, size);
+	memset (frame->data8 + size, CAN_ISO_TP_PADDING, 8 - size);
+}
+
+static bool transmitFrame (canIsoTpLink_t* link, const uint8_t* data, uint8_t size)
+{
+	CANTxFrame frame;
+	buildFrame (link, data, size, &frame);
+
+	return canTransmitTimeout (link->config->driver, CAN_ANY_MAILBOX, &frame, link->config->transmitTimeout) == MSG_OK;
+}
+
+static bool transmitFlowControl (canIsoTpLink_t* link, uint8_t flowStatus)
+{
+	uint8_t data [3] =
+	{
+		(PCI_FLOW_CONTROL << 4) | flowStatus,
+		link->config->blockSize,
+		link->config->separationTime
+	};
+
+	CANTxFrame frame;
+	buildFrame (link, data, sizeof (data), &frame);
+
+	// Note canTryTransmitI returns true upon failure.
+	chSysLock ();
+	bool failed = canTryTransmitI (link->config->driver, CAN_ANY_MAILBOX, &frame);
+	chSysUnlock ();
+
+	return !failed;
+}
+
+static sysinterval_t separationTimeToInterval (uint8_t separationTime)
+{
+	// 0xF1 to 0xF9 => 100 to 900 us
+	if (separationTime >= 0xF1 && separationTime <= 0xF9)
+		return TIME_US2I ((separationTime - 0xF0) * 100);
+
+	// Reserved values are treated as the maximum (127 ms).
+	if (separationTime > 0x7F)
+		separationTime = 0x7F;
+
+	return TIME_MS2I (separationTime);
+}
\ No newline at end of file
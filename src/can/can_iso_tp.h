@@ -0,0 +1,189 @@
+#ifndef CAN_ISO_TP_H
+#define CAN_ISO_TP_H
+
+// CAN ISO-TP Link ------------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Object implementing the ISO 15765-2 (ISO-TP) transport protocol over a pair of CAN identifiers. ISO-TP
+//   segments messages larger than a single CAN frame into a first frame followed by a series of consecutive frames, with the
+//   receiver pacing the sender through flow control frames (block size and minimum separation time). Messages of up to 4095
+//   bytes use the standard first frame, larger messages use the escaped (32-bit length) first frame.
+//
+//   Reception is performed by a CAN thread: each frame received on the link's identifier should be passed to
+//   @c canIsoTpReceive (typically from the thread's @c rxHandler ), which re-assembles the message and responds with flow
+//   control frames. Flow control frames are transmitted without blocking the CAN thread; if no transmit mailbox is free, the
+//   frame is dropped and the message is aborted (the sender would time-out waiting for it). Once a message is complete, it is
+//   handled by the link's own thread (see @c canIsoTpStart ), which may respond using @c canIsoTpTransmit . As transmission
+//   blocks waiting for flow control frames, it must not be performed from the CAN thread that receives for the link.
+//
+//   Only one message is received at a time. While a message is being handled, any new messages are rejected with an
+//   overflow flow control frame (or discarded, if not segmented). A new first frame aborts any reception in progress.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// Includes
+#include "can_id.h"
+
+// ChibiOS
+#include "hal.h"
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+/// @brief The value used to pad unused bytes of transmitted frames.
+#define CAN_ISO_TP_PADDING 0xCC
+
+/// @brief The maximum number of wait flow control frames accepted before a transmission is aborted.
+#define CAN_ISO_TP_WAIT_COUNT_MAX 8
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+#define CAN_ISO_TP_WORKING_AREA(name) THD_WORKING_AREA (name, 512)
+
+typedef struct canIsoTpLink canIsoTpLink_t;
+
+/**
+ * @brief Function for handling a message received by an ISO-TP link. Invoked from the link's thread.
+ * @param object The object provided by the link's configuration.
+ * @param link The link the message was received by, may be used to transmit a response.
+ * @param data The data of the message. This buffer is owned by the handler until it returns, so it may be re-used to build
+ * the response (up to the link's @c bufferSize ).
+ * @param size The size of the message, in bytes.
+ */
+typedef void (canIsoTpMessageHandler_t) (void* object, canIsoTpLink_t* link, uint8_t* data, uint16_t size);
+
+typedef enum
+{
+	/// @brief No message is being received.
+	CAN_ISO_TP_RX_IDLE		= 0,
+
+	/// @brief A segmented message is being received.
+	CAN_ISO_TP_RX_RECEIVING	= 1,
+
+	/// @brief A message has been received and is waiting to be (or is being) handled.
+	CAN_ISO_TP_RX_COMPLETE	= 2
+} canIsoTpRxState_t;
+
+typedef struct
+{
+	/// @brief Name to give the link's thread, used for debugging.
+	const char* name;
+
+	/// @brief The CAN driver to transmit frames on.
+	CANDriver* driver;
+
+	/// @brief The identifier of frames received by the link (see @c canIdStandard and @c canIdExtended ).
+	canId_t rxId;
+
+	/// @brief The identifier to transmit frames with.
+	canId_t txId;
+
+	/// @brief Buffer to re-assemble received messages into. Determines the maximum size of a received message.
+	uint8_t* buffer;
+
+	/// @brief The size of the @c buffer , in bytes.
+	uint16_t bufferSize;
+
+	/// @brief The number of consecutive frames the sender may transmit before waiting for the next flow control frame. Use 0
+	/// to receive the entire message without further flow control.
+	uint8_t blockSize;
+
+	/// @brief The minimum separation time between consecutive frames requested from the sender, in the ISO-TP encoding: 0x00
+	/// to 0x7F for 0 to 127 ms, 0xF1 to 0xF9 for 100 to 900 us.
+	uint8_t separationTime;
+
+	/// @brief The timeout for transmitting a single frame.
+	sysinterval_t transmitTimeout;
+
+	/// @brief The timeout for receiving a flow control frame while transmitting.
+	sysinterval_t flowControlTimeout;
+
+	/// @brief Handler to invoke upon receiving a complete message.
+	canIsoTpMessageHandler_t* messageHandler;
+
+	/// @brief Object to pass to the @c messageHandler .
+	void* object;
+} canIsoTpConfig_t;
+
+struct canIsoTpLink
+{
+	const canIsoTpConfig_t* config;
+
+	/// @brief The state of the message being received.
+	volatile canIsoTpRxState_t rxState;
+
+	/// @brief The total size of the message being received.
+	uint16_t rxSize;
+
+	/// @brief The number of bytes of the message received so far.
+	uint16_t rxCount;
+
+	/// @brief The expected sequence number of the next consecutive frame.
+	uint8_t rxSequence;
+
+	/// @brief The number of consecutive frames remaining in the current block.
+	uint8_t rxBlockRemaining;
+
+	/// @brief Semaphore signalled upon receiving a complete message.
+	binary_semaphore_t rxSemaphore;
+
+	/// @brief Indicates whether a segmented transmission is in progress, in which case flow control frames are accepted.
+	volatile bool txWaiting;
+
+	/// @brief The flow status of the last received flow control frame.
+	uint8_t txFlowStatus;
+
+	/// @brief The block size of the last received flow control frame.
+	uint8_t txBlockSize;
+
+	/// @brief The separation time of the last received flow control frame.
+	uint8_t txSeparationTime;
+
+	/// @brief Semaphore signalled upon receiving a flow control frame.
+	binary_semaphore_t txSemaphore;
+
+	/// @brief The total number of messages received.
+	uint32_t rxMessageCount;
+
+	/// @brief The total number of messages whose reception was aborted (lost frames, overflows, etc.).
+	uint32_t rxErrorCount;
+};
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes an ISO-TP link using the specified configuration.
+ * @param link The link to initialize.
+ * @param config The configuration to use.
+ */
+void canIsoTpInit (canIsoTpLink_t* link, const canIsoTpConfig_t* config);
+
+/**
+ * @brief Starts the thread handling the messages received by a link.
+ * @param link The link to start, must be initialized.
+ * @param workingArea The working area to provide the thread. Should be instanced using the @c CAN_ISO_TP_WORKING_AREA macro.
+ * @param workingAreaSize The size of the thread's @c workingArea . Should be obtained using @c sizeof(workingArea) .
+ * @param priority The priority to assign the thread.
+ */
+void canIsoTpStart (canIsoTpLink_t* link, void* workingArea, size_t workingAreaSize, tprio_t priority);
+
+/**
+ * @brief Handles a CAN frame potentially belonging to a link. Should be called by the CAN thread receiving the link's frames.
+ * @param link The link to receive for.
+ * @param frame The frame that was received.
+ * @return True if the frame belongs to the link, false otherwise.
+ */
+bool canIsoTpReceive (canIsoTpLink_t* link, CANRxFrame* frame);
+
+/**
+ * @brief Transmits a message on a link, segmenting it if necessary. Blocks until the message has been transmitted.
+ * @note This must not be called from the CAN thread receiving the link's frames, as it blocks waiting for flow control.
+ * @param link The link to transmit on.
+ * @param data The data of the message.
+ * @param size The size of the message, in bytes.
+ * @return True if successful, false if a frame could not be transmitted or the receiver aborted the transmission.
+ */
+bool canIsoTpTransmit (canIsoTpLink_t* link, const uint8_t* data, uint16_t size);
+
+#endif // CAN_ISO_TP_H
\ No newline at end of file
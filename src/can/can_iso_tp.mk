@@ -0,0 +1,9 @@
+ifndef CAN_ISO_TP_MK
+define CAN_ISO_TP_MK
+1
+endef
+
+# Add the module's source file to the compilation
+CSRC += common/src/can/can_iso_tp.c
+
+endif # CAN_ISO_TP_MK
\ No newline at end of file
@@ -0,0 +1,116 @@
+// Header
+#include "can_monitor.h"
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+/// @brief The maximum number of polls to wait for the peripheral to enter initialization mode.
+#define INIT_POLL_COUNT 1000
+
+// Function Prototypes --------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Restarts a bus-off peripheral, by entering and leaving initialization mode. Once restarted, the peripheral rejoins
+ * the bus after detecting 128 occurrences of 11 recessive bits.
+ * @param driver The driver of the peripheral.
+ */
+static void recover (CANDriver* driver);
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+void canMonitorInit (canMonitor_t* monitor, const canMonitorConfig_t* config)
+{
+	monitor->config				= config;
+	monitor->state				= CAN_MONITOR_ERROR_ACTIVE;
+	monitor->transmitErrorCount	= 0;
+	monitor->receiveErrorCount	= 0;
+	monitor->lastErrorCode		= 0;
+	monitor->recoveryCount		= 0;
+	monitor->recoveryDelay		= config->recoveryDelayMin;
+	monitor->sampleTime			= chVTGetSystemTimeX ();
+	monitor->recoveryTime		= monitor->sampleTime;
+
+	// The period is used as the CAN thread's receive timeout, so a period of 0 (TIME_IMMEDIATE) would make the thread spin.
+	monitor->period = config->period != 0 ? config->period : 1;
+
+	for (uint8_t index = 0; index < CAN_MONITOR_STATE_COUNT; ++index)
+	{
+		monitor->stateCounts [index]	= 0;
+		monitor->stateTimes [index]		= monitor->sampleTime;
+	}
+}
+
+sysinterval_t canMonitorSample (canMonitor_t* monitor, systime_t timeCurrent)
+{
+	const canMonitorConfig_t* config = monitor->config;
+
+	// Only sample once per period.
+	sysinterval_t elapsed = chTimeDiffX (monitor->sampleTime, timeCurrent);
+	if (elapsed < monitor->period)
+		return monitor->period - elapsed;
+	monitor->sampleTime = timeCurrent;
+
+	// Sample the error status register
+	uint32_t esr = config->driver->can->ESR;
+	monitor->transmitErrorCount	= (esr & CAN_ESR_TEC_Msk) >> CAN_ESR_TEC_Pos;
+	monitor->receiveErrorCount	= (esr & CAN_ESR_REC_Msk) >> CAN_ESR_REC_Pos;
+	monitor->lastErrorCode		= (esr & CAN_ESR_LEC_Msk) >> CAN_ESR_LEC_Pos;
+
+	canMonitorState_t state = CAN_MONITOR_ERROR_ACTIVE;
+	if (esr & CAN_ESR_BOFF)
+		state = CAN_MONITOR_BUS_OFF;
+	else if (esr & CAN_ESR_EPVF)
+		state = CAN_MONITOR_ERROR_PASSIVE;
+	else if (esr & CAN_ESR_EWGF)
+		state = CAN_MONITOR_ERROR_WARNING;
+
+	// Record any transition
+	if (state != monitor->state)
+	{
+		monitor->state = state;
+		++monitor->stateCounts [state];
+		monitor->stateTimes [state] = timeCurrent;
+
+		// The recovery delay starts upon entering bus-off.
+		if (state == CAN_MONITOR_BUS_OFF)
+			monitor->recoveryTime = timeCurrent;
+	}
+
+	if (!config->autoRecovery)
+		return monitor->period;
+
+	if (state == CAN_MONITOR_BUS_OFF)
+	{
+		// Recover once the delay has passed, then back off the delay for the next attempt.
+		if (chTimeDiffX (monitor->recoveryTime, timeCurrent) >= monitor->recoveryDelay)
+		{
+			recover (config->driver);
+			++monitor->recoveryCount;
+
+			// Restart the delay for the next attempt, in case the peripheral re-enters bus-off without leaving it.
+			monitor->recoveryTime = timeCurrent;
+
+			monitor->recoveryDelay *= 2;
+			if (monitor->recoveryDelay > config->recoveryDelayMax)
+				monitor->recoveryDelay = config->recoveryDelayMax;
+		}
+	}
+	else if (state == CAN_MONITOR_ERROR_ACTIVE &&
+		chTimeDiffX (monitor->stateTimes [CAN_MONITOR_ERROR_ACTIVE], timeCurrent) >= config->recoveryDelayMax)
+	{
+		// The bus has been healthy for long enough, reset the delay.
+		monitor->recoveryDelay = config->recoveryDelayMin;
+	}
+
+	return monitor->period;
+}
+
+static void recover (CANDriver* driver)
+{
+	// Request initialization mode, the peripheral acknowledges once any activity has ceased. In bus-off, this is immediate.
+	driver->can->MCR |= CAN_MCR_INRQ;
+	for (uint16_t poll = 0; poll < INIT_POLL_COUNT && (driver->can->MSR & CAN_MSR_INAK) == 0; ++poll);
+
+	// Leave initialization mode. Don't wait for the acknowledgement, as the peripheral must first observe the bus idle, which
+	// won't occur if the fault persists.
+	driver->can->MCR &= ~CAN_MCR_INRQ;
+}
\ No newline at end of file
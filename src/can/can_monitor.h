@@ -0,0 +1,125 @@
+#ifndef CAN_MONITOR_H
+#define CAN_MONITOR_H
+
+// CAN Bus Monitor ------------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Object for monitoring the error state of a bxCAN peripheral. The monitor periodically samples the peripheral's
+//   error status register (ESR), tracking the transmit and receive error counters and the transitions between the CAN error
+//   states (error active, error warning, error passive, and bus-off). This allows a bus fault (ex. a damaged harness) to be
+//   diagnosed, rather than only observing each node timing-out.
+//
+//   Optionally, the monitor recovers the peripheral from bus-off automatically. After entering bus-off, the monitor waits for
+//   a recovery delay before restarting the peripheral. The delay doubles upon each consecutive bus-off (up to a maximum), so
+//   a persistent fault does not flood the bus with error frames. The delay is reset once the bus has remained error-free for
+//   the maximum delay. Note that automatic recovery requires the peripheral's own automatic bus-off management to be disabled
+//   (the @c CAN_MCR_ABOM bit of the driver's configuration must be clear), otherwise the peripheral recovers immediately.
+//
+//   A monitor is sampled by the CAN thread receiving from its driver (see @c canThreadConfig_t ). The monitor's fields may be
+//   read by any thread, but are only written by the CAN thread.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// ChibiOS
+#include "hal.h"
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+typedef enum
+{
+	/// @brief Both error counters are below the warning limit (96).
+	CAN_MONITOR_ERROR_ACTIVE	= 0,
+
+	/// @brief An error counter has reached the warning limit (96).
+	CAN_MONITOR_ERROR_WARNING	= 1,
+
+	/// @brief An error counter has exceeded the error passive limit (127). The peripheral may no longer transmit active error
+	/// frames.
+	CAN_MONITOR_ERROR_PASSIVE	= 2,
+
+	/// @brief The transmit error counter has exceeded 255. The peripheral is disconnected from the bus.
+	CAN_MONITOR_BUS_OFF			= 3
+} canMonitorState_t;
+
+/// @brief The number of states in @c canMonitorState_t .
+#define CAN_MONITOR_STATE_COUNT 4
+
+typedef struct
+{
+	/// @brief The CAN driver to monitor.
+	CANDriver* driver;
+
+	/// @brief The interval to sample the error status register at. Must not be 0, a period of 0 is treated as 1 tick.
+	sysinterval_t period;
+
+	/// @brief Indicates whether to recover from bus-off automatically.
+	bool autoRecovery;
+
+	/// @brief The delay between entering bus-off and the first recovery attempt.
+	sysinterval_t recoveryDelayMin;
+
+	/// @brief The maximum delay between entering bus-off and a recovery attempt.
+	sysinterval_t recoveryDelayMax;
+} canMonitorConfig_t;
+
+typedef struct
+{
+	const canMonitorConfig_t* config;
+
+	/// @brief The interval to sample the error status register at, the configured period clamped to at least 1 tick.
+	sysinterval_t period;
+
+	/// @brief The current error state of the peripheral.
+	canMonitorState_t state;
+
+	/// @brief The transmit error counter, as of the last sample.
+	uint8_t transmitErrorCount;
+
+	/// @brief The receive error counter, as of the last sample.
+	uint8_t receiveErrorCount;
+
+	/// @brief The last error code (LEC field of the ESR), as of the last sample. 0 => No error, 1 => Stuff error,
+	/// 2 => Form error, 3 => Acknowledgment error, 4 => Bit recessive error, 5 => Bit dominant error, 6 => CRC error.
+	uint8_t lastErrorCode;
+
+	/// @brief The number of times each state has been entered, indexed by state.
+	uint32_t stateCounts [CAN_MONITOR_STATE_COUNT];
+
+	/// @brief The time each state was last entered at, indexed by state.
+	systime_t stateTimes [CAN_MONITOR_STATE_COUNT];
+
+	/// @brief The number of recovery attempts performed.
+	uint32_t recoveryCount;
+
+	/// @brief The delay before the next recovery attempt.
+	sysinterval_t recoveryDelay;
+
+	/// @brief The time the recovery delay started at, that is the time bus-off was entered at or the time of the last recovery
+	/// attempt, whichever is later.
+	systime_t recoveryTime;
+
+	/// @brief The time of the last sample.
+	systime_t sampleTime;
+} canMonitor_t;
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes a monitor using the specified configuration.
+ * @param monitor The monitor to initialize.
+ * @param config The configuration to use.
+ */
+void canMonitorInit (canMonitor_t* monitor, const canMonitorConfig_t* config);
+
+/**
+ * @brief Samples the error status of a monitor's peripheral, updating its state and performing any required recovery. Should
+ * be called periodically by the thread receiving from the monitor's driver.
+ * @param monitor The monitor to sample.
+ * @param timeCurrent The current system time.
+ * @return The interval until the monitor should next be sampled.
+ */
+sysinterval_t canMonitorSample (canMonitor_t* monitor, systime_t timeCurrent);
+
+#endif // CAN_MONITOR_H
\ No newline at end of file
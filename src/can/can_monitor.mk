@@ -0,0 +1,9 @@
+ifndef CAN_MONITOR_MK
+define CAN_MONITOR_MK
+1
+endef
+
+# Add the module's source file to the compilation
+CSRC += common/src/can/can_monitor.c
+
+endif # CAN_MONITOR_MK
\ No newline at end of file
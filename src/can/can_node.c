@@ -1,10 +1,49 @@
 // Header
 #include "can_node.h"
 
+// C Standard Library
+#include <string.h>
+
+#if CAN_NODE_USE_INSTRUMENTATION
+// Includes
+#include "debug.h"
+#endif // CAN_NODE_USE_INSTRUMENTATION
+
 // Function Prototypes --------------------------------------------------------------------------------------------------------
 
 void canNodeResetTimeout (canNode_t* node);
 
+#if CAN_NODE_USE_INSTRUMENTATION
+
+/**
+ * @brief Records the reception of a message by a CAN node.
+ * @param node The node that received the message.
+ * @param index The index of the received message.
+ * @param cyclesStart The value of the cycle counter before the node's receive handler was called.
+ * @param cyclesEnd The value of the cycle counter after the node's receive handler returned.
+ */
+static void recordReceive (canNode_t* node, uint8_t index, uint32_t cyclesStart, uint32_t cyclesEnd);
+
+#endif // CAN_NODE_USE_INSTRUMENTATION
+
+/**
+ * @brief Clears the flag of each of a node's messages that has not been received within its timeout period.
+ * @param node The node to check, must use per-message timeout periods.
+ * @param timeCurrent The current system time.
+ * @return The interval until the next message may expire. Note this is no longer than the shortest timeout period of any
+ * message, such that messages received after this check cannot expire before the next check.
+ */
+static sysinterval_t checkMessageTimeouts (canNode_t* node, systime_t timeCurrent);
+
+/**
+ * @brief Gets the next time a node's timeout should be checked at.
+ * @param timeCurrent The current system time.
+ * @param interval The interval until the next check. Clamped to at least 1 tick, such that a node with a timeout period of 0
+ * cannot be re-checked indefinitely within a single call to @c canNodeTimeoutQueueCheck .
+ * @return The time of the next check.
+ */
+static inline systime_t nextCheckTime (systime_t timeCurrent, sysinterval_t interval);
+
 // Functions ------------------------------------------------------------------------------------------------------------------
 
 void canNodeInit (canNode_t* node, const canNodeConfig_t* config)
@@ -13,17 +52,38 @@ void canNodeInit (canNode_t* node, const canNodeConfig_t* config)
 	// - Note, as most nodes use a temporary configuration, we cannot store a pointer to the config.
 	node->driver			= config->driver;
 	node->receiveHandler	= config->receiveHandler;
+	node->timeoutHandler	= config->timeoutHandler;
+	node->idHandler			= config->idHandler;
 	node->timeoutPeriod		= config->timeoutPeriod;
+	node->messageCount		= config->messageCount;
 
 	// Reset the message flags
 	node->messageFlags = 0;
 
 	// Calculate the messsage flags that indicate validity.
-	node->validFlags = ((1 << config->messageCount) - 1);
+	node->validFlags = config->messageCount >= 64 ? UINT64_MAX : (((uint64_t) 1 << config->messageCount) - 1);
+
+	// Per-message timeouts can only be used if each message has a receive time.
+	node->messageTimeoutPeriods = config->messageCount <= CAN_NODE_MESSAGE_COUNT_MAX ? config->messageTimeoutPeriods : NULL;
+	for (uint8_t index = 0; index < CAN_NODE_MESSAGE_COUNT_MAX; ++index)
+		node->receiveTimes [index] = 0;
 
-	// Initialize the mutex
+	// Initialize the mutex and sequence counter
+	node->sequence = 0;
 	chMtxObjectInit (&node->mutex);
 
+#if CAN_NODE_USE_EVENTS
+	chEvtObjectInit (&node->eventSource);
+#endif // CAN_NODE_USE_EVENTS
+
+#if CAN_NODE_USE_INSTRUMENTATION
+	// Enable the DWT cycle counter, used for timing the receive handler.
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	canNodeResetStats (node);
+#endif // CAN_NODE_USE_INSTRUMENTATION
+
 	// Reset the timeout condition
 	canNodeResetTimeout (node);
 }
@@ -34,51 +94,102 @@ bool canNodeReceive (canNode_t* node, CANRxFrame* frame)
 	canNodeLock (node);
 
 	// Call the receive handler, exit early if the message is not from this node.
+#if CAN_NODE_USE_INSTRUMENTATION
+	uint32_t cyclesStart = DWT->CYCCNT;
+	int8_t result = node->receiveHandler (node, frame);
+	uint32_t cyclesEnd = DWT->CYCCNT;
+#else
 	int8_t result = node->receiveHandler (node, frame);
+#endif // CAN_NODE_USE_INSTRUMENTATION
 	if (result < 0)
 	{
 		canNodeUnlock (node);
 		return false;
 	}
 
+#if CAN_NODE_USE_INSTRUMENTATION
+	recordReceive (node, (uint8_t) result, cyclesStart, cyclesEnd);
+#endif // CAN_NODE_USE_INSTRUMENTATION
+
 	// Reset the timeout.
 	canNodeResetTimeout (node);
 
 	// Mark this message as received.
 	uint8_t index = (uint8_t) result;
-	node->messageFlags |= (1 << index);
+	node->messageFlags |= (uint64_t) 1 << index;
+	if (index < CAN_NODE_MESSAGE_COUNT_MAX)
+		node->receiveTimes [index] = chVTGetSystemTimeX ();
 
 	// If all messages have been received, mark the node as valid.
 	if (node->messageFlags == node->validFlags)
 		node->state = CAN_NODE_VALID;
 
-	// Release the node and return
+	// Release the node
 	canNodeUnlock (node);
+
+#if CAN_NODE_USE_EVENTS
+	// Notify any listeners, after unlocking such that they may immediately access the node.
+	chEvtBroadcastFlags (&node->eventSource, CAN_NODE_EVENT_MESSAGE (index));
+#endif // CAN_NODE_USE_EVENTS
+
 	return true;
 }
 
-void canNodeCheckTimeout (canNode_t* node, systime_t timePrevious, systime_t timeCurrent)
+systime_t canNodeCheckTimeout (canNode_t* node, systime_t timePrevious, systime_t timeCurrent)
 {
 	// Lock the node to prevent access during modification.
 	canNodeLock (node);
 
+	// Check the freshness of each message (if enabled).
+	sysinterval_t interval = node->timeoutPeriod;
+	uint64_t messageFlags = node->messageFlags;
+	if (node->messageTimeoutPeriods != NULL)
+		interval = checkMessageTimeouts (node, timeCurrent);
+
 	// Skip this check if the node is already timed-out.
 	if (node->state == CAN_NODE_TIMEOUT)
 	{
 		canNodeUnlock (node);
-		return;
+		return nextCheckTime (timeCurrent, interval);
+	}
+
+	// Check the timeout deadline. If not expired, update the state based on which messages are still fresh.
+	bool expired = !chTimeIsInRangeX (timeCurrent, timePrevious, node->timeoutDeadline);
+	if (!expired && node->messageFlags != messageFlags)
+	{
+		// If every message has expired, the node has timed-out, otherwise it is incomplete.
+		expired = node->messageFlags == 0;
+		node->state = CAN_NODE_INCOMPLETE;
 	}
 
-	// Check the timeout deadline, exit early if not expired.
-	if (chTimeIsInRangeX (timeCurrent, timePrevious, node->timeoutDeadline))
+	// Exit early if not expired.
+	if (!expired)
 	{
+		sysinterval_t deadlineInterval = chTimeDiffX (timeCurrent, node->timeoutDeadline);
+		if (deadlineInterval < interval)
+			interval = deadlineInterval;
+
+#if CAN_NODE_USE_EVENTS
+		bool stale = node->messageFlags != messageFlags;
 		canNodeUnlock (node);
-		return;
+
+		// Notify any listeners if a message became stale.
+		if (stale)
+			chEvtBroadcastFlags (&node->eventSource, CAN_NODE_EVENT_STALE);
+#else
+		canNodeUnlock (node);
+#endif // CAN_NODE_USE_EVENTS
+
+		return nextCheckTime (timeCurrent, interval);
 	}
 
 	// Enter the timeout state
 	node->state = CAN_NODE_TIMEOUT;
 
+#if CAN_NODE_USE_INSTRUMENTATION
+	++node->stats.timeoutCount;
+#endif // CAN_NODE_USE_INSTRUMENTATION
+
 	// Reset the validity flags
 	node->messageFlags = 0;
 
@@ -88,15 +199,170 @@ void canNodeCheckTimeout (canNode_t* node, systime_t timePrevious, systime_t tim
 
 	// Release the node.
 	canNodeUnlock (node);
+
+#if CAN_NODE_USE_EVENTS
+	chEvtBroadcastFlags (&node->eventSource, CAN_NODE_EVENT_TIMEOUT);
+#endif // CAN_NODE_USE_EVENTS
+
+	return nextCheckTime (timeCurrent, interval);
+}
+
+static inline systime_t nextCheckTime (systime_t timeCurrent, sysinterval_t interval)
+{
+	return chTimeAddX (timeCurrent, interval > 0 ? interval : 1);
+}
+
+#if CAN_NODE_USE_INSTRUMENTATION
+
+static void recordReceive (canNode_t* node, uint8_t index, uint32_t cyclesStart, uint32_t cyclesEnd)
+{
+	if (index >= CAN_NODE_MESSAGE_COUNT_MAX)
+		return;
+
+	canNodeMessageStats_t* stats = &node->stats.messages [index];
+
+	// Handler execution time. Note unsigned subtraction handles the counter overflowing.
+	uint32_t cycles = cyclesEnd - cyclesStart;
+	if (stats->count == 0 || cycles < stats->cyclesMin)
+		stats->cyclesMin = cycles;
+	if (cycles > stats->cyclesMax)
+		stats->cyclesMax = cycles;
+	stats->cyclesSum += cycles;
+
+	// Inter-arrival time, only valid after the first reception. Note the cycle counter overflows roughly every 25 seconds, so
+	// longer intervals are not measured correctly.
+	if (stats->count != 0)
+	{
+		uint32_t interval = (cyclesStart - stats->cyclesPrevious) / (STM32_SYSCLK / 1000000);
+
+		// Bin is the number of bits required to represent the interval.
+		uint8_t bin = interval == 0 ? 0 : 32 - __builtin_clz (interval);
+		if (bin >= CAN_NODE_HISTOGRAM_SIZE)
+			bin = CAN_NODE_HISTOGRAM_SIZE - 1;
+		++stats->histogram [bin];
+	}
+	stats->cyclesPrevious = cyclesStart;
+
+	++stats->count;
+}
+
+void canNodeResetStats (canNode_t* node)
+{
+	canNodeLock (node);
+	memset (&node->stats, 0, sizeof (node->stats));
+	canNodeUnlock (node);
+}
+
+void canNodePrintStats (canNode_t* node, const char* name)
+{
+	// Copy the statistics, such that the node is not locked while printing. Static as this is too large for most stacks.
+	static canNodeStats_t stats;
+	canNodeLock (node);
+	stats = node->stats;
+	uint8_t messageCount = node->messageCount;
+	canNodeUnlock (node);
+
+	if (messageCount > CAN_NODE_MESSAGE_COUNT_MAX)
+		messageCount = CAN_NODE_MESSAGE_COUNT_MAX;
+
+	debugPrintf ("CAN node '%s': %lu timeouts\r\n", name, stats.timeoutCount);
+	for (uint8_t index = 0; index < messageCount; ++index)
+	{
+		canNodeMessageStats_t* message = &stats.messages [index];
+		uint32_t cyclesAverage = message->count == 0 ? 0 : (uint32_t) (message->cyclesSum / message->count);
+
+		debugPrintf ("  Message %u: %lu received, handler cycles min / avg / max: %lu / %lu / %lu\r\n", index, message->count,
+			message->cyclesMin, cyclesAverage, message->cyclesMax);
+
+		debugPrintf ("    Inter-arrival histogram (us):");
+		for (uint8_t bin = 0; bin < CAN_NODE_HISTOGRAM_SIZE; ++bin)
+		{
+			if (message->histogram [bin] == 0)
+				continue;
+
+			if (bin == CAN_NODE_HISTOGRAM_SIZE - 1)
+				debugPrintf (" >=%lu: %lu", (uint32_t) 1 << (bin - 1), message->histogram [bin]);
+			else
+				debugPrintf (" <%lu: %lu", (uint32_t) 1 << bin, message->histogram [bin]);
+		}
+		debugPrintf ("\r\n");
+	}
+}
+
+#endif // CAN_NODE_USE_INSTRUMENTATION
+
+static sysinterval_t checkMessageTimeouts (canNode_t* node, systime_t timeCurrent)
+{
+	uint64_t staleFlags = 0;
+	sysinterval_t interval = node->timeoutPeriod;
+
+	for (uint8_t index = 0; index < node->messageCount; ++index)
+	{
+		sysinterval_t period = node->messageTimeoutPeriods [index];
+		if (period == 0)
+			period = node->timeoutPeriod;
+
+		// A message received after this check expires no sooner than its period from now.
+		if (period < interval)
+			interval = period;
+
+		// Skip messages that are already stale.
+		uint64_t flag = (uint64_t) 1 << index;
+		if ((node->messageFlags & flag) == 0)
+			continue;
+
+		sysinterval_t elapsed = chTimeDiffX (node->receiveTimes [index], timeCurrent);
+		if (elapsed >= period)
+			staleFlags |= flag;
+		else if (period - elapsed < interval)
+			interval = period - elapsed;
+	}
+
+	node->messageFlags &= ~staleFlags;
+	return interval;
 }
 
 void canNodeLock (canNode_t* node)
 {
 	chMtxLock (&node->mutex);
+
+	// Mark the node as being modified (odd sequence). The barrier prevents modifications from being re-ordered before this.
+	++node->sequence;
+	__DMB ();
 }
 
 void canNodeUnlock (canNode_t* node)
 {
+	// Mark the node as no longer being modified (even sequence). The barrier prevents modifications from being re-ordered
+	// after this.
+	__DMB ();
+	++node->sequence;
+
+	chMtxUnlock (&node->mutex);
+}
+
+void canNodeCopy (canNode_t* node, void* snapshot, size_t size)
+{
+	for (uint8_t attempt = 0; attempt < CAN_NODE_SNAPSHOT_ATTEMPTS; ++attempt)
+	{
+		// If the node is being modified, retry.
+		uint32_t sequence = node->sequence;
+		if ((sequence & 0b1) == 0b1)
+			continue;
+
+		__DMB ();
+		memcpy (snapshot, node, size);
+		__DMB ();
+
+		// If the node was not modified during the copy, the snapshot is consistent.
+		if (node->sequence == sequence)
+			return;
+	}
+
+	// Otherwise, the writer may have been pre-empted by this thread. Locking the node will block until the writer finishes
+	// (the writer inherits this thread's priority, if higher). Note the sequence counter is not modified, as the node is not.
+	chMtxLock (&node->mutex);
+	memcpy (snapshot, node, size);
 	chMtxUnlock (&node->mutex);
 }
 
@@ -123,4 +389,213 @@ void canNodesCheckTimeout (canNode_t** nodes, uint8_t nodeCount, systime_t timeP
 {
 	for (uint8_t index = 0; index < nodeCount; ++index)
 		canNodeCheckTimeout (nodes [index], timePrevious, timeCurrent);
+}
+
+int16_t canNodesGetIds (canNode_t** nodes, uint16_t nodeCount, canId_t* ids, uint16_t idCount)
+{
+	uint16_t count = 0;
+
+	for (uint16_t nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+	{
+		canNode_t* node = nodes [nodeIndex];
+		if (node->idHandler == NULL)
+			return -1;
+
+		for (uint8_t messageIndex = 0; messageIndex < node->messageCount; ++messageIndex)
+		{
+			if (count >= idCount)
+				return -1;
+
+			ids [count] = node->idHandler (node, messageIndex);
+			++count;
+		}
+	}
+
+	return count;
+}
+
+/**
+ * @brief Checks whether one deadline of a timeout queue is before another.
+ */
+static inline bool timeoutQueueBefore (canNodeTimeoutQueue_t* queue, systime_t a, systime_t b)
+{
+	return chTimeDiffX (queue->reference, a) < chTimeDiffX (queue->reference, b);
+}
+
+/**
+ * @brief Swaps two entries of a timeout queue.
+ */
+static inline void timeoutQueueSwap (canNodeTimeoutQueue_t* queue, uint16_t a, uint16_t b)
+{
+	systime_t deadline = queue->deadlines [a];
+	queue->deadlines [a] = queue->deadlines [b];
+	queue->deadlines [b] = deadline;
+
+	uint8_t nodeIndex = queue->nodeIndices [a];
+	queue->nodeIndices [a] = queue->nodeIndices [b];
+	queue->nodeIndices [b] = nodeIndex;
+}
+
+/**
+ * @brief Moves an entry of a timeout queue towards the end of the queue until the heap property is restored.
+ */
+static void timeoutQueueSiftDown (canNodeTimeoutQueue_t* queue, uint16_t index)
+{
+	while (true)
+	{
+		uint16_t earliest = index;
+		uint16_t left = 2 * index + 1;
+		uint16_t right = 2 * index + 2;
+
+		if (left < queue->count && timeoutQueueBefore (queue, queue->deadlines [left], queue->deadlines [earliest]))
+			earliest = left;
+		if (right < queue->count && timeoutQueueBefore (queue, queue->deadlines [right], queue->deadlines [earliest]))
+			earliest = right;
+
+		if (earliest == index)
+			return;
+
+		timeoutQueueSwap (queue, index, earliest);
+		index = earliest;
+	}
+}
+
+bool canNodeTimeoutQueueInit (canNodeTimeoutQueue_t* queue, canNode_t** nodes, uint16_t nodeCount, systime_t timeCurrent)
+{
+	queue->nodes		= nodes;
+	queue->count		= 0;
+	queue->reference	= timeCurrent;
+	queue->valid		= nodeCount <= CAN_NODE_TIMEOUT_QUEUE_SIZE;
+
+	for (uint16_t index = 0; index < nodeCount; ++index)
+	{
+		canNode_t* node = nodes [index];
+
+		// Restart the node's timeout deadline.
+		canNodeLock (node);
+		node->timeoutDeadline = chTimeAddX (timeCurrent, node->timeoutPeriod);
+		systime_t deadline = node->timeoutDeadline;
+		canNodeUnlock (node);
+
+		if (!queue->valid)
+			continue;
+
+		// Inserting in any order, the heap is built afterwards.
+		queue->deadlines [index]	= deadline;
+		queue->nodeIndices [index]	= index;
+		++queue->count;
+	}
+
+	// Build the heap.
+	for (uint16_t index = queue->count / 2; index > 0; --index)
+		timeoutQueueSiftDown (queue, index - 1);
+
+	return queue->valid;
+}
+
+sysinterval_t canNodeTimeoutQueueCheck (canNodeTimeoutQueue_t* queue, systime_t timeCurrent)
+{
+	if (queue->count == 0)
+		return TIME_INFINITE;
+
+	// Check each node whose deadline has expired. Stop at the first deadline that has not.
+	sysinterval_t elapsed = chTimeDiffX (queue->reference, timeCurrent);
+	while (chTimeDiffX (queue->reference, queue->deadlines [0]) <= elapsed)
+	{
+		// Check the node, then re-insert it using its next deadline. Note the check may find the node has not actually expired,
+		// as its deadline may have been postponed since it was inserted.
+		canNode_t* node = queue->nodes [queue->nodeIndices [0]];
+		queue->deadlines [0] = canNodeCheckTimeout (node, queue->reference, timeCurrent);
+		timeoutQueueSiftDown (queue, 0);
+	}
+
+	// All remaining deadlines are after the current time, so they can now be compared relative to it.
+	queue->reference = timeCurrent;
+
+	return chTimeDiffX (timeCurrent, queue->deadlines [0]);
+}
+
+bool canNodeIndexInit (canNodeIndex_t* index, canNode_t** nodes, uint16_t nodeCount)
+{
+	index->nodes			= nodes;
+	index->nodeCount		= nodeCount;
+	index->entryCount		= 0;
+	index->fallbackCount	= 0;
+	index->valid			= false;
+
+	for (uint16_t nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+	{
+		canNode_t* node = nodes [nodeIndex];
+
+		// Nodes that cannot identify their messages must be checked in turn.
+		if (node->idHandler == NULL)
+		{
+			if (index->fallbackCount >= CAN_NODE_INDEX_FALLBACK_SIZE)
+				return false;
+
+			index->fallbackIndices [index->fallbackCount] = nodeIndex;
+			++index->fallbackCount;
+			continue;
+		}
+
+		for (uint8_t messageIndex = 0; messageIndex < node->messageCount; ++messageIndex)
+		{
+			if (index->entryCount >= CAN_NODE_INDEX_SIZE)
+				return false;
+
+			canNodeIndexEntry_t entry =
+			{
+				.id				= node->idHandler (node, messageIndex),
+				.nodeIndex		= nodeIndex,
+				.messageIndex	= messageIndex
+			};
+
+			// Insertion sort by identifier. As nodes are inserted in order, entries with equal identifiers remain sorted by
+			// node index, preserving the priority of a linear scan.
+			uint16_t position = index->entryCount;
+			while (position > 0 && index->entries [position - 1].id > entry.id)
+			{
+				index->entries [position] = index->entries [position - 1];
+				--position;
+			}
+			index->entries [position] = entry;
+			++index->entryCount;
+		}
+	}
+
+	index->valid = true;
+	return true;
+}
+
+bool canNodeIndexReceive (canNodeIndex_t* index, CANRxFrame* frame)
+{
+	// If the index could not be built, check every node.
+	if (!index->valid)
+		return canNodesReceive (index->nodes, index->nodeCount, frame);
+
+	canId_t id = canIdFromFrame (frame);
+
+	// Binary search for the first entry with a matching identifier.
+	uint16_t lower = 0;
+	uint16_t upper = index->entryCount;
+	while (lower < upper)
+	{
+		uint16_t middle = lower + (upper - lower) / 2;
+		if (index->entries [middle].id < id)
+			lower = middle + 1;
+		else
+			upper = middle;
+	}
+
+	// Offer the message to each node that owns the identifier. Typically this is only 1 node.
+	for (; lower < index->entryCount && index->entries [lower].id == id; ++lower)
+		if (canNodeReceive (index->nodes [index->entries [lower].nodeIndex], frame))
+			return true;
+
+	// Otherwise, check the nodes that could not be indexed.
+	for (uint16_t fallbackIndex = 0; fallbackIndex < index->fallbackCount; ++fallbackIndex)
+		if (canNodeReceive (index->nodes [index->fallbackIndices [fallbackIndex]], frame))
+			return true;
+
+	return false;
 }
\ No newline at end of file
@@ -8,13 +8,81 @@
 //
 // Description: Base object representing a node in a CAN bus. This object provides a standard interface for an object that
 //   broadcasts periodic CAN messages.
+//
+//   A node times-out if none of its messages are received within its timeout period. Optionally, each message may also have
+//   its own timeout period, in which case a message that stops arriving is marked as stale (making the node incomplete) even
+//   while the node's other messages continue to arrive. The time each message was last received is recorded regardless.
+//
+//   Access to a node is guarded by its mutex, see @c canNodeLock and @c canNodeUnlock . Additionally, each node has a
+//   sequence counter that is incremented upon both locking and unlocking the node. This allows a thread to take a consistent
+//   copy of a node without blocking the writer (see @c canNodeGetSnapshot ). A copy is consistent if the counter was even
+//   (unlocked) before the copy and unchanged after it, otherwise the copy is retried.
+//
+//   If @c CAN_NODE_USE_INSTRUMENTATION is enabled, each node additionally records statistics about the messages it receives
+//   (see @c canNodeStats_t ), which can be printed using @c canNodePrintStats .
+//
+//   If @c CAN_NODE_USE_EVENTS is enabled, each node additionally has an event source (see @c canNodeGetEventSource ), which
+//   is broadcast upon receiving a message and upon timing-out. This allows consumers of a node's data to wait for the data to
+//   be updated, rather than polling the node. The event flags identify which messages were received (see
+//   @c CAN_NODE_EVENT_MESSAGE ), so a listener may be registered for specific messages only. For example, to wait for the
+//   feedback of 2 nodes:
+//
+//     chEvtRegisterMaskWithFlags (canNodeGetEventSource (&nodeA), &listenerA, EVENT_MASK (0), CAN_NODE_EVENT_MESSAGE (0));
+//     chEvtRegisterMaskWithFlags (canNodeGetEventSource (&nodeB), &listenerB, EVENT_MASK (1), CAN_NODE_EVENT_MESSAGE (0));
+//     eventmask_t events = chEvtWaitAllTimeout (EVENT_MASK (0) | EVENT_MASK (1), TIME_MS2I (10));
 
 // Includes -------------------------------------------------------------------------------------------------------------------
 
+// Includes
+#include "can_id.h"
+
 // ChibiOS
 #include "ch.h"
 #include "hal.h"
 
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+#ifndef CAN_NODE_USE_INSTRUMENTATION
+/// @brief Enables the recording of receive statistics by each CAN node. Note this requires the debug module (debug.mk) to be
+/// included in the build, and increases the size of each node by roughly @c CAN_NODE_MESSAGE_COUNT_MAX * 100 bytes.
+#define CAN_NODE_USE_INSTRUMENTATION FALSE
+#endif // CAN_NODE_USE_INSTRUMENTATION
+
+#ifndef CAN_NODE_MESSAGE_COUNT_MAX
+/// @brief The maximum number of messages per node that receive times and statistics are recorded for. Messages with higher
+/// indices are not recorded. Nodes using per-message timeout periods must not have more messages than this.
+#define CAN_NODE_MESSAGE_COUNT_MAX 8
+#endif // CAN_NODE_MESSAGE_COUNT_MAX
+
+/// @brief The number of bins in the inter-arrival time histogram of each message.
+#define CAN_NODE_HISTOGRAM_SIZE 20
+
+#ifndef CAN_NODE_USE_EVENTS
+/// @brief Enables the event source of each CAN node. Note this requires events to be enabled in ChibiOS
+/// ( @c CH_CFG_USE_EVENTS ).
+#define CAN_NODE_USE_EVENTS FALSE
+#endif // CAN_NODE_USE_EVENTS
+
+/// @brief The number of messages that have their own event flag. Messages with higher indices share the last flag.
+#define CAN_NODE_EVENT_MESSAGE_COUNT 30
+
+/**
+ * @brief Event flag broadcast by a CAN node upon receiving a message.
+ * @param index The index of the message, as returned by the node's @c canReceiveHandler_t .
+ */
+#define CAN_NODE_EVENT_MESSAGE(index)																						\
+	((eventflags_t) 1 << ((index) < CAN_NODE_EVENT_MESSAGE_COUNT ? (index) : CAN_NODE_EVENT_MESSAGE_COUNT - 1))
+
+/// @brief Event flag broadcast by a CAN node upon receiving any message.
+#define CAN_NODE_EVENT_MESSAGE_ANY	(((eventflags_t) 1 << CAN_NODE_EVENT_MESSAGE_COUNT) - 1)
+
+/// @brief Event flag broadcast by a CAN node when one or more of its messages become stale (see
+/// @c messageTimeoutPeriods ), without the node timing-out.
+#define CAN_NODE_EVENT_STALE		((eventflags_t) 1 << 30)
+
+/// @brief Event flag broadcast by a CAN node upon timing-out.
+#define CAN_NODE_EVENT_TIMEOUT		((eventflags_t) 1 << 31)
+
 // Datatypes ------------------------------------------------------------------------------------------------------------------
 
 typedef enum
@@ -38,6 +106,16 @@ typedef enum
  */
 typedef int8_t (canReceiveHandler_t) (void* node, CANRxFrame* frame);
 
+/**
+ * @brief Function for identifying the messages belonging to a node. Used to route received messages directly to the node
+ * that owns them, rather than checking each node in turn.
+ * @param node A pointer to the node to identify the messages of (datatype is implementation specific).
+ * @param index The index of the message to identify, in the range [0, @c messageCount ). This is the same index that is
+ * returned by the node's @c canReceiveHandler_t .
+ * @return The identifier of the message, see @c canId_t for details.
+ */
+typedef canId_t (canIdHandler_t) (void* node, uint8_t index);
+
 /**
  * @brief Function for handling a generic event triggered by a CAN node.
  * @param node The CAN node that triggered the event.
@@ -55,22 +133,108 @@ typedef struct
 	/// @brief Optional function to invoke when the node's data times out, use @c NULL to not handle timeout events.
 	canEventHandler_t* timeoutHandler;
 
-	/// @brief The interval to timeout the node's data after.
+	/// @brief Optional function for identifying the messages belonging to the node. Use @c NULL if the node's messages cannot
+	/// be identified ahead of time, in which case every message received by the node's thread will be checked by the node's
+	/// @c receiveHandler .
+	canIdHandler_t* idHandler;
+
+	/// @brief The interval to timeout the node's data after. The node times-out if none of its messages are received within
+	/// this interval. Note the node is checked no more than once per tick, so a period of 0 times-out the node at every tick.
 	sysinterval_t timeoutPeriod;
 
 	/// @brief The total number of messages belonging to the node. Used to determine if the dataset is complete or not.
 	uint8_t messageCount;
+
+	/// @brief Optional array of the timeout period of each message, indexed by message index. If a message is not received
+	/// within its period, it is considered stale and the node becomes incomplete. A period of 0 uses the node's
+	/// @c timeoutPeriod . Use @c NULL to only time-out the node as a whole. Must remain valid for the lifetime of the node.
+	/// @note Ignored if @c messageCount exceeds @c CAN_NODE_MESSAGE_COUNT_MAX .
+	const sysinterval_t* messageTimeoutPeriods;
 } canNodeConfig_t;
 
-#define CAN_NODE_FIELDS							\
-	canNodeState_t			state;				\
-	CANDriver*				driver;				\
-	canReceiveHandler_t*	receiveHandler;		\
-	canEventHandler_t*		timeoutHandler;		\
-	sysinterval_t			timeoutPeriod;		\
-	systime_t				timeoutDeadline;	\
-	uint64_t				messageFlags;		\
-	uint64_t				validFlags;			\
+/**
+ * @brief Receive statistics of a single message of a CAN node.
+ */
+typedef struct
+{
+	/// @brief The total number of times the message was received.
+	uint32_t count;
+
+	/// @brief The shortest execution time of the node's receive handler for this message, in CPU cycles.
+	uint32_t cyclesMin;
+
+	/// @brief The longest execution time of the node's receive handler for this message, in CPU cycles.
+	uint32_t cyclesMax;
+
+	/// @brief The total execution time of the node's receive handler for this message, in CPU cycles. Divide by @c count to
+	/// obtain the average.
+	uint64_t cyclesSum;
+
+	/// @brief The value of the cycle counter when the message was last received.
+	uint32_t cyclesPrevious;
+
+	/// @brief Histogram of the time between consecutive receptions of the message. Bin 0 counts intervals under 1us, bin @c n
+	/// counts intervals in the range [2^(n-1), 2^n) us. The last bin also counts all longer intervals.
+	uint32_t histogram [CAN_NODE_HISTOGRAM_SIZE];
+} canNodeMessageStats_t;
+
+/**
+ * @brief Receive statistics of a CAN node. Only recorded if @c CAN_NODE_USE_INSTRUMENTATION is enabled.
+ */
+typedef struct
+{
+	/// @brief The statistics of each message of the node, by message index.
+	canNodeMessageStats_t messages [CAN_NODE_MESSAGE_COUNT_MAX];
+
+	/// @brief The total number of times the node has timed-out.
+	uint32_t timeoutCount;
+} canNodeStats_t;
+
+#if CAN_NODE_USE_INSTRUMENTATION
+#define CAN_NODE_STATS_FIELD canNodeStats_t stats;
+#else
+#define CAN_NODE_STATS_FIELD
+#endif // CAN_NODE_USE_INSTRUMENTATION
+
+/**
+ * @brief Store of the raw payloads of a node's messages, used by nodes that decode their messages lazily. Rather than
+ * decoding each message upon reception, the node's receive handler only stores the message's payload (see
+ * @c canNodeLazyStore ). The payloads are then decoded upon the node's data being read (see @c canNodeLazyTakePending ), so
+ * messages received at a higher rate than they are read are only decoded once per read. This moves the cost of decoding from
+ * the CAN thread to the consumer of the data.
+ * @note Only messages with indices less than @c CAN_NODE_MESSAGE_COUNT_MAX can be stored.
+ */
+typedef struct
+{
+	/// @brief The payload of the last reception of each message, indexed by message index.
+	uint64_t payloads [CAN_NODE_MESSAGE_COUNT_MAX];
+
+	/// @brief Bit @c n is set if message @c n has been received since it was last decoded.
+	uint32_t pendingFlags;
+} canNodeLazy_t;
+
+#if CAN_NODE_USE_EVENTS
+#define CAN_NODE_EVENT_FIELD event_source_t eventSource;
+#else
+#define CAN_NODE_EVENT_FIELD
+#endif // CAN_NODE_USE_EVENTS
+
+#define CAN_NODE_FIELDS														\
+	canNodeState_t			state;											\
+	CANDriver*				driver;											\
+	canReceiveHandler_t*	receiveHandler;									\
+	canEventHandler_t*		timeoutHandler;									\
+	canIdHandler_t*			idHandler;										\
+	sysinterval_t			timeoutPeriod;									\
+	systime_t				timeoutDeadline;								\
+	uint8_t					messageCount;									\
+	uint64_t				messageFlags;									\
+	uint64_t				validFlags;										\
+	const sysinterval_t*	messageTimeoutPeriods;							\
+	systime_t				receiveTimes [CAN_NODE_MESSAGE_COUNT_MAX];		\
+	volatile uint32_t		sequence;										\
+	CAN_NODE_STATS_FIELD													\
+	CAN_NODE_EVENT_FIELD													\
 	mutex_t					mutex
 
 /**
@@ -82,6 +246,101 @@ typedef struct
 	CAN_NODE_FIELDS;
 } canNode_t;
 
+#ifndef CAN_NODE_SNAPSHOT_ATTEMPTS
+/// @brief The number of times to attempt a lock-free copy of a node before locking the node. Note that a lock-free copy cannot
+/// succeed if the writer was pre-empted by the reader, in which case locking the node allows the writer to finish.
+#define CAN_NODE_SNAPSHOT_ATTEMPTS 3
+#endif // CAN_NODE_SNAPSHOT_ATTEMPTS
+
+#ifndef CAN_NODE_TIMEOUT_QUEUE_SIZE
+/// @brief The maximum number of nodes a @c canNodeTimeoutQueue_t can contain. Must not exceed 256.
+#define CAN_NODE_TIMEOUT_QUEUE_SIZE 32
+#endif // CAN_NODE_TIMEOUT_QUEUE_SIZE
+
+#ifndef CAN_NODE_INDEX_SIZE
+/// @brief The maximum number of messages a @c canNodeIndex_t can identify. If exceeded, the index falls back to checking each
+/// node in turn.
+#define CAN_NODE_INDEX_SIZE 64
+#endif // CAN_NODE_INDEX_SIZE
+
+#ifndef CAN_NODE_INDEX_FALLBACK_SIZE
+/// @brief The maximum number of nodes without a @c canIdHandler_t a @c canNodeIndex_t can contain. If exceeded, the index
+/// falls back to checking each node in turn.
+#define CAN_NODE_INDEX_FALLBACK_SIZE 8
+#endif // CAN_NODE_INDEX_FALLBACK_SIZE
+
+typedef struct
+{
+	/// @brief The identifier of the message.
+	canId_t id;
+
+	/// @brief The index of the node the message belongs to.
+	uint16_t nodeIndex;
+
+	/// @brief The index of the message within its node.
+	uint8_t messageIndex;
+} canNodeIndexEntry_t;
+
+/**
+ * @brief Lookup table mapping CAN message identifiers to the node that owns them. Used to route received messages to the
+ * owning node in logarithmic time, rather than checking each node in turn. Nodes that do not provide a @c canIdHandler_t are
+ * still checked in turn, but only if no indexed node claims the message.
+ */
+typedef struct
+{
+	/// @brief The array of nodes that was indexed.
+	canNode_t** nodes;
+
+	/// @brief The number of elements in @c nodes .
+	uint16_t nodeCount;
+
+	/// @brief Indicates whether the index was built successfully. If not, every node is checked in turn.
+	bool valid;
+
+	/// @brief Entries of the index, sorted by identifier. Entries with the same identifier are sorted by node index.
+	canNodeIndexEntry_t entries [CAN_NODE_INDEX_SIZE];
+
+	/// @brief The number of valid elements in @c entries .
+	uint16_t entryCount;
+
+	/// @brief Indices of the nodes that cannot be indexed.
+	uint16_t fallbackIndices [CAN_NODE_INDEX_FALLBACK_SIZE];
+
+	/// @brief The number of valid elements in @c fallbackIndices .
+	uint16_t fallbackCount;
+} canNodeIndex_t;
+
+/**
+ * @brief Queue of CAN nodes ordered by timeout deadline (binary min-heap). Used to check only the nodes whose deadlines have
+ * expired, rather than every node, and to determine how long a thread may sleep before the next deadline.
+ *
+ * Deadlines are only ever postponed (by receiving a message), so the queue is updated lazily: when the earliest entry
+ * expires, its node is checked, and the entry is re-inserted using the node's current deadline. Hence each node is checked at
+ * most once per timeout period, regardless of how many messages it receives. Nodes that have timed-out are re-checked once
+ * per timeout period.
+ */
+typedef struct
+{
+	/// @brief The array of nodes being queued.
+	canNode_t** nodes;
+
+	/// @brief Indicates whether the queue was created successfully. If not, each node must be checked in turn.
+	bool valid;
+
+	/// @brief The number of valid entries in the queue.
+	uint16_t count;
+
+	/// @brief The time of the last check. All deadlines in the queue are at or after this time, and are compared relative to
+	/// it.
+	systime_t reference;
+
+	/// @brief The deadline of each entry of the queue (heap order).
+	systime_t deadlines [CAN_NODE_TIMEOUT_QUEUE_SIZE];
+
+	/// @brief The index of the node of each entry of the queue (heap order).
+	uint8_t nodeIndices [CAN_NODE_TIMEOUT_QUEUE_SIZE];
+} canNodeTimeoutQueue_t;
+
 // CAN Node Functions ---------------------------------------------------------------------------------------------------------
 
 /**
@@ -105,9 +364,13 @@ bool canNodeReceive (canNode_t* node, CANRxFrame* frame);
  * @brief Checks whether the CAN node's timeout deadline has expired. If so, the node is put into the @c CAN_NODE_TIMEOUT state
  * the timeout event handler is called.
  * @param node The node to check.
+ * @param timePrevious The system time of the previous check.
  * @param timeCurrent The current system time.
+ * @return The next time the node's timeout should be checked at. This is the earliest deadline of the node or any of its
+ * messages, or, if the node has timed-out, one timeout period from now. Note this is never later than the deadline of any
+ * message received after this call, and never earlier than 1 tick from now.
  */
-void canNodeCheckTimeout (canNode_t* node, systime_t timePrevious, systime_t timeCurrent);
+systime_t canNodeCheckTimeout (canNode_t* node, systime_t timePrevious, systime_t timeCurrent);
 
 /**
  * @brief Locks a CAN node for exclusive access.
@@ -121,6 +384,81 @@ void canNodeLock (canNode_t* node);
  */
 void canNodeUnlock (canNode_t* node);
 
+/**
+ * @brief Copies a consistent snapshot of a CAN node, without blocking any thread modifying the node. If the node is modified
+ * while being copied, the copy is retried. If the node cannot be copied after @c CAN_NODE_SNAPSHOT_ATTEMPTS attempts, the
+ * node is locked for the copy.
+ * @note The snapshot's mutex must not be used.
+ * @note Prefer the @c canNodeGetSnapshot macro, which determines the size of the snapshot automatically.
+ * @param node The node to copy.
+ * @param snapshot The buffer to copy the node into.
+ * @param size The number of bytes to copy, should be the size of the node's derived datatype.
+ */
+void canNodeCopy (canNode_t* node, void* snapshot, size_t size);
+
+/**
+ * @brief Copies a consistent snapshot of a CAN node into a caller-owned instance of the same datatype. See @c canNodeCopy for
+ * details.
+ * @param node Pointer to the node to copy (ex. @c amkInverter_t* ).
+ * @param snapshot Pointer to the instance to copy the node into, must be of the same datatype as @c node .
+ */
+#define canNodeGetSnapshot(node, snapshot) canNodeCopy ((canNode_t*) (node), (snapshot), sizeof (*(snapshot)))
+
+/**
+ * @brief Stores the payload of a received message, to be decoded later. Should be called from a node's receive handler.
+ * @param lazy The store to write to.
+ * @param index The index of the message, must be less than @c CAN_NODE_MESSAGE_COUNT_MAX .
+ * @param frame The received message.
+ */
+static inline void canNodeLazyStore (canNodeLazy_t* lazy, uint8_t index, const CANRxFrame* frame)
+{
+	lazy->payloads [index] = frame->data64 [0];
+	lazy->pendingFlags |= (uint32_t) 1 << index;
+}
+
+/**
+ * @brief Gets and clears the flags of the messages that have been received since they were last decoded. The caller is then
+ * responsible for decoding each flagged message from @c payloads . The node must be locked, or be a snapshot.
+ * @param lazy The store to check.
+ * @return The pending flags, bit @c n is set if message @c n must be decoded.
+ */
+static inline uint32_t canNodeLazyTakePending (canNodeLazy_t* lazy)
+{
+	uint32_t pendingFlags = lazy->pendingFlags;
+	lazy->pendingFlags = 0;
+	return pendingFlags;
+}
+
+#if CAN_NODE_USE_EVENTS
+
+/**
+ * @brief Gets the event source of a CAN node. Broadcast with the @c CAN_NODE_EVENT_MESSAGE flag of each message the node
+ * receives, and the @c CAN_NODE_EVENT_STALE and @c CAN_NODE_EVENT_TIMEOUT flags.
+ * @note The event source of a snapshot must not be used.
+ * @param node Pointer to the node (ex. @c amkInverter_t* ).
+ * @return Pointer to the node's event source ( @c event_source_t* ).
+ */
+#define canNodeGetEventSource(node) (&((canNode_t*) (node))->eventSource)
+
+#endif // CAN_NODE_USE_EVENTS
+
+#if CAN_NODE_USE_INSTRUMENTATION
+
+/**
+ * @brief Resets the receive statistics of a CAN node.
+ * @param node The node to reset.
+ */
+void canNodeResetStats (canNode_t* node);
+
+/**
+ * @brief Prints the receive statistics of a CAN node to the debug stream (see @c debugPrintf ).
+ * @param node The node to print.
+ * @param name The name to identify the node by.
+ */
+void canNodePrintStats (canNode_t* node, const char* name);
+
+#endif // CAN_NODE_USE_INSTRUMENTATION
+
 // CAN Node Array Functions ---------------------------------------------------------------------------------------------------
 
 /**
@@ -139,4 +477,57 @@ bool canNodesReceive (canNode_t** nodes, uint8_t nodeCount, CANRxFrame* frame);
  */
 void canNodesCheckTimeout (canNode_t** nodes, uint8_t nodeCount, systime_t timePrevious, systime_t timeCurrent);
 
+/**
+ * @brief Gets the identifiers of every message belonging to the nodes of an array.
+ * @param nodes The array of nodes to identify the messages of.
+ * @param nodeCount The number of elements in @c nodes .
+ * @param ids Array to write the identifiers into.
+ * @param idCount The number of elements in @c ids .
+ * @return The number of identifiers written, or -1 if a node cannot identify its messages (has no @c canIdHandler_t ), or
+ * @c ids is too small.
+ */
+int16_t canNodesGetIds (canNode_t** nodes, uint16_t nodeCount, canId_t* ids, uint16_t idCount);
+
+// CAN Node Timeout Queue Functions -------------------------------------------------------------------------------------------
+
+/**
+ * @brief Creates a timeout queue from an array of CAN nodes. Each node must already be initialized. The timeout deadline of
+ * each node is restarted, as the nodes cannot have received any messages before this point.
+ * @param queue The queue to create.
+ * @param nodes The array of nodes to queue. Must remain valid for the lifetime of the queue.
+ * @param nodeCount The number of elements in @c nodes .
+ * @param timeCurrent The current system time.
+ * @return True if successful, false if the queue's capacity was exceeded. In the latter case, the queue must not be used and
+ * the nodes should be checked using @c canNodesCheckTimeout instead.
+ */
+bool canNodeTimeoutQueueInit (canNodeTimeoutQueue_t* queue, canNode_t** nodes, uint16_t nodeCount, systime_t timeCurrent);
+
+/**
+ * @brief Checks the timeout of each node in a queue whose deadline has expired.
+ * @param queue The queue to check.
+ * @param timeCurrent The current system time.
+ * @return The interval until the next deadline, or @c TIME_INFINITE if the queue is empty.
+ */
+sysinterval_t canNodeTimeoutQueueCheck (canNodeTimeoutQueue_t* queue, systime_t timeCurrent);
+
+// CAN Node Index Functions ---------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Builds an index over an array of CAN nodes. Each node must already be initialized.
+ * @param index The index to build.
+ * @param nodes The array of nodes to index. Must remain valid for the lifetime of the index.
+ * @param nodeCount The number of elements in @c nodes .
+ * @return True if successful, false if the index's capacity was exceeded. In the latter case, the index is still usable, but
+ * checks each node in turn.
+ */
+bool canNodeIndexInit (canNodeIndex_t* index, canNode_t** nodes, uint16_t nodeCount);
+
+/**
+ * @brief Routes a received CAN message to the node that owns it, using a previously built index.
+ * @param index The index to use.
+ * @param frame The received CAN frame.
+ * @return True if the message was identified and handled, false otherwise.
+ */
+bool canNodeIndexReceive (canNodeIndex_t* index, CANRxFrame* frame);
+
 #endif // CAN_NODE_H
\ No newline at end of file
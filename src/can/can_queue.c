@@ -0,0 +1,151 @@
+// Header
+#include "can_queue.h"
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Gets the index following the specified index of a queue.
+ */
+static inline uint16_t nextIndex (canQueue_t* queue, uint16_t index)
+{
+	// Indices cover twice the queue's size, such that a full queue can be distinguished from an empty one.
+	++index;
+	if (index == 2 * queue->size)
+		index = 0;
+	return index;
+}
+
+/**
+ * @brief Gets the buffer element an index of a queue refers to.
+ */
+static inline CANRxFrame* getFrame (canQueue_t* queue, uint16_t index)
+{
+	if (index >= queue->size)
+		index -= queue->size;
+	return &queue->buffer [index];
+}
+
+/**
+ * @brief Gets the number of messages between two indices of a queue.
+ */
+static inline uint16_t getCount (canQueue_t* queue, uint16_t head, uint16_t tail)
+{
+	if (head >= tail)
+		return head - tail;
+	return head + 2 * queue->size - tail;
+}
+
+void canQueueInit (canQueue_t* queue, CANRxFrame* buffer, uint16_t size, canQueueOverflowPolicy_t overflowPolicy)
+{
+	queue->buffer			= buffer;
+	queue->size				= size;
+	queue->overflowPolicy	= overflowPolicy;
+	queue->head				= 0;
+	queue->tail				= 0;
+	queue->pushCount		= 0;
+	queue->dropCount		= 0;
+	queue->highWaterMark	= 0;
+
+	chBSemObjectInit (&queue->pushSemaphore, true);
+	chBSemObjectInit (&queue->popSemaphore, true);
+}
+
+bool canQueuePush (canQueue_t* queue, const CANRxFrame* frame)
+{
+	uint16_t head = queue->head;
+
+	while (getCount (queue, head, queue->tail) >= queue->size)
+	{
+		if (queue->overflowPolicy == CAN_QUEUE_DROP_NEWEST)
+		{
+			++queue->dropCount;
+			return false;
+		}
+
+		if (queue->overflowPolicy == CAN_QUEUE_BLOCK)
+		{
+			// Wait for the consumer to pop a message, then re-check.
+			chBSemWait (&queue->popSemaphore);
+			continue;
+		}
+
+		// Drop the oldest message. The consumer may be reading this message concurrently, so the tail is only advanced in a
+		// critical section, allowing the consumer to detect the message was discarded (see canQueuePop).
+		chSysLock ();
+		if (getCount (queue, head, queue->tail) >= queue->size)
+		{
+			queue->tail = nextIndex (queue, queue->tail);
+			++queue->dropCount;
+		}
+		chSysUnlock ();
+	}
+
+	// Write the message, then publish it. The barrier ensures the consumer cannot observe the new head before the message.
+	*getFrame (queue, head) = *frame;
+	__DMB ();
+	head = nextIndex (queue, head);
+	queue->head = head;
+
+	++queue->pushCount;
+	uint16_t count = getCount (queue, head, queue->tail);
+	if (count > queue->highWaterMark)
+		queue->highWaterMark = count;
+
+	chBSemSignal (&queue->pushSemaphore);
+	return true;
+}
+
+bool canQueuePop (canQueue_t* queue, CANRxFrame* frame, sysinterval_t timeout)
+{
+	while (true)
+	{
+		// The drop count is read before the tail, such that any message discarded after the tail is read is detected (see
+		// below). Both are volatile, so this order is preserved.
+		uint32_t dropCount = queue->dropCount;
+		uint16_t tail = queue->tail;
+
+		// If the queue is empty, wait for the producer to push a message, then re-check.
+		if (queue->head == tail)
+		{
+			if (chBSemWaitTimeout (&queue->pushSemaphore, timeout) != MSG_OK)
+				return false;
+			continue;
+		}
+
+		// Read the message. The barrier ensures the message is not read before the head that published it.
+		__DMB ();
+		*frame = *getFrame (queue, tail);
+
+		if (queue->overflowPolicy == CAN_QUEUE_DROP_OLDEST)
+		{
+			// Release the message, unless the producer discarded it while it was being read, in which case the copy may be
+			// corrupt and the next message must be read instead. The producer always discards the message at the tail first,
+			// so this is the case if any message was discarded. Note comparing the tail alone is not sufficient, as the
+			// producer may lap the queue during the copy, returning the tail to the same index.
+			chSysLock ();
+			bool released = queue->dropCount == dropCount;
+			if (released)
+				queue->tail = nextIndex (queue, tail);
+			chSysUnlock ();
+
+			if (!released)
+				continue;
+		}
+		else
+		{
+			// Release the message. The barrier ensures the message is read before the producer can overwrite it.
+			__DMB ();
+			queue->tail = nextIndex (queue, tail);
+
+			if (queue->overflowPolicy == CAN_QUEUE_BLOCK)
+				chBSemSignal (&queue->popSemaphore);
+		}
+
+		return true;
+	}
+}
+
+uint16_t canQueueGetCount (canQueue_t* queue)
+{
+	return getCount (queue, queue->head, queue->tail);
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#ifndef CAN_QUEUE_H
+#define CAN_QUEUE_H
+
+// CAN Message Queue ----------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Bounded FIFO queue of received CAN messages, used to pass messages from one thread to another without
+//   blocking the producer. The queue is designed for a single producer and a single consumer. Pushing and popping are
+//   lock-free, except when the drop-oldest overflow policy is used, in which case the producer and consumer briefly enter a
+//   critical section to agree on which message is discarded.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// ChibiOS
+#include "hal.h"
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+typedef enum
+{
+	/// @brief When the queue is full, the oldest message in the queue is discarded to make room for the new message.
+	CAN_QUEUE_DROP_OLDEST = 0,
+
+	/// @brief When the queue is full, the new message is discarded.
+	CAN_QUEUE_DROP_NEWEST = 1,
+
+	/// @brief When the queue is full, the producer blocks until the consumer makes room for the new message.
+	CAN_QUEUE_BLOCK = 2
+} canQueueOverflowPolicy_t;
+
+typedef struct
+{
+	/// @brief The buffer to store queued messages in.
+	CANRxFrame* buffer;
+
+	/// @brief The number of elements in @c buffer , that is, the capacity of the queue.
+	uint16_t size;
+
+	/// @brief The action to take when a message is pushed into a full queue.
+	canQueueOverflowPolicy_t overflowPolicy;
+
+	/// @brief Index to push the next message to, in the range [0, 2 * size).
+	volatile uint16_t head;
+
+	/// @brief Index to pop the next message from, in the range [0, 2 * size).
+	volatile uint16_t tail;
+
+	/// @brief Signaled when a message is pushed into the queue.
+	binary_semaphore_t pushSemaphore;
+
+	/// @brief Signaled when a message is popped from the queue.
+	binary_semaphore_t popSemaphore;
+
+	/// @brief The total number of messages pushed into the queue.
+	volatile uint32_t pushCount;
+
+	/// @brief The total number of messages discarded due to the queue overflowing. Also used by the consumer to detect a
+	/// message being discarded while it is read ( @c CAN_QUEUE_DROP_OLDEST policy only).
+	volatile uint32_t dropCount;
+
+	/// @brief The largest number of messages the queue has held at once.
+	volatile uint16_t highWaterMark;
+} canQueue_t;
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes an empty queue.
+ * @param queue The queue to initialize.
+ * @param buffer The buffer to store queued messages in. Must remain valid for the lifetime of the queue.
+ * @param size The number of elements in @c buffer . Must be at least 1.
+ * @param overflowPolicy The action to take when a message is pushed into a full queue.
+ */
+void canQueueInit (canQueue_t* queue, CANRxFrame* buffer, uint16_t size, canQueueOverflowPolicy_t overflowPolicy);
+
+/**
+ * @brief Pushes a message into the back of the queue. Only to be called from the queue's producer thread.
+ * @param queue The queue to push into.
+ * @param frame The message to push.
+ * @return True if the message was queued, false if it was discarded ( @c CAN_QUEUE_DROP_NEWEST policy only).
+ */
+bool canQueuePush (canQueue_t* queue, const CANRxFrame* frame);
+
+/**
+ * @brief Pops a message from the front of the queue. Only to be called from the queue's consumer thread.
+ * @param queue The queue to pop from.
+ * @param frame Written to contain the popped message.
+ * @param timeout The interval to wait for a message if the queue is empty. Use @c TIME_IMMEDIATE to not block.
+ * @return True if a message was popped, false if the timeout expired.
+ */
+bool canQueuePop (canQueue_t* queue, CANRxFrame* frame, sysinterval_t timeout);
+
+/**
+ * @brief Gets the number of messages currently in the queue.
+ * @param queue The queue to check.
+ * @return The number of messages.
+ */
+uint16_t canQueueGetCount (canQueue_t* queue);
+
+#endif // CAN_QUEUE_H
\ No newline at end of file
@@ -0,0 +1,9 @@
+ifndef CAN_QUEUE_MK
+define CAN_QUEUE_MK
+1
+endef
+
+# Add the module's source file to the compilation
+CSRC += common/src/can/can_queue.c
+
+endif # CAN_QUEUE_MK
\ No newline at end of file
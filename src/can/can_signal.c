@@ -0,0 +1,112 @@
+// Header
+#include "can_signal.h"
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Reads a message's payload as a little-endian integer (bit 0 of byte 0 is the LSB).
+ */
+static inline uint64_t readPayload (const uint8_t* data)
+{
+	uint64_t payload = 0;
+	for (uint8_t index = 0; index < 8; ++index)
+		payload |= (uint64_t) data [index] << (index * 8);
+	return payload;
+}
+
+/**
+ * @brief Decodes a single signal from a message's payload.
+ * @param signal The signal to decode.
+ * @param object The struct to write the decoded value into.
+ * @param payload The payload, read as a little-endian integer.
+ * @param payloadReversed The payload, read as a big-endian integer (bit 0 of byte 7 is the LSB).
+ */
+static void decodeSignal (const canSignal_t* signal, void* object, uint64_t payload, uint64_t payloadReversed)
+{
+	// Extract the raw value. Little-endian signals are extracted from the little-endian payload, big-endian signals from the
+	// big-endian payload.
+	uint8_t shift;
+	if (signal->byteOrder == CAN_SIGNAL_LITTLE_ENDIAN)
+	{
+		shift = signal->startBit;
+	}
+	else
+	{
+		// Position of the MSB in the big-endian payload, the signal extends towards the LSB from here.
+		uint8_t msb = (7 - signal->startBit / 8) * 8 + signal->startBit % 8;
+		shift = msb - signal->length + 1;
+		payload = payloadReversed;
+	}
+
+	uint32_t mask = signal->length >= 32 ? 0xFFFFFFFF : ((uint32_t) 1 << signal->length) - 1;
+	uint32_t raw = (uint32_t) (payload >> shift) & mask;
+
+	// Sign-extend the raw value, if needed.
+	int32_t rawSigned = (int32_t) raw;
+	if (signal->isSigned && signal->length < 32 && (raw & ((uint32_t) 1 << (signal->length - 1))) != 0)
+		rawSigned = (int32_t) (raw | ~mask);
+
+	// Write the value into the destination field.
+	void* destination = (uint8_t*) object + signal->destination;
+	switch (signal->type)
+	{
+	case CAN_SIGNAL_FLOAT:
+		if (signal->isSigned)
+			*(float*) destination = rawSigned * signal->factor + signal->offset;
+		else
+			*(float*) destination = raw * signal->factor + signal->offset;
+		break;
+
+	case CAN_SIGNAL_BOOL:
+		*(bool*) destination = raw != 0;
+		break;
+
+	case CAN_SIGNAL_UINT8:
+		*(uint8_t*) destination = (uint8_t) raw;
+		break;
+
+	case CAN_SIGNAL_UINT16:
+		*(uint16_t*) destination = (uint16_t) raw;
+		break;
+
+	case CAN_SIGNAL_INT16:
+		*(int16_t*) destination = (int16_t) rawSigned;
+		break;
+
+	case CAN_SIGNAL_UINT32:
+		*(uint32_t*) destination = raw;
+		break;
+
+	case CAN_SIGNAL_INT32:
+		*(int32_t*) destination = rawSigned;
+		break;
+	}
+}
+
+void canSignalDecodeSignal (const canSignal_t* signal, void* object, const uint8_t* data)
+{
+	uint64_t payload = readPayload (data);
+	decodeSignal (signal, object, payload, __builtin_bswap64 (payload));
+}
+
+int8_t canSignalDecode (const canSignalMessage_t* messages, uint8_t messageCount, void* object, canId_t id,
+	const uint8_t* data)
+{
+	for (uint8_t index = 0; index < messageCount; ++index)
+	{
+		const canSignalMessage_t* message = &messages [index];
+		if (message->id != id)
+			continue;
+
+		// Read the payload once, then decode each signal from it.
+		uint64_t payload = readPayload (data);
+		uint64_t payloadReversed = __builtin_bswap64 (payload);
+		for (uint8_t signal = 0; signal < message->signalCount; ++signal)
+			decodeSignal (&message->signals [signal], object, payload, payloadReversed);
+
+		return index;
+	}
+
+	// Message is not in the table.
+	return -1;
+}
\ No newline at end of file
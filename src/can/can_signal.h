@@ -0,0 +1,136 @@
+#ifndef CAN_SIGNAL_H
+#define CAN_SIGNAL_H
+
+// CAN Signal Decoding --------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Table-driven decoder for the signals of CAN messages. Each message is described by its identifier and a
+//   table of signals, each signal specifying its position in the message's payload, its encoding, the scaling to apply, and
+//   the field of the destination struct to write the decoded value into. A node's receive handler can then be implemented by
+//   a single call to @c canSignalDecode , rather than a hand-written decoder per message.
+//
+//   The decoder trades speed for generality: decoding a BMS message costs roughly 25 cycles on a host machine, against 4
+//   cycles for its hand-written handler (see test/dbc_node_benchmark.c). Nodes receiving messages at high rates should prefer
+//   hand-written handlers, or handlers generated from a DBC file (see tools/dbc_to_can_node.py), which are as fast.
+//
+//   Signal positions follow the DBC convention: for little-endian (Intel) signals, the start bit is the position of the
+//   signal's least significant bit. For big-endian (Motorola) signals, the start bit is the position of the signal's most
+//   significant bit. In both cases, bit n is bit (n % 8) of byte (n / 8) of the payload.
+//
+//   Note this module has no dependency on ChibiOS, so it may also be compiled and tested on a host machine.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// Includes
+#include "can_id.h"
+
+// C Standard Library
+#include <stddef.h>
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+typedef enum
+{
+	/// @brief Intel byte order, the least significant byte is first.
+	CAN_SIGNAL_LITTLE_ENDIAN = 0,
+
+	/// @brief Motorola byte order, the most significant byte is first.
+	CAN_SIGNAL_BIG_ENDIAN = 1
+} canSignalByteOrder_t;
+
+typedef enum
+{
+	/// @brief The destination is a @c float . The decoded value is scaled by the signal's factor and offset.
+	CAN_SIGNAL_FLOAT = 0,
+
+	/// @brief The destination is a @c bool , set if the raw value is non-zero.
+	CAN_SIGNAL_BOOL = 1,
+
+	/// @brief The destination is a @c uint8_t . The raw value is written, the factor and offset are ignored.
+	CAN_SIGNAL_UINT8 = 2,
+
+	/// @brief The destination is a @c uint16_t . The raw value is written, the factor and offset are ignored.
+	CAN_SIGNAL_UINT16 = 3,
+
+	/// @brief The destination is a @c int16_t . The raw value is written, the factor and offset are ignored.
+	CAN_SIGNAL_INT16 = 4,
+
+	/// @brief The destination is a @c uint32_t . The raw value is written, the factor and offset are ignored.
+	CAN_SIGNAL_UINT32 = 5,
+
+	/// @brief The destination is a @c int32_t . The raw value is written, the factor and offset are ignored.
+	CAN_SIGNAL_INT32 = 6
+} canSignalType_t;
+
+/**
+ * @brief Description of a single signal of a CAN message. The decoded value is calculated as
+ * @c value = @c raw * @c factor + @c offset .
+ */
+typedef struct
+{
+	/// @brief The position of the signal in the payload, see the module description for details.
+	uint8_t startBit;
+
+	/// @brief The length of the signal, in bits. Must be in the range [1, 32].
+	uint8_t length;
+
+	/// @brief The byte order of the signal.
+	canSignalByteOrder_t byteOrder;
+
+	/// @brief Indicates whether the raw value is a two's complement signed integer.
+	bool isSigned;
+
+	/// @brief The factor to scale the raw value by.
+	float factor;
+
+	/// @brief The offset to add to the scaled value.
+	float offset;
+
+	/// @brief The datatype of the destination field.
+	canSignalType_t type;
+
+	/// @brief The offset of the destination field within the destination struct. Should be obtained using @c offsetof .
+	uint16_t destination;
+} canSignal_t;
+
+/**
+ * @brief Description of a CAN message, that is, the message's identifier and the signals it contains.
+ */
+typedef struct
+{
+	/// @brief The identifier of the message (see @c canIdStandard and @c canIdExtended ).
+	canId_t id;
+
+	/// @brief The array of signals in the message.
+	const canSignal_t* signals;
+
+	/// @brief The number of elements in @c signals .
+	uint8_t signalCount;
+} canSignalMessage_t;
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Decodes a single signal from a message's payload.
+ * @param signal The signal to decode.
+ * @param object The struct to write the decoded value into.
+ * @param data The payload of the message, must be 8 bytes long.
+ */
+void canSignalDecodeSignal (const canSignal_t* signal, void* object, const uint8_t* data);
+
+/**
+ * @brief Identifies a received message using a table of messages, decoding each of its signals.
+ * @param messages The table of messages to check.
+ * @param messageCount The number of elements in @c messages .
+ * @param object The struct to write the decoded values into.
+ * @param id The identifier of the received message.
+ * @param data The payload of the received message, must be 8 bytes long.
+ * @return The index of the message in @c messages , or -1 if the message is not in the table. This may be used as a node's
+ * message index.
+ */
+int8_t canSignalDecode (const canSignalMessage_t* messages, uint8_t messageCount, void* object, canId_t id,
+	const uint8_t* data);
+
+#endif // CAN_SIGNAL_H
\ No newline at end of file
@@ -0,0 +1,9 @@
+ifndef CAN_SIGNAL_MK
+define CAN_SIGNAL_MK
+1
+endef
+
+# Add the module's source file to the compilation
+CSRC += common/src/can/can_signal.c
+
+endif # CAN_SIGNAL_MK
\ No newline at end of file
@@ -0,0 +1,110 @@
+// Header
+#include "can_snapshot.h"
+
+// C Standard Library
+#include <string.h>
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+void canSnapshotInit (canSnapshot_t* snapshot, const canSnapshotConfig_t* config)
+{
+	snapshot->config			= config;
+	snapshot->sequence			= 0;
+	snapshot->timestamps [0]	= 0;
+	snapshot->timestamps [1]	= 0;
+	snapshot->triggerFlags		= 0;
+
+	// Messages received before this point do not count towards the trigger.
+	for (uint8_t index = 0; index < config->triggerCount; ++index)
+		snapshot->triggerTimes [index] = config->triggerNodes [index]->receiveTimes [config->triggerMessages [index]];
+
+	chMtxObjectInit (&snapshot->mutex);
+}
+
+void canSnapshotPublish (canSnapshot_t* snapshot)
+{
+	const canSnapshotConfig_t* config = snapshot->config;
+
+	chMtxLock (&snapshot->mutex);
+
+	// Write into the inactive buffer.
+	uint8_t bufferIndex = (snapshot->sequence + 1) % 2;
+
+	// Lock every node at once, such that no node is modified while the others are copied. Nodes are always locked in the same
+	// order, and no other code holds more than one node's lock, so this cannot deadlock.
+	for (uint8_t index = 0; index < config->nodeCount; ++index)
+		canNodeLock (config->nodes [index]);
+
+	config->packHandler (config->object, config->buffers [bufferIndex]);
+	snapshot->timestamps [bufferIndex] = chVTGetSystemTimeX ();
+
+	for (uint8_t index = config->nodeCount; index > 0; --index)
+		canNodeUnlock (config->nodes [index - 1]);
+
+	// Swap the buffers. The barrier prevents the buffer's contents from being re-ordered after this.
+	__DMB ();
+	++snapshot->sequence;
+
+	snapshot->triggerFlags = 0;
+	chMtxUnlock (&snapshot->mutex);
+}
+
+bool canSnapshotCheck (canSnapshot_t* snapshot)
+{
+	const canSnapshotConfig_t* config = snapshot->config;
+	if (config->triggerCount == 0)
+		return false;
+
+	// Flag each message of the trigger received since the last check.
+	for (uint8_t index = 0; index < config->triggerCount; ++index)
+	{
+		systime_t timeReceived = config->triggerNodes [index]->receiveTimes [config->triggerMessages [index]];
+		if (timeReceived != snapshot->triggerTimes [index])
+		{
+			snapshot->triggerTimes [index] = timeReceived;
+			snapshot->triggerFlags |= (uint32_t) 1 << index;
+		}
+	}
+
+	// Publish once every message has been received.
+	if (snapshot->triggerFlags != ((uint32_t) 1 << config->triggerCount) - 1)
+		return false;
+
+	canSnapshotPublish (snapshot);
+	return true;
+}
+
+uint32_t canSnapshotRead (canSnapshot_t* snapshot, void* buffer, systime_t* timestamp)
+{
+	const canSnapshotConfig_t* config = snapshot->config;
+	uint32_t sequence;
+
+	for (uint8_t attempt = 0; attempt < CAN_SNAPSHOT_READ_ATTEMPTS; ++attempt)
+	{
+		sequence = snapshot->sequence;
+
+		__DMB ();
+		memcpy (buffer, config->buffers [sequence % 2], config->size);
+		systime_t time = snapshot->timestamps [sequence % 2];
+		__DMB ();
+
+		// If no publish completed during the copy, the publisher cannot have written to this buffer (the next publish writes to
+		// the other buffer), so the copy is consistent.
+		if (snapshot->sequence == sequence)
+		{
+			if (timestamp != NULL)
+				*timestamp = time;
+			return sequence;
+		}
+	}
+
+	// Otherwise, the publisher may be pre-empting this thread. Locking the snapshot blocks until the publisher finishes.
+	chMtxLock (&snapshot->mutex);
+	sequence = snapshot->sequence;
+	memcpy (buffer, config->buffers [sequence % 2], config->size);
+	if (timestamp != NULL)
+		*timestamp = snapshot->timestamps [sequence % 2];
+	chMtxUnlock (&snapshot->mutex);
+
+	return sequence;
+}
\ No newline at end of file
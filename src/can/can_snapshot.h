@@ -0,0 +1,143 @@
+#ifndef CAN_SNAPSHOT_H
+#define CAN_SNAPSHOT_H
+
+// CAN Snapshot ---------------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Object for publishing a coherent copy of the data of a set of CAN nodes. Taking a snapshot of each node
+//   separately (see @c canNodeGetSnapshot ) guarantees each node is internally consistent, but not that the nodes are
+//   consistent with each other, as messages may be received between the copies. Instead, a snapshot object locks each of its
+//   nodes at once and copies the required fields (using a user-provided pack handler) into a single, timestamped structure.
+//
+//   Snapshots are double-buffered: the publisher writes into the inactive buffer, then swaps the buffers. Readers copy the
+//   active buffer without locking (see @c canSnapshotRead ), retrying only if a publish completed during the copy.
+//
+//   A snapshot may be published explicitly (see @c canSnapshotPublish ), or upon a trigger (see @c canSnapshotCheck ). The
+//   trigger is a set of messages, the snapshot is published once each message has been received since the last publish. For
+//   example, using the feedback message of each inverter as the trigger publishes a snapshot once per inverter cycle,
+//   immediately after the last inverter's feedback arrives. A CAN thread can check its snapshots' triggers after each batch of
+//   messages (see @c canThreadConfig_t ).
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// Includes
+#include "can_node.h"
+
+// ChibiOS
+#include "ch.h"
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+#ifndef CAN_SNAPSHOT_TRIGGER_COUNT_MAX
+/// @brief The maximum number of messages a snapshot's trigger may consist of.
+#define CAN_SNAPSHOT_TRIGGER_COUNT_MAX 8
+#endif // CAN_SNAPSHOT_TRIGGER_COUNT_MAX
+
+#ifndef CAN_SNAPSHOT_READ_ATTEMPTS
+/// @brief The number of times to attempt a lock-free read of a snapshot before locking it.
+#define CAN_SNAPSHOT_READ_ATTEMPTS 3
+#endif // CAN_SNAPSHOT_READ_ATTEMPTS
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Function for copying the fields of a snapshot's nodes into the snapshot. Called while each of the snapshot's nodes is
+ * locked, so should only copy data (no decoding, etc.).
+ * @param object The object provided by the snapshot's configuration.
+ * @param buffer The buffer to write the snapshot into (datatype is application specific).
+ */
+typedef void (canSnapshotPackHandler_t) (void* object, void* buffer);
+
+typedef struct
+{
+	/// @brief The array of nodes to lock while packing the snapshot (array of pointers). If multiple snapshots share nodes, the
+	/// nodes must be listed in the same relative order in each.
+	canNode_t** nodes;
+
+	/// @brief The number of elements in the @c nodes array.
+	uint8_t nodeCount;
+
+	/// @brief The array of nodes the messages of the trigger belong to (array of pointers). May be @c NULL if the snapshot is
+	/// only published explicitly.
+	canNode_t** triggerNodes;
+
+	/// @brief The index of each message of the trigger (within its node of @c triggerNodes ). Must be less than
+	/// @c CAN_NODE_MESSAGE_COUNT_MAX .
+	const uint8_t* triggerMessages;
+
+	/// @brief The number of messages in the trigger. Must not exceed @c CAN_SNAPSHOT_TRIGGER_COUNT_MAX .
+	uint8_t triggerCount;
+
+	/// @brief The two buffers to publish the snapshot into. Each must be of @c size bytes.
+	void* buffers [2];
+
+	/// @brief The size of each buffer, in bytes.
+	size_t size;
+
+	/// @brief Function to pack the snapshot.
+	canSnapshotPackHandler_t* packHandler;
+
+	/// @brief Object to pass to the @c packHandler .
+	void* object;
+} canSnapshotConfig_t;
+
+typedef struct
+{
+	const canSnapshotConfig_t* config;
+
+	/// @brief The number of times the snapshot has been published. The active buffer is @c buffers [ @c sequence % 2].
+	volatile uint32_t sequence;
+
+	/// @brief The time each buffer was published at.
+	systime_t timestamps [2];
+
+	/// @brief The time each message of the trigger was last received at, as of the last check.
+	systime_t triggerTimes [CAN_SNAPSHOT_TRIGGER_COUNT_MAX];
+
+	/// @brief Bit @c n is set if message @c n of the trigger has been received since the last publish.
+	uint32_t triggerFlags;
+
+	/// @brief Mutex held while publishing.
+	mutex_t mutex;
+} canSnapshot_t;
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes a snapshot using the specified configuration. The snapshot's nodes must already be initialized.
+ * @note Until the snapshot is first published, reads return the initial contents of the first buffer.
+ * @param snapshot The snapshot to initialize.
+ * @param config The configuration to use.
+ */
+void canSnapshotInit (canSnapshot_t* snapshot, const canSnapshotConfig_t* config);
+
+/**
+ * @brief Packs and publishes a snapshot.
+ * @param snapshot The snapshot to publish.
+ */
+void canSnapshotPublish (canSnapshot_t* snapshot);
+
+/**
+ * @brief Checks whether each message of a snapshot's trigger has been received since the last publish. If so, the snapshot
+ * is published. Should be called by the thread receiving the trigger's messages, after handling them.
+ * @note Messages of the trigger received within the same system tick as their previous reception are not detected.
+ * @param snapshot The snapshot to check.
+ * @return True if the snapshot was published, false otherwise.
+ */
+bool canSnapshotCheck (canSnapshot_t* snapshot);
+
+/**
+ * @brief Copies the most recently published snapshot, without blocking the publisher. If a publish completes during the copy,
+ * the copy is retried. If the snapshot cannot be copied after @c CAN_SNAPSHOT_READ_ATTEMPTS attempts, the snapshot is
+ * locked for the copy.
+ * @param snapshot The snapshot to read.
+ * @param buffer The buffer to copy the snapshot into, must be of the configuration's @c size bytes.
+ * @param timestamp Written to contain the time the snapshot was published at. May be @c NULL .
+ * @return The sequence number of the snapshot that was read. This is incremented upon each publish, so may be used to
+ * determine whether a new snapshot is available.
+ */
+uint32_t canSnapshotRead (canSnapshot_t* snapshot, void* buffer, systime_t* timestamp);
+
+#endif // CAN_SNAPSHOT_H
\ No newline at end of file
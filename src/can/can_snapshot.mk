@@ -0,0 +1,12 @@
+ifndef CAN_SNAPSHOT_MK
+define CAN_SNAPSHOT_MK
+1
+endef
+
+# Include the module's common dependencies
+include common/src/can/can_node.mk
+
+# Add the module's source file to the compilation
+CSRC += common/src/can/can_snapshot.c
+
+endif # CAN_SNAPSHOT_MK
\ No newline at end of file
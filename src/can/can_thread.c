@@ -4,6 +4,17 @@
 // C Standard Library
 #include <string.h>
 
+// Function Prototypes --------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Handles a message received by a CAN thread.
+ * @param config The configuration of the thread.
+ * @param nodeIndex The index of the thread's nodes.
+ * @param rxFrame The message to handle.
+ * @param timeReceived The time the message was received at.
+ */
+static void handleFrame (const canThreadConfig_t* config, canNodeIndex_t* nodeIndex, CANRxFrame* rxFrame, systime_t timeReceived);
+
 // Thread Entrypoint ----------------------------------------------------------------------------------------------------------
 
 THD_FUNCTION (canRxThread, arg)
@@ -14,47 +25,119 @@ THD_FUNCTION (canRxThread, arg)
 	// Set the name
 	chRegSetThreadName (config->name);
 
-	CANRxFrame rxFrame;
+	// Index the nodes by message identifier.
+	canNodeIndex_t nodeIndex;
+	canNodeIndexInit (&nodeIndex, config->nodes, config->nodeCount);
+
+	// Batch size of 0 is treated as 1.
+	uint8_t batchSize = config->batchSize;
+	if (batchSize == 0)
+		batchSize = 1;
+	if (batchSize > CAN_THREAD_BATCH_SIZE_MAX)
+		batchSize = CAN_THREAD_BATCH_SIZE_MAX;
+
+	CANRxFrame rxFrames [CAN_THREAD_BATCH_SIZE_MAX];
+	systime_t rxTimes [CAN_THREAD_BATCH_SIZE_MAX];
 
 	systime_t timeCurrent = chVTGetSystemTimeX ();
 	systime_t timePrevious;
 
+	// Queue the nodes by timeout deadline.
+	canNodeTimeoutQueue_t timeoutQueue;
+	canNodeTimeoutQueueInit (&timeoutQueue, config->nodes, config->nodeCount, timeCurrent);
+	sysinterval_t timeout = canNodeTimeoutQueueCheck (&timeoutQueue, timeCurrent);
+
 	while (true)
 	{
-		// Block until the next message arrives, or timeout check, whichever is first
-		msg_t result = canReceiveTimeout (config->driver, CAN_ANY_MAILBOX, &rxFrame, config->period);
+		// Block until the next message arrives, or the next timeout deadline, whichever is first. Each message is timestamped
+		// as it is received, rather than once the batch is drained.
+		uint8_t frameCount = 0;
+		if (canReceiveTimeout (config->driver, CAN_ANY_MAILBOX, &rxFrames [0], timeout) == MSG_OK)
+		{
+			rxTimes [0] = chVTGetSystemTimeX ();
+
+			// Drain any other pending messages from either FIFO, without blocking.
+			frameCount = 1;
+			while (frameCount < batchSize &&
+				canReceiveTimeout (config->driver, CAN_ANY_MAILBOX, &rxFrames [frameCount], TIME_IMMEDIATE) == MSG_OK)
+			{
+				rxTimes [frameCount] = chVTGetSystemTimeX ();
+				++frameCount;
+			}
+		}
+
 		timePrevious = timeCurrent;
 		timeCurrent = chVTGetSystemTimeX ();
 
-		if (result == MSG_OK)
+		// Dispatch the batch
+		for (uint8_t index = 0; index < frameCount; ++index)
+			handleFrame (config, &nodeIndex, &rxFrames [index], rxTimes [index]);
+
+		// Publish any snapshots whose triggers were completed by the batch.
+		if (frameCount != 0)
+			for (uint8_t index = 0; index < config->snapshotCount; ++index)
+				canSnapshotCheck (config->snapshots [index]);
+
+		// Check node timeouts. If the timeout queue could not be created, check each node periodically.
+		if (timeoutQueue.valid)
 		{
-			// Find the handler of the message
-			if (!canNodesReceive (config->nodes, config->nodeCount, &rxFrame))
-			{
-				// If no node handled the message, pass it to the handler.
-				if (config->rxHandler != NULL)
-					config->rxHandler ((void*) config, &rxFrame);
-			}
+			timeout = canNodeTimeoutQueueCheck (&timeoutQueue, timeCurrent);
+		}
+		else
+		{
+			canNodesCheckTimeout (config->nodes, config->nodeCount, timePrevious, timeCurrent);
+			timeout = config->period;
+		}
 
-			// If a bridge driver is specified, relay the message
-			if (config->bridgeDriver != NULL)
-			{
-				// Copy the received frame into a transmit frame.
-				CANTxFrame txFrame =
-				{
-					.SID	= rxFrame.SID,
-					.EID	= rxFrame.EID,
-					.DLC	= rxFrame.DLC
-				};
-				memcpy (txFrame.data8, rxFrame.data8, rxFrame.DLC);
-
-				// Re-transmit the frame on the bridge interface.
-				canTransmitTimeout (config->bridgeDriver, CAN_ANY_MAILBOX, &txFrame, config->period);
-			}
+		// Sample the bus error state, waking no later than the monitor's next sample.
+		if (config->monitor != NULL)
+		{
+			sysinterval_t monitorTimeout = canMonitorSample (config->monitor, timeCurrent);
+			if (monitorTimeout < timeout)
+				timeout = monitorTimeout;
 		}
+	}
+}
+
+static void handleFrame (const canThreadConfig_t* config, canNodeIndex_t* nodeIndex, CANRxFrame* rxFrame, systime_t timeReceived)
+{
+	// Record the message, if capturing.
+	if (config->capture != NULL)
+		canCaptureRecord (config->capture, config->captureChannel, rxFrame, timeReceived);
+
+	// Find the handler of the message. The thread's own nodes take precedence, such that a worker claiming every message does
+	// not take the messages of the thread's nodes. Messages claimed by a worker are handled by its thread instead.
+	if (!canNodeIndexReceive (nodeIndex, rxFrame) && !canWorkersDispatch (config->workers, config->workerCount, rxFrame))
+	{
+		// If no node handled the message, pass it to the handler.
+		if (config->rxHandler != NULL)
+			config->rxHandler ((void*) config, rxFrame);
+	}
 
-		// Check node timeouts
-		canNodesCheckTimeout (config->nodes, config->nodeCount, timePrevious, timeCurrent);
+	// Skip bridging if the message does not need forwarding
+	if (config->bridge == NULL && config->bridgeDriver == NULL)
+		return;
+	if (!canBridgeRulesCheck (config->bridgeRules, config->bridgeRuleCount, rxFrame, timeReceived))
+		return;
+
+	// If a bridge is specified, queue the message for re-transmission
+	if (config->bridge != NULL)
+		canBridgeForward (config->bridge, rxFrame);
+
+	// If a bridge driver is specified, relay the message
+	if (config->bridgeDriver != NULL)
+	{
+		// Copy the received frame into a transmit frame.
+		CANTxFrame txFrame =
+		{
+			.SID	= rxFrame->SID,
+			.EID	= rxFrame->EID,
+			.DLC	= rxFrame->DLC
+		};
+		memcpy (txFrame.data8, rxFrame->data8, rxFrame->DLC);
+
+		// Re-transmit the frame on the bridge interface.
+		canTransmitTimeout (config->bridgeDriver, CAN_ANY_MAILBOX, &txFrame, config->period);
 	}
 }
 
@@ -65,4 +148,136 @@ void canThreadStart (void* workingArea, size_t workingAreaSize, tprio_t priority
 	// Create and start the thread
 	// - We are trusting the thread and RX handler to not modify the config, hence the cast.
 	chThdCreateStatic (workingArea, workingAreaSize, priority, canRxThread, (void*) config);
+}
+
+/**
+ * @brief Packs the identifiers of a CAN thread into a set of filter banks.
+ * @param config The configuration of the thread, may be @c NULL .
+ * @param banks Array to write the bank configurations into.
+ * @param bankCount The maximum number of banks to use.
+ * @return The number of banks used, or -1 if the identifiers could not be packed.
+ */
+static int8_t packFilters (const canThreadConfig_t* config, canFilterBank_t* banks, uint8_t bankCount)
+{
+	static canId_t ids [CAN_FILTER_ID_COUNT_MAX];
+
+	// Unused interfaces don't need any filters.
+	if (config == NULL)
+		return 0;
+
+	// Threads that must see every message need to accept everything.
+	bool acceptAll = config->bridgeDriver != NULL || config->bridge != NULL || (config->rxHandler != NULL && config->rxHandlerIds == NULL);
+
+	// Gather the identifiers of each node, followed by the identifiers of the RX handler.
+	int16_t idCount = canNodesGetIds (config->nodes, config->nodeCount, ids, CAN_FILTER_ID_COUNT_MAX);
+	if (idCount < 0 || idCount + config->rxHandlerIdCount > CAN_FILTER_ID_COUNT_MAX)
+		acceptAll = true;
+
+	// Followed by the identifiers claimed by each worker.
+	for (uint8_t workerIndex = 0; workerIndex < config->workerCount && !acceptAll; ++workerIndex)
+	{
+		canWorker_t* worker = config->workers [workerIndex];
+		if (worker->claimAll || idCount + config->rxHandlerIdCount + worker->idCount > CAN_FILTER_ID_COUNT_MAX)
+		{
+			acceptAll = true;
+			break;
+		}
+
+		// Place the worker's identifiers after the node identifiers, leaving room for the RX handler's.
+		for (uint16_t index = 0; index < worker->idCount; ++index)
+			ids [idCount + index] = worker->ids [index];
+		idCount += worker->idCount;
+	}
+
+	if (acceptAll)
+	{
+		if (bankCount < 1)
+			return -1;
+
+		banks [0] = canFilterAcceptAll ();
+		return 1;
+	}
+
+	for (uint16_t index = 0; index < config->rxHandlerIdCount; ++index)
+		ids [idCount + index] = config->rxHandlerIds [index];
+
+	return canFilterPack (ids, idCount + config->rxHandlerIdCount, banks, bankCount);
+}
+
+bool canThreadsConfigureFilters (const canThreadConfig_t* can1Config, const canThreadConfig_t* can2Config)
+{
+	static canFilterBank_t banks [CAN_FILTER_BANK_COUNT];
+	static CANFilter filters [CAN_FILTER_BANK_COUNT];
+
+	// Determine how many banks each interface needs if given all of them.
+	int8_t can1Count = packFilters (can1Config, banks, CAN_FILTER_BANK_COUNT);
+	int8_t can2Count = packFilters (can2Config, banks, CAN_FILTER_BANK_COUNT);
+	if (can1Count < 0 || can2Count < 0)
+		return false;
+
+	// CAN1 always needs at least 1 bank, as CAN2's banks must start at bank 1 or later (see canSTM32SetFilters). If CAN1 has no
+	// identifiers, this bank rejects everything.
+	if (can1Count == 0)
+		can1Count = 1;
+
+	// If the banks are over-subscribed, split them proportionally to each interface's requirement. Each interface requires at
+	// most 2 banks (1 standard, 1 extended) if its identifiers are merged entirely.
+	uint8_t can1Budget = can1Count;
+	if (can1Count + can2Count > CAN_FILTER_BANK_COUNT)
+	{
+		can1Budget = CAN_FILTER_BANK_COUNT * can1Count / (can1Count + can2Count);
+		if (can1Budget < 2)
+			can1Budget = 2;
+		if (can1Budget > CAN_FILTER_BANK_COUNT - 2)
+			can1Budget = CAN_FILTER_BANK_COUNT - 2;
+	}
+
+	// CAN2's banks must also start before the last bank, so CAN1 can't use every bank, even if CAN2 is unused.
+	if (can1Budget > CAN_FILTER_BANK_COUNT - 1)
+		can1Budget = CAN_FILTER_BANK_COUNT - 1;
+
+	// Pack CAN1's banks at the start, followed by CAN2's.
+	can1Count = packFilters (can1Config, banks, can1Budget);
+	if (can1Count < 0)
+		return false;
+
+	if (can1Count == 0)
+	{
+		banks [0] = canFilterRejectAll ();
+		can1Count = 1;
+	}
+
+	can2Count = packFilters (can2Config, banks + can1Count, CAN_FILTER_BANK_COUNT - can1Count);
+	if (can2Count < 0)
+		return false;
+
+	// The receive functions always drain FIFO 0 before FIFO 1, so spreading the banks over both FIFOs re-orders messages of
+	// different identifiers. Threads bridging or capturing the bus keep the order by only using FIFO 0.
+	bool can1Ordered = can1Config != NULL &&
+		(can1Config->bridge != NULL || can1Config->bridgeDriver != NULL || can1Config->capture != NULL);
+	bool can2Ordered = can2Config != NULL &&
+		(can2Config->bridge != NULL || can2Config->bridgeDriver != NULL || can2Config->capture != NULL);
+
+	uint8_t bankCount = can1Count + can2Count;
+	for (uint8_t index = 0; index < bankCount; ++index)
+	{
+		bool ordered = index < can1Count ? can1Ordered : can2Ordered;
+
+		filters [index] = (CANFilter)
+		{
+			.filter		= index,
+			.mode		= banks [index].mode == CAN_FILTER_MODE_LIST ? 1 : 0,
+			.scale		= banks [index].scale == CAN_FILTER_SCALE_32 ? 1 : 0,
+
+			// Otherwise, alternate between the 2 receive FIFOs, doubling the number of messages the hardware can buffer. As
+			// identifiers are always assigned to the same FIFO, messages of the same identifier are still received in order.
+			.assignment	= ordered ? 0 : index % 2,
+			.register1	= banks [index].register1,
+			.register2	= banks [index].register2
+		};
+	}
+
+	// CAN2's banks start immediately after CAN1's.
+	canSTM32SetFilters (&CAND1, can1Count, bankCount, filters);
+	return true;
 }
\ No newline at end of file
@@ -8,19 +8,47 @@
 //
 // Description: Thread object for receiving and handling messages from a CAN driver. The thread polls the CAN driver until a
 //   message is received. If the message belongs a known CAN node, its handler will be invoked. If the CAN message does not
-//   belong to a known node, the generic handler will be invoked.
+//   belong to a known node, the generic handler will be invoked. Upon starting, the thread indexes its nodes by message
+//   identifier (see @c canNodeIndex_t ), so each message is delivered directly to the node that owns it. The nodes are also
+//   queued by timeout deadline (see @c canNodeTimeoutQueue_t ), so only nodes whose deadlines have expired are checked, and
+//   the thread sleeps until either a message is received or the next deadline expires. Received messages are handled in
+//   batches: once woken, the thread drains both RX FIFOs (up to the configured batch size) before dispatching the messages
+//   and performing any housekeeping, so a burst of messages costs a single wakeup.
+//
+//   Optionally, classes of messages can be handed off to worker threads (see @c canWorker_t ). In this case, the thread acts
+//   as a dispatcher for the messages claimed by a worker, only queuing them for the worker. This allows slow handlers to be
+//   isolated from time-critical ones, by running them in separate, lower priority workers. The thread should be given a
+//   higher priority than each of its workers.
+//
+//   Optionally, the thread samples the bus error state through a monitor (see @c canMonitor_t ), which may also recover the
+//   peripheral from bus-off automatically.
 
 // Includes -------------------------------------------------------------------------------------------------------------------
 
 // Includes
+#include "can_bridge.h"
+#include "can_capture.h"
+#include "can_filter.h"
+#include "can_monitor.h"
 #include "can_node.h"
+#include "can_snapshot.h"
+#include "can_worker.h"
 
 // ChibiOS
 #include "hal.h"
 
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+#ifndef CAN_THREAD_BATCH_SIZE_MAX
+/// @brief The maximum number of messages a CAN thread may receive in a single batch. Note the bxCAN peripheral has 2 RX FIFOs
+/// of 3 messages each, so batches larger than 6 are only filled if messages arrive while the batch is being drained.
+#define CAN_THREAD_BATCH_SIZE_MAX 6
+#endif // CAN_THREAD_BATCH_SIZE_MAX
+
 // Datatypes ------------------------------------------------------------------------------------------------------------------
 
-#define CAN_THREAD_WORKING_AREA(name) THD_WORKING_AREA (name, 512)
+#define CAN_THREAD_WORKING_AREA(name) THD_WORKING_AREA (name, 512 + sizeof (canNodeIndex_t) + sizeof (canNodeTimeoutQueue_t)	\
+	+ CAN_THREAD_BATCH_SIZE_MAX * sizeof (CANRxFrame) + CAN_THREAD_BATCH_SIZE_MAX * sizeof (systime_t))
 
 typedef struct
 {
@@ -30,7 +58,9 @@ typedef struct
 	/// @brief The CAN driver the receive from.
 	CANDriver* driver;
 
-	/// @brief The minimum period to check the CAN node timeouts at.
+	/// @brief The period to check the CAN node timeouts at, only used if the nodes exceed the capacity of the timeout queue
+	/// (see @c CAN_NODE_TIMEOUT_QUEUE_SIZE ). Otherwise, timeouts are checked exactly at each node's deadline. Also used as the
+	/// timeout for re-transmitting messages on the @c bridgeDriver .
 	sysinterval_t period;
 
 	/// @brief The array of CAN nodes to receive for (array of pointers).
@@ -39,13 +69,63 @@ typedef struct
 	/// @brief The number of elements in the @c nodes array.
 	uint16_t nodeCount;
 
+	/// @brief The maximum number of messages to receive before dispatching them. Must not exceed
+	/// @c CAN_THREAD_BATCH_SIZE_MAX . A value of 0 or 1 handles each message as it is received.
+	uint8_t batchSize;
+
 	/// @brief Handler to invoke upon receiving an unknown CAN message.
 	canReceiveHandler_t* rxHandler;
 
+	/// @brief Identifiers of the messages the @c rxHandler expects, in addition to those belonging to @c nodes . Only used by
+	/// @c canThreadsConfigureFilters . If @c NULL while an @c rxHandler is specified, all messages are accepted.
+	const canId_t* rxHandlerIds;
+
+	/// @brief The number of elements in the @c rxHandlerIds array.
+	uint16_t rxHandlerIdCount;
+
 	/// @brief CAN driver to re-transmit received messages on. This is used to virtually bridge to CAN busses, while
 	/// maintaining electrical separation. Note this re-transmission is uni-directional, to create a bi-directional bridge, a
 	/// separate CAN thread should be instanced for the other driver.
+	/// @note Re-transmission is performed by the receiving thread, so a congested bridge bus will stall reception. Prefer
+	/// using @c bridge instead.
 	CANDriver* bridgeDriver;
+
+	/// @brief Bridge to forward received messages to. Unlike @c bridgeDriver , messages are queued and re-transmitted by the
+	/// bridge's own thread (see @c canBridge_t ). May be @c NULL .
+	canBridge_t* bridge;
+
+	/// @brief Table of rules selecting which messages are forwarded to the @c bridge or @c bridgeDriver (see
+	/// @c canBridgeRule_t ). If @c NULL , all messages are forwarded.
+	canBridgeRule_t* bridgeRules;
+
+	/// @brief The number of elements in the @c bridgeRules array.
+	uint16_t bridgeRuleCount;
+
+	/// @brief Array of workers to dispatch messages to (array of pointers), in order of precedence. Each message claimed by a
+	/// worker is queued for it rather than being handled by this thread. Messages belonging to this thread's @c nodes are
+	/// never dispatched, even if a worker claims them. The @c rxHandler only receives messages not claimed by any worker.
+	/// May be @c NULL .
+	canWorker_t** workers;
+
+	/// @brief The number of elements in the @c workers array.
+	uint8_t workerCount;
+
+	/// @brief Array of snapshots whose triggers to check after each batch of messages (array of pointers, see
+	/// @c canSnapshot_t ). The trigger messages should belong to this thread's nodes, rather than a worker's. May be @c NULL .
+	canSnapshot_t** snapshots;
+
+	/// @brief The number of elements in the @c snapshots array.
+	uint8_t snapshotCount;
+
+	/// @brief Capture to record received messages into (see @c canCapture_t ). May be @c NULL .
+	canCapture_t* capture;
+
+	/// @brief The channel to identify this thread's bus by in the @c capture (ex. 0 for CAN1, 1 for CAN2).
+	uint8_t captureChannel;
+
+	/// @brief Monitor to sample the bus error state with (see @c canMonitor_t ). The monitor's driver must be this thread's
+	/// @c driver . May be @c NULL .
+	canMonitor_t* monitor;
 } canThreadConfig_t;
 
 // Functions ------------------------------------------------------------------------------------------------------------------
@@ -60,4 +140,23 @@ typedef struct
  */
 void canThreadStart (void* workingArea, size_t workingAreaSize, tprio_t priority, const canThreadConfig_t* config);
 
+/**
+ * @brief Configures the bxCAN hardware filters such that each CAN thread is only woken by the messages it handles. The
+ * identifiers of each thread's nodes (and @c rxHandlerIds ) are packed into the filter banks shared by CAN1 and CAN2, merging
+ * identifiers into mask mode banks if the banks are exhausted. See the @c can_filter module for details.
+ * @note This must be called before either CAN driver is started.
+ * @note A thread's bus accepts all messages if the thread has a @c bridgeDriver or @c bridge , has an @c rxHandler without
+ * @c rxHandlerIds , has a node that cannot identify its messages, or has a worker that claims every message. The identifiers
+ * claimed by each worker are included in the thread's filters, so workers must be initialized beforehand.
+ * @note The banks alternate between the 2 receive FIFOs, which are drained FIFO 0 first, so messages of different
+ * identifiers may be handled out of their order of arrival (messages of the same identifier stay in order). Threads with a
+ * @c bridge , @c bridgeDriver or @c capture only use FIFO 0, preserving the order of every message they forward or record.
+ * @note The hardware requires CAN2's banks to start between bank 1 and the last bank, so CAN1 always occupies at least 1 bank
+ * (rejecting everything if CAN1 is unused), and never every bank.
+ * @param can1Config The configuration of the thread receiving from CAN1, or @c NULL if not used.
+ * @param can2Config The configuration of the thread receiving from CAN2, or @c NULL if not used.
+ * @return True if successful, false if the identifiers could not be packed. In the latter case, the filters are not modified.
+ */
+bool canThreadsConfigureFilters (const canThreadConfig_t* can1Config, const canThreadConfig_t* can2Config);
+
 #endif // CAN_THREAD_H
\ No newline at end of file
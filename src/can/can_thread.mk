@@ -4,7 +4,13 @@ define CAN_THREAD_MK
 endef
 
 # Include the module's common dependencies
+include common/src/can/can_bridge.mk
+include common/src/can/can_capture.mk
+include common/src/can/can_filter.mk
+include common/src/can/can_monitor.mk
 include common/src/can/can_node.mk
+include common/src/can/can_snapshot.mk
+include common/src/can/can_worker.mk
 
 # Add the module's source file to the compilation
 CSRC += common/src/can/can_thread.c
@@ -0,0 +1,186 @@
+// Header
+#include "can_tx_scheduler.h"
+
+// Function Prototypes --------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Assigns the initial deadline of each message of a scheduler.
+ * @param config The configuration of the scheduler.
+ * @param timeStart The time the scheduler started at.
+ */
+static void scheduleMessages (const canTxSchedulerConfig_t* config, systime_t timeStart);
+
+/**
+ * @brief Finds the message that should be transmitted next.
+ * @param config The configuration of the scheduler.
+ * @param timeReference A time before all deadlines, used to compare deadlines.
+ * @param timeCurrent The current time.
+ * @param due Written to indicate whether the message is due.
+ * @return The highest priority message that is due, or, if no message is due, the message with the earliest deadline.
+ */
+static canTxMessage_t* nextMessage (const canTxSchedulerConfig_t* config, systime_t timeReference, systime_t timeCurrent,
+	bool* due);
+
+/**
+ * @brief Transmits a message and schedules its next deadline.
+ * @param config The configuration of the scheduler.
+ * @param message The message to transmit.
+ * @param timeCurrent The current time, must be at or after the message's deadline.
+ */
+static void transmitMessage (const canTxSchedulerConfig_t* config, canTxMessage_t* message, systime_t timeCurrent);
+
+// Thread Entrypoint ----------------------------------------------------------------------------------------------------------
+
+THD_FUNCTION (canTxSchedulerThread, arg)
+{
+	// Only argument is config
+	const canTxSchedulerConfig_t* config = (canTxSchedulerConfig_t*) arg;
+
+	// Set the name
+	chRegSetThreadName (config->name);
+
+	// Nothing to do if no messages are specified.
+	if (config->messageCount == 0)
+		return;
+
+	systime_t timeReference = chVTGetSystemTimeX ();
+	scheduleMessages (config, timeReference);
+
+	while (true)
+	{
+		// Transmit each message that is due. Note each message's next deadline is after the time it was transmitted at, so
+		// this ends once all due messages have been handled.
+		systime_t timeCurrent = chVTGetSystemTimeX ();
+		bool due;
+		canTxMessage_t* message = nextMessage (config, timeReference, timeCurrent, &due);
+		while (due)
+		{
+			transmitMessage (config, message, timeCurrent);
+
+			timeCurrent = chVTGetSystemTimeX ();
+			message = nextMessage (config, timeReference, timeCurrent, &due);
+		}
+
+		// All deadlines are now after the current time, so they can be compared relative to it.
+		timeReference = timeCurrent;
+
+		// Sleep until the next deadline.
+		chThdSleep (chTimeDiffX (timeCurrent, message->deadline));
+	}
+}
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+bool canTxSchedulerStart (void* workingArea, size_t workingAreaSize, tprio_t priority, const canTxSchedulerConfig_t* config)
+{
+	// Each message's period is used to schedule (and stagger) its deadlines, so must be non-zero.
+	for (uint16_t index = 0; index < config->messageCount; ++index)
+		if (config->messages [index].period == 0)
+			return false;
+
+	// Create and start the thread
+	// - We are trusting the thread to only modify the state fields of the messages, hence the cast.
+	chThdCreateStatic (workingArea, workingAreaSize, priority, canTxSchedulerThread, (void*) config);
+	return true;
+}
+
+static void scheduleMessages (const canTxSchedulerConfig_t* config, systime_t timeStart)
+{
+	// Find the shortest period, the messages are staggered across this.
+	sysinterval_t periodMin = config->messages [0].period;
+	for (uint16_t index = 1; index < config->messageCount; ++index)
+		if (config->messages [index].period < periodMin)
+			periodMin = config->messages [index].period;
+
+	sysinterval_t spacing = periodMin / config->messageCount;
+	if (spacing == 0)
+		spacing = 1;
+
+	for (uint16_t index = 0; index < config->messageCount; ++index)
+	{
+		canTxMessage_t* message = &config->messages [index];
+
+		if (config->stagger)
+			message->offset = (index * spacing) % message->period;
+
+		// Deadlines must be after the start time, so the first deadline is at least one tick in.
+		message->deadline		= chTimeAddX (timeStart, message->offset == 0 ? 1 : message->offset);
+		message->jitterLast		= 0;
+		message->jitterMax		= 0;
+		message->transmitCount	= 0;
+		message->missCount		= 0;
+	}
+}
+
+static canTxMessage_t* nextMessage (const canTxSchedulerConfig_t* config, systime_t timeReference, systime_t timeCurrent,
+	bool* due)
+{
+	sysinterval_t elapsed = chTimeDiffX (timeReference, timeCurrent);
+	canTxMessage_t* next = NULL;
+	*due = false;
+
+	for (uint16_t index = 0; index < config->messageCount; ++index)
+	{
+		canTxMessage_t* message = &config->messages [index];
+		sysinterval_t remaining = chTimeDiffX (timeReference, message->deadline);
+		bool messageDue = remaining <= elapsed;
+
+		if (next == NULL)
+		{
+			next = message;
+			*due = messageDue;
+			continue;
+		}
+
+		// Due messages take precedence, then priority, then earliest deadline.
+		if (messageDue != *due)
+		{
+			if (messageDue)
+			{
+				next = message;
+				*due = true;
+			}
+			continue;
+		}
+
+		if (messageDue && message->priority != next->priority)
+		{
+			if (message->priority < next->priority)
+				next = message;
+			continue;
+		}
+
+		if (remaining < chTimeDiffX (timeReference, next->deadline))
+			next = message;
+	}
+
+	return next;
+}
+
+static void transmitMessage (const canTxSchedulerConfig_t* config, canTxMessage_t* message, systime_t timeCurrent)
+{
+	// Measure the jitter of this transmission.
+	sysinterval_t jitter = chTimeDiffX (message->deadline, timeCurrent);
+	message->jitterLast = jitter;
+	if (jitter > message->jitterMax)
+		message->jitterMax = jitter;
+
+	// Schedule the next deadline, skipping any slots that have already passed.
+	sysinterval_t missed = jitter / message->period;
+	message->missCount += missed;
+	message->deadline = chTimeAddX (message->deadline, (missed + 1) * message->period);
+
+	// Pack the message, exit early if this slot should be skipped.
+	CANTxFrame frame =
+	{
+		.IDE = CAN_IDE_STD,
+		.RTR = CAN_RTR_DATA
+	};
+	if (!message->packHandler (message->object, &frame))
+		return;
+
+	if (canTransmitTimeout (config->driver, CAN_ANY_MAILBOX, &frame, config->transmitTimeout) == MSG_OK)
+		++message->transmitCount;
+	else
+		++message->missCount;
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#ifndef CAN_TX_SCHEDULER_H
+#define CAN_TX_SCHEDULER_H
+
+// CAN Transmit Scheduler -----------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Thread object for transmitting periodic CAN messages. The scheduler owns a table of messages, each with a
+//   period, phase offset, priority, and a callback used to pack the message's frame immediately before it is transmitted.
+//   Offsets can be assigned automatically, staggering the messages across the shortest period to flatten the bus load.
+//
+//   For each message, the scheduler measures the jitter of each transmission (the delay between the message's deadline and
+//   the start of its transmission) and counts the number of slots the message missed (either due to the scheduler falling
+//   behind, or the transmission timing out).
+//
+//   Example usage:
+//
+//   static bool packTorqueRequest (void* object, CANTxFrame* frame)
+//   {
+//       // Fill the frame's ID, DLC, and data, or return false to skip this slot.
+//   }
+//
+//   static canTxMessage_t messages [] =
+//   {
+//       { .period = TIME_MS2I (10), .priority = 0, .packHandler = packTorqueRequest, .object = &amk },
+//       { .period = TIME_MS2I (500), .priority = 1, .packHandler = packChargerCommand, .object = &charger }
+//   };
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// ChibiOS
+#include "hal.h"
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+#define CAN_TX_SCHEDULER_WORKING_AREA(name) THD_WORKING_AREA (name, 512)
+
+/**
+ * @brief Callback for packing a periodic message, called immediately before the message is transmitted.
+ * @param object The object the message belongs to ( @c object field of the message).
+ * @param frame The frame to write the message's identifier, DLC, and data into.
+ * @return True to transmit the message, false to skip this slot.
+ */
+typedef bool (canTxPackHandler_t) (void* object, CANTxFrame* frame);
+
+/**
+ * @brief Periodic message of a transmit scheduler. Messages should be instanced in an array using designated initializers
+ * for the configuration fields, the remaining fields are used by the scheduler and should be left zero.
+ */
+typedef struct
+{
+	/// @brief The period to transmit the message at. Must not be 0.
+	sysinterval_t period;
+
+	/// @brief The time of the message's first transmission, relative to the scheduler starting. Ignored if the scheduler's
+	/// @c stagger option is set.
+	sysinterval_t offset;
+
+	/// @brief The priority of the message, lower values indicating a higher priority. When multiple messages are due, the
+	/// message with the highest priority is transmitted first.
+	uint8_t priority;
+
+	/// @brief The callback to pack the message with.
+	canTxPackHandler_t* packHandler;
+
+	/// @brief Argument to pass to the @c packHandler .
+	void* object;
+
+	/// @brief The next time the message is due to be transmitted.
+	systime_t deadline;
+
+	/// @brief The jitter of the message's last transmission, in system ticks.
+	volatile sysinterval_t jitterLast;
+
+	/// @brief The largest jitter of any of the message's transmissions, in system ticks.
+	volatile sysinterval_t jitterMax;
+
+	/// @brief The total number of times the message has been transmitted.
+	volatile uint32_t transmitCount;
+
+	/// @brief The total number of slots in which the message was due, but not transmitted. This includes slots skipped due
+	/// to the scheduler falling behind and transmissions that timed-out, but not slots skipped by the @c packHandler .
+	volatile uint32_t missCount;
+} canTxMessage_t;
+
+typedef struct
+{
+	/// @brief Name to give the thread, used for debugging.
+	const char* name;
+
+	/// @brief The CAN driver to transmit on.
+	CANDriver* driver;
+
+	/// @brief The array of messages to transmit.
+	canTxMessage_t* messages;
+
+	/// @brief The number of elements in the @c messages array.
+	uint16_t messageCount;
+
+	/// @brief Indicates whether the messages' offsets should be assigned automatically. If set, the messages are spread
+	/// evenly across the shortest period of any message.
+	bool stagger;
+
+	/// @brief The timeout of each transmission. Should be less than the shortest period of any message.
+	sysinterval_t transmitTimeout;
+} canTxSchedulerConfig_t;
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Creates a thread transmitting the specified messages.
+ * @param workingArea The working area to provide the thread. One instance must be created per thread. Should be instanced
+ * using the @c CAN_TX_SCHEDULER_WORKING_AREA macro.
+ * @param workingAreaSize The size of the thread's @c workingArea . Should be obtained using @c sizeof(workingArea) .
+ * @param priority The priority to assign the thread.
+ * @param config The configuration to provide the thread.
+ * @return False if the configuration is invalid (a message has a period of 0), in which case the thread is not started. True
+ * otherwise.
+ */
+bool canTxSchedulerStart (void* workingArea, size_t workingAreaSize, tprio_t priority, const canTxSchedulerConfig_t* config);
+
+#endif // CAN_TX_SCHEDULER_H
\ No newline at end of file
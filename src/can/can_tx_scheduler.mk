@@ -0,0 +1,9 @@
+ifndef CAN_TX_SCHEDULER_MK
+define CAN_TX_SCHEDULER_MK
+1
+endef
+
+# Add the module's source file to the compilation
+CSRC += common/src/can/can_tx_scheduler.c
+
+endif # CAN_TX_SCHEDULER_MK
\ No newline at end of file
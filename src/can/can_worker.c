@@ -0,0 +1,134 @@
+// Header
+#include "can_worker.h"
+
+// Thread Entrypoint ----------------------------------------------------------------------------------------------------------
+
+THD_FUNCTION (canWorkerThread, arg)
+{
+	// Only argument is the worker
+	canWorker_t* worker = (canWorker_t*) arg;
+	const canWorkerConfig_t* config = worker->config;
+
+	// Set the name
+	chRegSetThreadName (config->name);
+
+	// Index the nodes by message identifier.
+	canNodeIndex_t nodeIndex;
+	canNodeIndexInit (&nodeIndex, config->nodes, config->nodeCount);
+
+	systime_t timeCurrent = chVTGetSystemTimeX ();
+	systime_t timePrevious;
+
+	// Queue the nodes by timeout deadline.
+	canNodeTimeoutQueue_t timeoutQueue;
+	canNodeTimeoutQueueInit (&timeoutQueue, config->nodes, config->nodeCount, timeCurrent);
+	sysinterval_t timeout = canNodeTimeoutQueueCheck (&timeoutQueue, timeCurrent);
+
+	CANRxFrame rxFrame;
+
+	while (true)
+	{
+		// Block until the next message is dispatched, or the next timeout deadline, whichever is first
+		bool received = canQueuePop (&worker->queue, &rxFrame, timeout);
+
+		timePrevious = timeCurrent;
+		timeCurrent = chVTGetSystemTimeX ();
+
+		// Find the handler of the message
+		if (received && !canNodeIndexReceive (&nodeIndex, &rxFrame))
+		{
+			// If no node handled the message, pass it to the handler.
+			if (config->rxHandler != NULL)
+				config->rxHandler ((void*) config, &rxFrame);
+		}
+
+		// Check node timeouts. If the timeout queue could not be created, check each node periodically.
+		if (timeoutQueue.valid)
+		{
+			timeout = canNodeTimeoutQueueCheck (&timeoutQueue, timeCurrent);
+		}
+		else
+		{
+			canNodesCheckTimeout (config->nodes, config->nodeCount, timePrevious, timeCurrent);
+			timeout = config->period;
+		}
+	}
+}
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+void canWorkerInit (canWorker_t* worker, const canWorkerConfig_t* config)
+{
+	worker->config		= config;
+	worker->idCount		= 0;
+	worker->claimAll	= false;
+
+	canQueueInit (&worker->queue, config->buffer, config->bufferSize, config->overflowPolicy);
+
+	// Gather the identifiers of each node, followed by the identifiers of the RX handler.
+	int16_t idCount = canNodesGetIds (config->nodes, config->nodeCount, worker->ids, CAN_WORKER_ID_COUNT_MAX);
+	if (idCount < 0 || idCount + config->rxHandlerIdCount > CAN_WORKER_ID_COUNT_MAX ||
+		(config->rxHandler != NULL && config->rxHandlerIds == NULL))
+	{
+		worker->claimAll = true;
+		return;
+	}
+
+	for (uint16_t index = 0; index < config->rxHandlerIdCount; ++index)
+		worker->ids [idCount + index] = config->rxHandlerIds [index];
+	worker->idCount = idCount + config->rxHandlerIdCount;
+
+	// Insertion sort, for binary searching.
+	for (uint16_t index = 1; index < worker->idCount; ++index)
+	{
+		canId_t id = worker->ids [index];
+		uint16_t position = index;
+		while (position > 0 && worker->ids [position - 1] > id)
+		{
+			worker->ids [position] = worker->ids [position - 1];
+			--position;
+		}
+		worker->ids [position] = id;
+	}
+}
+
+void canWorkerStart (canWorker_t* worker, void* workingArea, size_t workingAreaSize, tprio_t priority)
+{
+	chThdCreateStatic (workingArea, workingAreaSize, priority, canWorkerThread, worker);
+}
+
+bool canWorkerClaims (canWorker_t* worker, canId_t id)
+{
+	if (worker->claimAll)
+		return true;
+
+	// Binary search for the identifier.
+	uint16_t lower = 0;
+	uint16_t upper = worker->idCount;
+	while (lower < upper)
+	{
+		uint16_t middle = lower + (upper - lower) / 2;
+		if (worker->ids [middle] < id)
+			lower = middle + 1;
+		else
+			upper = middle;
+	}
+
+	return lower < worker->idCount && worker->ids [lower] == id;
+}
+
+bool canWorkersDispatch (canWorker_t** workers, uint8_t workerCount, const CANRxFrame* frame)
+{
+	canId_t id = canIdFromFrame (frame);
+
+	for (uint8_t index = 0; index < workerCount; ++index)
+	{
+		if (canWorkerClaims (workers [index], id))
+		{
+			canQueuePush (&workers [index]->queue, frame);
+			return true;
+		}
+	}
+
+	return false;
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+#ifndef CAN_WORKER_H
+#define CAN_WORKER_H
+
+// CAN Worker -----------------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Thread object for handling a class of CAN messages on behalf of a CAN thread. By default, a CAN thread handles
+//   every message it receives itself, so a slow handler (ex. an EEPROM command performing I2C writes) delays every other
+//   message on the bus. Instead, the CAN thread can act as a dispatcher: it only classifies each message and forwards it into
+//   the queue (see @c canQueue_t ) of the worker that owns it. Each worker runs at its own priority, so time-critical messages
+//   (ex. inverter feedback) are handled promptly regardless of the load on lower priority workers.
+//
+//   A worker owns its nodes entirely: it handles their messages and checks their timeouts. A worker claims a message if one of
+//   its nodes or its @c rxHandlerIds identifies it. A worker whose messages cannot be identified (a node without a
+//   @c canIdHandler_t , or an @c rxHandler without @c rxHandlerIds ) claims every message not claimed by a preceding worker.
+//   In either case, messages belonging to the dispatching CAN thread's own nodes are handled by the CAN thread, and are never
+//   dispatched to a worker.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// Includes
+#include "can_node.h"
+#include "can_queue.h"
+
+// ChibiOS
+#include "hal.h"
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+#ifndef CAN_WORKER_ID_COUNT_MAX
+/// @brief The maximum number of identifiers a single worker can claim. If exceeded, the worker claims every message.
+#define CAN_WORKER_ID_COUNT_MAX 32
+#endif // CAN_WORKER_ID_COUNT_MAX
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+#define CAN_WORKER_WORKING_AREA(name) THD_WORKING_AREA (name, 512 + sizeof (canNodeIndex_t) + sizeof (canNodeTimeoutQueue_t))
+
+typedef struct
+{
+	/// @brief Name to give the worker's thread, used for debugging.
+	const char* name;
+
+	/// @brief The period to check the CAN node timeouts at, only used if the nodes exceed the capacity of the timeout queue
+	/// (see @c CAN_NODE_TIMEOUT_QUEUE_SIZE ).
+	sysinterval_t period;
+
+	/// @brief The array of CAN nodes to handle the messages of (array of pointers).
+	canNode_t** nodes;
+
+	/// @brief The number of elements in the @c nodes array.
+	uint16_t nodeCount;
+
+	/// @brief Handler to invoke upon receiving a message not belonging to any of the @c nodes . The object passed to the handler
+	/// is this configuration.
+	canReceiveHandler_t* rxHandler;
+
+	/// @brief Identifiers of the messages the @c rxHandler expects. If @c NULL while an @c rxHandler is specified, the worker
+	/// claims every message.
+	const canId_t* rxHandlerIds;
+
+	/// @brief The number of elements in the @c rxHandlerIds array.
+	uint16_t rxHandlerIdCount;
+
+	/// @brief Buffer to queue the messages claimed by the worker in.
+	CANRxFrame* buffer;
+
+	/// @brief The number of elements in the @c buffer .
+	uint16_t bufferSize;
+
+	/// @brief The action to take when a message is claimed by the worker while its queue is full. Note that
+	/// @c CAN_QUEUE_BLOCK blocks the dispatching CAN thread.
+	canQueueOverflowPolicy_t overflowPolicy;
+} canWorkerConfig_t;
+
+typedef struct
+{
+	const canWorkerConfig_t* config;
+
+	/// @brief Queue of messages waiting to be handled by the worker.
+	canQueue_t queue;
+
+	/// @brief The identifiers of the messages claimed by the worker, sorted.
+	canId_t ids [CAN_WORKER_ID_COUNT_MAX];
+
+	/// @brief The number of valid elements in @c ids .
+	uint16_t idCount;
+
+	/// @brief Indicates whether the worker claims every message.
+	bool claimAll;
+} canWorker_t;
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes a worker using the specified configuration. The worker's nodes must already be initialized.
+ * @param worker The worker to initialize.
+ * @param config The configuration to use.
+ */
+void canWorkerInit (canWorker_t* worker, const canWorkerConfig_t* config);
+
+/**
+ * @brief Starts the thread of a worker.
+ * @param worker The worker to start, must be initialized.
+ * @param workingArea The working area to provide the thread. Should be instanced using the @c CAN_WORKER_WORKING_AREA macro.
+ * @param workingAreaSize The size of the thread's @c workingArea . Should be obtained using @c sizeof(workingArea) .
+ * @param priority The priority to assign the thread. Must not exceed the priority of the dispatching CAN thread.
+ */
+void canWorkerStart (canWorker_t* worker, void* workingArea, size_t workingAreaSize, tprio_t priority);
+
+/**
+ * @brief Checks whether a worker claims a message.
+ * @param worker The worker to check.
+ * @param id The identifier of the message.
+ * @return True if the worker claims the message, false otherwise.
+ */
+bool canWorkerClaims (canWorker_t* worker, canId_t id);
+
+/**
+ * @brief Dispatches a message to the first worker of an array that claims it. Should be called by the CAN thread receiving
+ * the message.
+ * @param workers The array of workers (array of pointers), in order of precedence.
+ * @param workerCount The number of elements in @c workers .
+ * @param frame The message to dispatch.
+ * @return True if the message was claimed by a worker, false otherwise.
+ */
+bool canWorkersDispatch (canWorker_t** workers, uint8_t workerCount, const CANRxFrame* frame);
+
+#endif // CAN_WORKER_H
\ No newline at end of file
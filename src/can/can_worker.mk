@@ -0,0 +1,13 @@
+ifndef CAN_WORKER_MK
+define CAN_WORKER_MK
+1
+endef
+
+# Include the module's common dependencies
+include common/src/can/can_node.mk
+include common/src/can/can_queue.mk
+
+# Add the module's source file to the compilation
+CSRC += common/src/can/can_worker.c
+
+endif # CAN_WORKER_MK
\ No newline at end of file
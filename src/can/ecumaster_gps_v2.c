@@ -43,10 +43,30 @@
 #define IMU1_MESSAGE_FLAG_POS			0x03
 #define UTC_MESSAGE_FLAG_POS			0x04
 
+/// @brief The ID of each message, indexed by the message's flag position.
+static const uint16_t MESSAGE_IDS [] =
+{
+	[POSITION_MESSAGE_FLAG_POS]		= POSITION_MESSAGE_ID,
+	[VELOCITY_MESSAGE_FLAG_POS]		= VELOCITY_MESSAGE_ID,
+	[HEADING_IMU0_MESSAGE_FLAG_POS]	= HEADING_IMU0_MESSAGE_ID,
+	[IMU1_MESSAGE_FLAG_POS]			= IMU1_MESSAGE_ID,
+	[UTC_MESSAGE_FLAG_POS]			= UTC_MESSAGE_ID
+};
+
 // Function Prototypes --------------------------------------------------------------------------------------------------------
 
 int8_t ecumasterReceiveHandler (void* node, CANRxFrame* frame);
 
+/**
+ * @brief Decodes a message of the node.
+ * @param gps The node to decode into.
+ * @param index The flag position of the message.
+ * @param frame The message to decode.
+ */
+static void handleMessage (ecumasterGps_t* gps, uint8_t index, CANRxFrame* frame);
+
+canId_t ecumasterIdHandler (void* node, uint8_t index);
+
 // Functions -------------------------------------------------------------------------------------------------------------------
 
 void ecumasterInit (ecumasterGps_t* gps, const ecumasterGpsConfig_t* config)
@@ -54,13 +74,49 @@ void ecumasterInit (ecumasterGps_t* gps, const ecumasterGpsConfig_t* config)
 	// Initialize the CAN node
 	canNodeConfig_t nodeConfig =
 	{
-		.driver			= config->driver,
-		.receiveHandler	= ecumasterReceiveHandler,
-		.timeoutHandler	= NULL,
-		.timeoutPeriod	= config->timeoutPeriod,
-		.messageCount	= 5
+		.driver					= config->driver,
+		.receiveHandler			= ecumasterReceiveHandler,
+		.timeoutHandler			= NULL,
+		.idHandler				= ecumasterIdHandler,
+		.timeoutPeriod			= config->timeoutPeriod,
+		.messageCount			= 5,
+		.messageTimeoutPeriods	= config->messageTimeoutPeriods
 	};
 	canNodeInit ((canNode_t*) gps, &nodeConfig);
+
+	gps->lazyDecode			= config->lazyDecode;
+	gps->lazy.pendingFlags	= 0;
+}
+
+void ecumasterDecode (ecumasterGps_t* gps)
+{
+	uint32_t pendingFlags = canNodeLazyTakePending (&gps->lazy);
+
+	// Decode each message received since the last decode, from its most recent payload.
+	for (uint8_t index = 0; pendingFlags != 0; ++index, pendingFlags >>= 1)
+	{
+		if ((pendingFlags & 1) == 0)
+			continue;
+
+		CANRxFrame frame = { .data64 = { gps->lazy.payloads [index] } };
+		handleMessage (gps, index, &frame);
+	}
+}
+
+ecumasterGpsStatus_t ecumasterGetGpsStatusLock (ecumasterGps_t* gps)
+{
+	canNodeLock ((canNode_t*) gps);
+	ecumasterGpsStatus_t status = ecumasterGetGpsStatus (gps);
+	canNodeUnlock ((canNode_t*) gps);
+	return status;
+}
+
+bool ecumasterGpsValidLock (ecumasterGps_t* gps)
+{
+	canNodeLock ((canNode_t*) gps);
+	bool valid = ecumasterGpsValid (gps);
+	canNodeUnlock ((canNode_t*) gps);
+	return valid;
 }
 
 // Receive Functions ----------------------------------------------------------------------------------------------------------
@@ -103,40 +159,62 @@ void ecumasterUtc (ecumasterGps_t* gps, CANRxFrame* frame)
 	(void) frame;
 }
 
+static void handleMessage (ecumasterGps_t* gps, uint8_t index, CANRxFrame* frame)
+{
+	switch (index)
+	{
+	case POSITION_MESSAGE_FLAG_POS:
+		ecumasterHandlePosition (gps, frame);
+		break;
+	case VELOCITY_MESSAGE_FLAG_POS:
+		ecumasterHandleVelocity (gps, frame);
+		break;
+	case HEADING_IMU0_MESSAGE_FLAG_POS:
+		ecumasterHandleHeadingImu0 (gps, frame);
+		break;
+	case IMU1_MESSAGE_FLAG_POS:
+		ecumasterHandleImu1 (gps, frame);
+		break;
+	case UTC_MESSAGE_FLAG_POS:
+		ecumasterUtc (gps, frame);
+		break;
+	}
+}
+
 int8_t ecumasterReceiveHandler (void* node, CANRxFrame* frame)
 {
 	ecumasterGps_t* gps = (ecumasterGps_t*) node;
 	uint16_t id = frame->SID;
 
-	// Identify and handle the message.
+	// Identify the message.
+	int8_t index;
 	if (id == POSITION_MESSAGE_ID)
-	{
-		ecumasterHandlePosition (gps, frame);
-		return POSITION_MESSAGE_FLAG_POS;
-	}
+		index = POSITION_MESSAGE_FLAG_POS;
 	else if (id == VELOCITY_MESSAGE_ID)
-	{
-		ecumasterHandleVelocity (gps, frame);
-		return VELOCITY_MESSAGE_FLAG_POS;
-	}
+		index = VELOCITY_MESSAGE_FLAG_POS;
 	else if (id == HEADING_IMU0_MESSAGE_ID)
-	{
-		ecumasterHandleHeadingImu0 (gps, frame);
-		return HEADING_IMU0_MESSAGE_FLAG_POS;
-	}
+		index = HEADING_IMU0_MESSAGE_FLAG_POS;
 	else if (id == IMU1_MESSAGE_ID)
-	{
-		ecumasterHandleImu1 (gps, frame);
-		return IMU1_MESSAGE_FLAG_POS;
-	}
+		index = IMU1_MESSAGE_FLAG_POS;
 	else if (id == UTC_MESSAGE_ID)
-	{
-		ecumasterUtc (gps, frame);
-		return UTC_MESSAGE_FLAG_POS;
-	}
+		index = UTC_MESSAGE_FLAG_POS;
 	else
 	{
 		// Message doesn't belong to this node.
 		return -1;
 	}
+
+	// Handle the message, or store it to be decoded later.
+	if (gps->lazyDecode)
+		canNodeLazyStore (&gps->lazy, index, frame);
+	else
+		handleMessage (gps, index, frame);
+
+	return index;
+}
+
+canId_t ecumasterIdHandler (void* node, uint8_t index)
+{
+	(void) node;
+	return canIdStandard (MESSAGE_IDS [index]);
 }
\ No newline at end of file
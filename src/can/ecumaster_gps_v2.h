@@ -7,6 +7,11 @@
 // Date Created: 2024.10.05
 //
 // Description: Object representing the ECUMaster GPS CAN module.
+//
+//   The module broadcasts its IMU data at a high rate, typically much higher than it is read. Optionally, the node can decode
+//   its messages lazily (see @c canNodeLazy_t ), in which case the receive handler only stores each message's payload, and
+//   the data is decoded when read, either by @c ecumasterDecode or by any of the accessor functions. Fields read directly must
+//   be read after one of these, without unlocking the node in between.
 
 // Includes -------------------------------------------------------------------------------------------------------------------
 
@@ -27,6 +32,14 @@ typedef struct
 {
 	CANDriver*		driver;
 	sysinterval_t	timeoutPeriod;
+
+	/// @brief Indicates whether to decode messages lazily. If true, the node's fields are only valid after calling
+	/// @c ecumasterDecode (the accessor functions below decode the node themselves).
+	bool			lazyDecode;
+
+	/// @brief Optional array of the timeout period of each message (see @c canNodeConfig_t ), indexed as the position,
+	/// velocity, heading / IMU 0, IMU 1, and UTC messages. Use @c NULL to only time-out the node as a whole.
+	const sysinterval_t* messageTimeoutPeriods;
 } ecumasterGpsConfig_t;
 
 typedef struct
@@ -67,24 +80,71 @@ typedef struct
 	ecumasterGpsStatus_t gpsStatus;
 	float headingMotion;
 	float headingVehicle;
+
+	// Lazy decoding
+	bool lazyDecode;
+	canNodeLazy_t lazy;
 } ecumasterGps_t;
 
 // Functions ------------------------------------------------------------------------------------------------------------------
 
 void ecumasterInit (ecumasterGps_t* gps, const ecumasterGpsConfig_t* config);
 
+/**
+ * @brief Decodes any messages received since the last decode. Only required if the node was configured with @c lazyDecode ,
+ * otherwise this does nothing.
+ * @note The node must either be locked (see @c canNodeLock ) or be a snapshot (see @c canNodeGetSnapshot ). Decoding a
+ * snapshot leaves the node's own messages pending, so prefer decoding the node itself if it is read frequently.
+ * @param gps The node to decode.
+ */
+void ecumasterDecode (ecumasterGps_t* gps);
+
+/**
+ * @brief Gets the status of the GPS. If the node was configured with @c lazyDecode , any pending messages are decoded first.
+ * @note The node must either be locked (see @c canNodeLock ) or be a snapshot (see @c canNodeGetSnapshot ). Use
+ * @c ecumasterGetGpsStatusLock otherwise.
+ * @param gps The node to use.
+ * @return The status of the GPS, @c ECUMASTER_GPS_STATUS_INVALID if the node is not valid.
+ */
 static inline ecumasterGpsStatus_t ecumasterGetGpsStatus (ecumasterGps_t* gps)
 {
 	if (gps->state != CAN_NODE_VALID)
 		return ECUMASTER_GPS_STATUS_INVALID;
 
+	if (gps->lazyDecode)
+		ecumasterDecode (gps);
+
 	return gps->gpsStatus;
 }
 
+/**
+ * @brief Checks whether the GPS has a 2D or 3D lock. If the node was configured with @c lazyDecode , any pending messages are
+ * decoded first.
+ * @note The node must either be locked (see @c canNodeLock ) or be a snapshot (see @c canNodeGetSnapshot ). Use
+ * @c ecumasterGpsValidLock otherwise.
+ * @param gps The node to use.
+ * @return True if the GPS data is valid, false otherwise.
+ */
 static inline bool ecumasterGpsValid (ecumasterGps_t* gps)
 {
 	ecumasterGpsStatus_t status = ecumasterGetGpsStatus (gps);
 	return status == ECUMASTER_GPS_STATUS_2D || status == ECUMASTER_GPS_STATUS_3D;
 }
 
+/**
+ * @brief Gets the status of the GPS. See @c ecumasterGetGpsStatus for details.
+ * @note Locks and unlocks the CAN node's mutex.
+ * @param gps The node to use.
+ * @return The status of the GPS, @c ECUMASTER_GPS_STATUS_INVALID if the node is not valid.
+ */
+ecumasterGpsStatus_t ecumasterGetGpsStatusLock (ecumasterGps_t* gps);
+
+/**
+ * @brief Checks whether the GPS has a 2D or 3D lock. See @c ecumasterGpsValid for details.
+ * @note Locks and unlocks the CAN node's mutex.
+ * @param gps The node to use.
+ * @return True if the GPS data is valid, false otherwise.
+ */
+bool ecumasterGpsValidLock (ecumasterGps_t* gps);
+
 #endif // ECUMASTER_GPS_V2_H
\ No newline at end of file
@@ -1,6 +1,9 @@
 // Header
 #include "eeprom_can.h"
 
+// Includes
+#include "algorithm/crc.h"
+
 // C Standard Library
 #include <string.h>
 
@@ -15,6 +18,59 @@
 /// @brief The timeout for transmitting a response message.
 #define RESPONSE_TIMEOUT TIME_MS2I (100)
 
+// Bulk command codes
+#define BULK_COMMAND_READ		0x01
+#define BULK_COMMAND_WRITE		0x02
+#define SESSION_COMMAND_OPEN	0x03
+#define SESSION_COMMAND_BLOCK	0x04
+#define SESSION_COMMAND_COMMIT	0x05
+#define SESSION_COMMAND_ABORT	0x06
+
+// Bulk response status codes
+#define BULK_STATUS_SUCCESS		0x00
+#define BULK_STATUS_FAILURE		0x01
+#define BULK_STATUS_CRC			0x02
+#define BULK_STATUS_SEQUENCE	0x03
+#define BULK_STATUS_NO_SESSION	0x04
+
+/// @brief The size of the session block command header.
+#define BLOCK_HEADER_SIZE 7
+
+/// @brief The size of the chunks an image is read back in, for verification.
+#define VERIFY_CHUNK_SIZE 32
+
+/// @brief The size of the bulk command and response headers.
+#define BULK_HEADER_SIZE 5
+#define BULK_RESPONSE_HEADER_SIZE 6
+
+// Function Prototypes --------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Writes a region of an EEPROM, split into one write per page (see @c EEPROM_CAN_PAGE_SIZE ).
+ * @param eeprom The EEPROM to write to.
+ * @param address The address of the region.
+ * @param data The data to write.
+ * @param count The size of the region, in bytes.
+ * @return True if successful, false if any write failed. Note the pages preceding the failed write are left written.
+ */
+static bool writePages (eeprom_t* eeprom, uint16_t address, const uint8_t* data, uint16_t count);
+
+/**
+ * @brief Reads back a region of an EEPROM from the device itself (see @c eepromReadBack ), calculating its CRC-32.
+ * @param eeprom The EEPROM to read from.
+ * @param address The address of the region.
+ * @param size The size of the region, in bytes.
+ * @param crc Written to contain the CRC-32 of the region.
+ * @return True if successful, false if the EEPROM could not be read.
+ */
+static bool readCrc (eeprom_t* eeprom, uint16_t address, uint16_t size, uint32_t* crc);
+
+/**
+ * @brief Handles a session block command.
+ * @return The status to respond with.
+ */
+static uint8_t handleBlock (eepromCanSession_t* session, uint8_t* command, uint16_t size);
+
 // Functions ------------------------------------------------------------------------------------------------------------------
 
 void eepromHandleCanCommand (CANRxFrame* command, CANDriver* driver, eeprom_t* eeprom)
@@ -55,4 +111,218 @@ void eepromHandleCanCommand (CANRxFrame* command, CANDriver* driver, eeprom_t* e
 
 	// Send the response
 	canTransmitTimeout (driver, CAN_ANY_MAILBOX, &response, RESPONSE_TIMEOUT);
+}
+
+void eepromHandleIsoTpCommand (void* eeprom, canIsoTpLink_t* link, uint8_t* command, uint16_t size)
+{
+	eeprom_t* device = (eeprom_t*) eeprom;
+
+	// The buffer must be able to fit at least the response header.
+	if (link->config->bufferSize < BULK_RESPONSE_HEADER_SIZE)
+		return;
+
+	uint8_t code = 0;
+	uint16_t address = 0;
+	uint16_t count = 0;
+	bool result = false;
+
+	// Parse the command
+	if (size >= BULK_HEADER_SIZE)
+	{
+		code	= command [0];
+		address	= command [1] | (command [2] << 8);
+		count	= command [3] | (command [4] << 8);
+
+		if (code == BULK_COMMAND_READ)
+		{
+			// Read operation, the data is read directly into the response.
+			if (BULK_RESPONSE_HEADER_SIZE + count <= link->config->bufferSize)
+				result = device->readHandler (device, address, command + BULK_RESPONSE_HEADER_SIZE, count);
+		}
+		else if (code == BULK_COMMAND_WRITE)
+		{
+			// Write operation, the data must be entirely present.
+			if (size == BULK_HEADER_SIZE + count)
+				result = writePages (device, address, command + BULK_HEADER_SIZE, count);
+		}
+	}
+
+	// Build the response in the command's buffer, echoing the command, address, and count.
+	command [0] = code;
+	command [1] = result ? BULK_STATUS_SUCCESS : BULK_STATUS_FAILURE;
+	command [2] = address;
+	command [3] = address >> 8;
+	command [4] = count;
+	command [5] = count >> 8;
+
+	uint16_t responseSize = BULK_RESPONSE_HEADER_SIZE;
+	if (result && code == BULK_COMMAND_READ)
+		responseSize += count;
+
+	canIsoTpTransmit (link, command, responseSize);
+}
+
+void eepromHandleIsoTpSession (void* session, canIsoTpLink_t* link, uint8_t* command, uint16_t size)
+{
+	eepromCanSession_t* state = (eepromCanSession_t*) session;
+
+	if (size < 1)
+		return;
+
+	// Plain bulk commands are not part of the session.
+	if (command [0] == BULK_COMMAND_READ || command [0] == BULK_COMMAND_WRITE)
+	{
+		eepromHandleIsoTpCommand (state->eeprom, link, command, size);
+		return;
+	}
+
+	// Any arguments not set by the command are left zero.
+	uint8_t response [BULK_RESPONSE_HEADER_SIZE] = { command [0], BULK_STATUS_FAILURE };
+
+	switch (command [0])
+	{
+	case SESSION_COMMAND_OPEN:
+		if (size < BULK_HEADER_SIZE)
+			break;
+
+		state->address	= command [1] | (command [2] << 8);
+		state->size		= command [3] | (command [4] << 8);
+		state->offset	= 0;
+		state->sequence	= 0;
+		state->open		= true;
+
+		// Respond with the address and size.
+		memcpy (response + 2, command + 1, 4);
+		response [1] = BULK_STATUS_SUCCESS;
+		break;
+
+	case SESSION_COMMAND_BLOCK:
+		if (size < BLOCK_HEADER_SIZE)
+			break;
+
+		// Respond with the sequence number and progress.
+		response [1] = handleBlock (state, command, size);
+		response [2] = command [1];
+		response [3] = command [2];
+		response [4] = state->offset;
+		response [5] = state->offset >> 8;
+		break;
+
+	case SESSION_COMMAND_COMMIT:
+	{
+		if (size < 5)
+			break;
+
+		if (!state->open)
+		{
+			response [1] = BULK_STATUS_NO_SESSION;
+			break;
+		}
+		state->open = false;
+
+		uint32_t expected = command [1] | (command [2] << 8) | (command [3] << 16) | ((uint32_t) command [4] << 24);
+		uint32_t crc = 0;
+
+		// The image must be complete, and match once read back.
+		if (state->offset != state->size)
+			response [1] = BULK_STATUS_SEQUENCE;
+		else if (!readCrc (state->eeprom, state->address, state->size, &crc))
+			response [1] = BULK_STATUS_FAILURE;
+		else if (crc != expected)
+			response [1] = BULK_STATUS_CRC;
+		else
+			response [1] = BULK_STATUS_SUCCESS;
+
+		// Respond with the image's CRC.
+		response [2] = crc;
+		response [3] = crc >> 8;
+		response [4] = crc >> 16;
+		response [5] = crc >> 24;
+		break;
+	}
+
+	case SESSION_COMMAND_ABORT:
+		state->open = false;
+		response [1] = BULK_STATUS_SUCCESS;
+		break;
+	}
+
+	canIsoTpTransmit (link, response, sizeof (response));
+}
+
+static bool writePages (eeprom_t* eeprom, uint16_t address, const uint8_t* data, uint16_t count)
+{
+	while (count > 0)
+	{
+		// Write up to the end of the current page.
+		uint16_t chunk = EEPROM_CAN_PAGE_SIZE - address % EEPROM_CAN_PAGE_SIZE;
+		if (chunk > count)
+			chunk = count;
+
+		if (!eeprom->writeHandler (eeprom, address, data, chunk))
+			return false;
+
+		address	+= chunk;
+		data	+= chunk;
+		count	-= chunk;
+	}
+
+	return true;
+}
+
+static uint8_t handleBlock (eepromCanSession_t* session, uint8_t* command, uint16_t size)
+{
+	if (!session->open)
+		return BULK_STATUS_NO_SESSION;
+
+	uint16_t sequence	= command [1] | (command [2] << 8);
+	uint32_t crc		= command [3] | (command [4] << 8) | (command [5] << 16) | ((uint32_t) command [6] << 24);
+	uint8_t* data		= command + BLOCK_HEADER_SIZE;
+	uint16_t count		= size - BLOCK_HEADER_SIZE;
+
+	// Reject corrupted blocks, the sender should re-send them.
+	if (crc32 (data, count) != crc)
+		return BULK_STATUS_CRC;
+
+	// Acknowledge repeated blocks without re-writing them.
+	if (session->sequence != 0 && sequence == (uint16_t) (session->sequence - 1) && crc == session->blockCrc)
+		return BULK_STATUS_SUCCESS;
+
+	if (sequence != session->sequence || count > session->size - session->offset)
+		return BULK_STATUS_SEQUENCE;
+
+	// Write the block, then read it back to verify it.
+	uint16_t address = session->address + session->offset;
+	uint32_t readback;
+	if (!writePages (session->eeprom, address, data, count) ||
+		!readCrc (session->eeprom, address, count, &readback))
+		return BULK_STATUS_FAILURE;
+
+	if (readback != crc)
+		return BULK_STATUS_CRC;
+
+	session->offset += count;
+	session->blockCrc = crc;
+	++session->sequence;
+	return BULK_STATUS_SUCCESS;
+}
+
+static bool readCrc (eeprom_t* eeprom, uint16_t address, uint16_t size, uint32_t* crc)
+{
+	uint8_t chunk [VERIFY_CHUNK_SIZE];
+
+	*crc = 0;
+	for (uint16_t offset = 0; offset < size; offset += VERIFY_CHUNK_SIZE)
+	{
+		uint16_t count = size - offset;
+		if (count > VERIFY_CHUNK_SIZE)
+			count = VERIFY_CHUNK_SIZE;
+
+		if (!eepromReadBack (eeprom, address + offset, chunk, count))
+			return false;
+
+		*crc = crc32Update (*crc, chunk, count);
+	}
+
+	return true;
 }
\ No newline at end of file
@@ -6,16 +6,95 @@
 // Author: Cole Barach
 // Date Created: 2025.01.23
 //
-// Description: Function for exposing an EEPROM's memory to a CAN bus.
+// Description: Functions for exposing an EEPROM's memory to a CAN bus. Three protocols are provided:
+//   - Single frame commands (see @c eepromHandleCanCommand ), each accessing at most 6 bytes of memory.
+//   - Bulk commands (see @c eepromHandleIsoTpCommand ), transported by an ISO-TP link (see @c canIsoTpLink_t ), each
+//     accessing up to the entire memory in a single transfer. Writes are split into one write per page of the EEPROM (see
+//     @c EEPROM_CAN_PAGE_SIZE ), so may cross page boundaries.
+//   - Streaming sessions (see @c eepromCanSession_t ), also transported by an ISO-TP link, for writing an image in a series
+//     of blocks with integrity checking.
+//
+//   Bulk command format (little-endian):
+//   - Byte 0: Command, 0x01 => Read, 0x02 => Write.
+//   - Bytes 1-2: Address of the first byte to access.
+//   - Bytes 3-4: Number of bytes to access.
+//   - Bytes 5+: Data to write (write command only).
+//
+//   Bulk response format (little-endian):
+//   - Byte 0: Command, same as the request.
+//   - Byte 1: Status, 0x00 => Success, 0x01 => Failure (invalid command or EEPROM access failed).
+//   - Bytes 2-3: Address, same as the request.
+//   - Bytes 4-5: Count, same as the request.
+//   - Bytes 6+: Data that was read (successful read command only).
+//
+//   Streaming session commands (little-endian, same response format unless noted):
+//   - Open (0x03): Starts a session writing an image. Bytes 1-2: Address of the image, bytes 3-4: Size of the image in
+//     bytes. Any open session is discarded.
+//   - Block (0x04): Bytes 1-2: Sequence number (starting at 0), bytes 3-6: CRC-32 of the block's data, bytes 7+: The block's
+//     data, written immediately after the previous block. The block is written only if its CRC-32 matches (split into pages,
+//     as with bulk writes), and is read back from the device to verify the write. A repeated block (same sequence number and
+//     CRC-32 as the previous) is acknowledged without being written again, so a block whose response was lost can be safely
+//     re-sent. Response bytes 2-3: Sequence number, bytes 4-5: Number of bytes of the image written so far.
+//   - Commit (0x05): Bytes 1-4: CRC-32 of the entire image. Closes the session, succeeding only if the entire image was
+//     written and the CRC-32 of the image read back from the EEPROM matches. Response bytes 2-5: CRC-32 of the image read
+//     back.
+//   - Abort (0x06): Closes the session.
+//
+//   Session response status codes: 0x00 => Success, 0x01 => Failure (invalid command or EEPROM access failed),
+//   0x02 => CRC-32 mismatch, 0x03 => Unexpected sequence number (or block exceeds the image), 0x04 => No session is open.
+//
+//   Verification reads bypass any cache of the EEPROM (see @c eepromReadBack ), so a write that failed to reach the device is
+//   detected even if its cache was updated.
+//
+//   Note that blocks are written as they are received, so an image is not applied atomically. If a session fails, the
+//   contents of the image's memory are undefined until a session succeeds.
 
 // Includes -------------------------------------------------------------------------------------------------------------------
 
 // Includes
+#include "can_iso_tp.h"
 #include "peripherals/interface/eeprom.h"
 
 // ChibiOS
 #include "hal.h"
 
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+#ifndef EEPROM_CAN_PAGE_SIZE
+/// @brief The page size of the EEPROM, in bytes. Writes are split such that no single write crosses a multiple of this.
+/// Defaults to the page size of the MC24LC32. Note the entries of a virtual EEPROM must be aligned to this.
+#define EEPROM_CAN_PAGE_SIZE 32
+#endif // EEPROM_CAN_PAGE_SIZE
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief State of a streaming EEPROM session. Only one session may be open at a time per object.
+ */
+typedef struct
+{
+	/// @brief The EEPROM the session writes to. Must be set before use, the remaining fields should be left zero.
+	eeprom_t* eeprom;
+
+	/// @brief Indicates whether a session is open.
+	bool open;
+
+	/// @brief The address of the image.
+	uint16_t address;
+
+	/// @brief The size of the image, in bytes.
+	uint16_t size;
+
+	/// @brief The number of bytes of the image written so far.
+	uint16_t offset;
+
+	/// @brief The sequence number of the next block.
+	uint16_t sequence;
+
+	/// @brief The CRC-32 of the last block written, used to identify repeated blocks.
+	uint32_t blockCrc;
+} eepromCanSession_t;
+
 // Functions ------------------------------------------------------------------------------------------------------------------
 
 /**
@@ -26,4 +105,27 @@
  */
 void eepromHandleCanCommand (CANRxFrame* command, CANDriver* driver, eeprom_t* eeprom);
 
+/**
+ * @brief Handles an ISO-TP message containing a bulk EEPROM command, transmitting the response on the same link. Matches the
+ * @c canIsoTpMessageHandler_t signature, so may be used directly as a link's @c messageHandler .
+ * @note The link's buffer must be large enough for the largest response (6 bytes plus the largest read). Reads exceeding
+ * this are responded to with a failure.
+ * @param eeprom The EEPROM to read/write the data to/from ( @c eeprom_t* ).
+ * @param link The link the command was received by.
+ * @param command The data of the command, re-used as the response buffer.
+ * @param size The size of the command, in bytes.
+ */
+void eepromHandleIsoTpCommand (void* eeprom, canIsoTpLink_t* link, uint8_t* command, uint16_t size);
+
+/**
+ * @brief Handles an ISO-TP message containing either a streaming session command or a bulk EEPROM command, transmitting the
+ * response on the same link. Matches the @c canIsoTpMessageHandler_t signature, so may be used directly as a link's
+ * @c messageHandler .
+ * @param session The session to handle the command for ( @c eepromCanSession_t* ).
+ * @param link The link the command was received by.
+ * @param command The data of the command.
+ * @param size The size of the command, in bytes.
+ */
+void eepromHandleIsoTpSession (void* session, canIsoTpLink_t* link, uint8_t* command, uint16_t size);
+
 #endif // EEPROM_CAN
\ No newline at end of file
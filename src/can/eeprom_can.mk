@@ -3,6 +3,10 @@ define EEPROM_CAN_MK
 1
 endef
 
+# Include the module's common dependencies
+include common/src/algorithm/crc.mk
+include common/src/can/can_iso_tp.mk
+
 # Add the module's source file to the compilation
 CSRC += common/src/can/eeprom_can.c
 
@@ -35,6 +35,13 @@ static int8_t receive (void* node, CANRxFrame* frame)
 	}
 }
 
+static canId_t identify (void* node, uint8_t index)
+{
+	(void) index;
+	sib_t* sib = node;
+	return canIdStandard (sib->canId);
+}
+
 void sibInit (sib_t* sib, const sibConfig_t* config)
 {
 	canNodeConfig_t nodeConfig =
@@ -42,6 +49,7 @@ void sibInit (sib_t* sib, const sibConfig_t* config)
 		.driver			= config->driver,
 		.receiveHandler	= receive,
 		.timeoutHandler	= NULL,
+		.idHandler		= identify,
 		.timeoutPeriod	= config->timeoutPeriod,
 		.messageCount	= 1,
 	};
@@ -42,6 +42,8 @@
 
 int8_t tcChargerReceiveHandler (void* node, CANRxFrame* frame);
 
+canId_t tcChargerIdHandler (void* node, uint8_t index);
+
 // Functions ------------------------------------------------------------------------------------------------------------------
 
 void tcChargerInit (tcCharger_t* charger, const tcChargerConfig_t* config)
@@ -52,6 +54,7 @@ void tcChargerInit (tcCharger_t* charger, const tcChargerConfig_t* config)
 		.driver			= config->driver,
 		.receiveHandler	= tcChargerReceiveHandler,
 		.timeoutHandler	= NULL,
+		.idHandler		= tcChargerIdHandler,
 		.timeoutPeriod	= config->timeoutPeriod,
 		.messageCount	= 1
 	};
@@ -109,6 +112,14 @@ int8_t tcChargerReceiveHandler (void* node, CANRxFrame* frame)
 	return 0;
 }
 
+canId_t tcChargerIdHandler (void* node, uint8_t index)
+{
+	// Charger only has 1 message.
+	(void) node;
+	(void) index;
+	return canIdExtended (RESPONSE_ID);
+}
+
 msg_t tcChargerSendCommand (tcCharger_t* charger, tcWorkingMode_t mode, float voltageLimit, float currentLimit,
 	sysinterval_t timeout)
 {
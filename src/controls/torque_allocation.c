@@ -0,0 +1,271 @@
+// Header
+#include "torque_allocation.h"
+
+// C Standard Library
+#include <math.h>
+#include <stddef.h>
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+#define N TORQUE_ALLOCATION_MOTOR_COUNT
+
+/// @brief Indicates a motor is not fixed to a limit.
+#define BOUND_NONE	0
+
+/// @brief Indicates a motor is fixed to its lower limit.
+#define BOUND_MIN	1
+
+/// @brief Indicates a motor is fixed to its upper limit.
+#define BOUND_MAX	2
+
+// Function Prototypes --------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Calculates the gradient of the cost at an iterate, @c g = H u - c . This is evaluated from the residuals of the
+ * outputs, rather than by the product @c H u , as the latter cancels terms much larger than the result. The rounding error of
+ * this cancellation would otherwise be amplified by the (small) motor weights, limiting the accuracy of the solution.
+ * @param config The configuration of the allocation.
+ * @param wt2 The square of the total torque weight.
+ * @param wm2 The square of the yaw moment weight.
+ * @param torqueTotal The desired total torque.
+ * @param yawMoment The desired yaw moment.
+ * @param torques The torque of each motor (the iterate).
+ * @param g Written to contain the gradient.
+ */
+static void getGradient (const torqueAllocationConfig_t* config, float wt2, float wm2, float torqueTotal, float yawMoment,
+	const float* torques, float* g);
+
+/**
+ * @brief Solves the unconstrained problem over the free motors, that is, the step @c p minimizing the cost with the fixed
+ * motors held constant. This is the solution of @c H_ff p_f = -g_f , where @c f denotes the free motors.
+ * @param h The Hessian of the cost (symmetric positive-definite).
+ * @param g The gradient of the cost at the current iterate.
+ * @param bounds The bound each motor is fixed to, if any.
+ * @param p Written to contain the step. Fixed motors have a step of 0.
+ * @return True if successful, false if the system is singular.
+ */
+static bool solveFree (float h [N][N], const float* g, const uint8_t* bounds, float* p);
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+bool torqueAllocate (const torqueAllocationConfig_t* config, float torqueTotal, float yawMoment, const float* torquesMin,
+	const float* torquesMax, float* torques, uint8_t* iterations)
+{
+	// Cost Function:
+	//   J(u) = ||Wv (B u - v)||^2 + ||Wu (u - ud)||^2
+	//        = u' H u / 2 - c' u + constant
+	//   where:
+	//     H = 2 (B' Wv^2 B + Wu^2)
+	//     c = 2 (B' Wv^2 v + Wu^2 ud)
+	//
+	// As B has only 2 rows (the total torque row is all 1s, the yaw moment row is the transfer scalars), this expands to:
+	//   H_ij = 2 (wt^2 + wm^2 b_i b_j + [i == j] wu_i^2)
+	//   c_i  = 2 (wt^2 T + wm^2 b_i Mz + wu_i^2 ud_i)
+	//
+	// The common factor of 2 is dropped, as it does not affect the solution. Note c is not formed, see getGradient.
+
+	const float* b = config->yawMomentTransfers;
+	float wt2 = config->torqueWeight * config->torqueWeight;
+	float wm2 = config->yawMomentWeight * config->yawMomentWeight;
+
+	float h [N][N];
+	for (uint8_t i = 0; i < N; ++i)
+	{
+		float wu2 = config->motorWeights [i] * config->motorWeights [i];
+		for (uint8_t j = 0; j < N; ++j)
+			h [i][j] = wt2 + wm2 * b [i] * b [j];
+		h [i][i] += wu2;
+	}
+
+	// Start from the previous allocation, clamped to the current limits. Any motor at a limit starts fixed to it.
+	uint8_t bounds [N];
+	for (uint8_t i = 0; i < N; ++i)
+	{
+		bounds [i] = BOUND_NONE;
+		if (torques [i] <= torquesMin [i])
+		{
+			torques [i] = torquesMin [i];
+			bounds [i] = BOUND_MIN;
+		}
+		else if (torques [i] >= torquesMax [i])
+		{
+			torques [i] = torquesMax [i];
+			bounds [i] = BOUND_MAX;
+		}
+	}
+
+	float g [N];
+	float p [N];
+
+	bool converged = false;
+	uint8_t iteration = 0;
+	while (iteration < TORQUE_ALLOCATION_ITERATIONS_MAX)
+	{
+		++iteration;
+
+		getGradient (config, wt2, wm2, torqueTotal, yawMoment, torques, g);
+
+		if (!solveFree (h, g, bounds, p))
+			break;
+
+		// Find the largest fraction of the step that remains within the limits, and the motor limiting it (if any).
+		float alpha = 1.0f;
+		int8_t blocking = -1;
+		uint8_t blockingBound = BOUND_NONE;
+		for (uint8_t i = 0; i < N; ++i)
+		{
+			if (bounds [i] != BOUND_NONE)
+				continue;
+
+			float target = torques [i] + p [i];
+			if (target < torquesMin [i] && p [i] < 0.0f)
+			{
+				float fraction = (torquesMin [i] - torques [i]) / p [i];
+				if (fraction < alpha)
+				{
+					alpha = fraction;
+					blocking = i;
+					blockingBound = BOUND_MIN;
+				}
+			}
+			else if (target > torquesMax [i] && p [i] > 0.0f)
+			{
+				float fraction = (torquesMax [i] - torques [i]) / p [i];
+				if (fraction < alpha)
+				{
+					alpha = fraction;
+					blocking = i;
+					blockingBound = BOUND_MAX;
+				}
+			}
+		}
+
+		for (uint8_t i = 0; i < N; ++i)
+			torques [i] += alpha * p [i];
+
+		// If a limit was reached, fix the motor to it and re-solve.
+		if (blocking >= 0)
+		{
+			bounds [blocking] = blockingBound;
+			torques [blocking] = blockingBound == BOUND_MIN ? torquesMin [blocking] : torquesMax [blocking];
+			continue;
+		}
+
+		// Otherwise, this is the optimum for the current set of fixed motors. Check whether releasing any fixed motor would
+		// reduce the cost, that is, whether the gradient points into the feasible region.
+		getGradient (config, wt2, wm2, torqueTotal, yawMoment, torques, g);
+		int8_t release = -1;
+		float releaseMultiplier = -TORQUE_ALLOCATION_TOLERANCE;
+		for (uint8_t i = 0; i < N; ++i)
+		{
+			if (bounds [i] == BOUND_NONE)
+				continue;
+
+			// Lagrange multiplier, negative if the cost decreases moving away from the limit.
+			float multiplier = bounds [i] == BOUND_MIN ? g [i] : -g [i];
+			if (multiplier < releaseMultiplier)
+			{
+				releaseMultiplier = multiplier;
+				release = i;
+			}
+		}
+
+		if (release < 0)
+		{
+			// If the step was large, take another to refine the solution against the rounding error of the factorization.
+			// Otherwise, the solution is optimal.
+			float stepMax = 0.0f;
+			for (uint8_t i = 0; i < N; ++i)
+				stepMax = fmaxf (stepMax, fabsf (p [i]));
+			if (stepMax > TORQUE_ALLOCATION_STEP_TOLERANCE)
+				continue;
+
+			converged = true;
+			break;
+		}
+
+		bounds [release] = BOUND_NONE;
+	}
+
+	if (iterations != NULL)
+		*iterations = iteration;
+
+	return converged;
+}
+
+static void getGradient (const torqueAllocationConfig_t* config, float wt2, float wm2, float torqueTotal, float yawMoment,
+	const float* torques, float* g)
+{
+	// g_i = wt^2 (sum u - T) + wm^2 b_i (b' u - Mz) + wu_i^2 (u_i - ud_i)
+	float torqueError = -torqueTotal;
+	float yawMomentError = -yawMoment;
+	for (uint8_t i = 0; i < N; ++i)
+	{
+		torqueError += torques [i];
+		yawMomentError += config->yawMomentTransfers [i] * torques [i];
+	}
+
+	for (uint8_t i = 0; i < N; ++i)
+	{
+		float wu2 = config->motorWeights [i] * config->motorWeights [i];
+		g [i] = wt2 * torqueError + wm2 * config->yawMomentTransfers [i] * yawMomentError +
+			wu2 * (torques [i] - config->distribution [i] * torqueTotal);
+	}
+}
+
+static bool solveFree (float h [N][N], const float* g, const uint8_t* bounds, float* p)
+{
+	// Gather the free motors
+	uint8_t free [N];
+	uint8_t count = 0;
+	for (uint8_t i = 0; i < N; ++i)
+	{
+		p [i] = 0.0f;
+		if (bounds [i] == BOUND_NONE)
+			free [count++] = i;
+	}
+
+	// Cholesky factorization of the free sub-matrix: H_ff = L L'
+	float l [N][N];
+	for (uint8_t i = 0; i < count; ++i)
+	{
+		for (uint8_t j = 0; j <= i; ++j)
+		{
+			float sum = h [free [i]][free [j]];
+			for (uint8_t k = 0; k < j; ++k)
+				sum -= l [i][k] * l [j][k];
+
+			if (i == j)
+			{
+				if (sum <= 0.0f)
+					return false;
+				l [i][i] = sqrtf (sum);
+			}
+			else
+			{
+				l [i][j] = sum / l [j][j];
+			}
+		}
+	}
+
+	// Forward substitution: L y = -g_f
+	float y [N];
+	for (uint8_t i = 0; i < count; ++i)
+	{
+		float sum = -g [free [i]];
+		for (uint8_t k = 0; k < i; ++k)
+			sum -= l [i][k] * y [k];
+		y [i] = sum / l [i][i];
+	}
+
+	// Backward substitution: L' p_f = y
+	for (int8_t i = count - 1; i >= 0; --i)
+	{
+		float sum = y [i];
+		for (uint8_t k = i + 1; k < count; ++k)
+			sum -= l [k][i] * p [free [k]];
+		p [free [i]] = sum / l [i][i];
+	}
+
+	return true;
+}
\ No newline at end of file
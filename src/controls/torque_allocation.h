@@ -0,0 +1,120 @@
+#ifndef TORQUE_ALLOCATION_H
+#define TORQUE_ALLOCATION_H
+
+// Torque Allocation ----------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Constrained allocation of a desired total torque and yaw moment onto the 4 motors of the vehicle (torque
+//   vectoring). The allocation is posed as a weighted least-squares (WLS) problem:
+//
+//     minimize ||Wv (B u - v)||^2 + ||Wu (u - ud)||^2, subject to uMin <= u <= uMax
+//
+//   where:
+//     u is the torque of each motor (the solution),
+//     v = [total torque, yaw moment] is the desired output,
+//     B = [1 1 1 1; b_fl b_fr b_rl b_rr] maps the motor torques onto the output, b being each motor's yaw moment transfer
+//       scalar (see @c motorFlYawMomentTransfer and related functions of vehicle_dynamics.h ),
+//     ud is the preferred torque of each motor (the total torque, distributed per the configuration),
+//     Wv, Wu are the diagonal weight matrices of the output error and the preferred torque deviation, respectively.
+//
+//   When the output is achievable within the limits, the solution meets it exactly (less the small bias introduced by Wu).
+//   Otherwise, the output error is minimized in the least-squares sense, so the relative weights of Wv decide whether the
+//   total torque or the yaw moment is sacrificed first.
+//
+//   The problem is solved using a primal active-set method, warm-started from the previous solution. Each iteration solves the
+//   unconstrained problem over the motors not fixed to a limit (a Cholesky factorization of at most 4x4), then either steps
+//   to the solution or stops at the first limit encountered, fixing that motor. The number of iterations is capped (see
+//   @c TORQUE_ALLOCATION_ITERATIONS_MAX ), so the execution time is bounded. If the cap is reached, the last (feasible)
+//   iterate is returned, and the allocation is reported as not converged. No dynamic memory or recursion is used.
+//
+//   The motor limits should account for the inverters' limits (ex. @c AMK_DRIVING_TORQUE_MAX and
+//   @c AMK_REGENERATIVE_TORQUE_MAX ), as well as any de-rating (ex. the actual torque of a de-rating inverter), power
+//   limiting, or traction limits.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// C Standard Library
+#include <stdbool.h>
+#include <stdint.h>
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+/// @brief The number of motors torque is allocated to.
+#define TORQUE_ALLOCATION_MOTOR_COUNT 4
+
+#ifndef TORQUE_ALLOCATION_ITERATIONS_MAX
+/// @brief The maximum number of active-set iterations performed by a single allocation. An allocation warm-started from the
+/// previous control cycle typically converges in 1 to 3 iterations, one started from an unrelated point may take up to 3
+/// iterations per motor.
+#define TORQUE_ALLOCATION_ITERATIONS_MAX 12
+#endif // TORQUE_ALLOCATION_ITERATIONS_MAX
+
+#ifndef TORQUE_ALLOCATION_TOLERANCE
+/// @brief The tolerance of the optimality check. A motor fixed to a limit is only released if doing so reduces the cost's
+/// gradient by more than this amount.
+#define TORQUE_ALLOCATION_TOLERANCE 1e-5f
+#endif // TORQUE_ALLOCATION_TOLERANCE
+
+#ifndef TORQUE_ALLOCATION_STEP_TOLERANCE
+/// @brief The largest step (in Nm) considered to have reached the optimum of the free motors. A larger step is followed by
+/// another, refining the solution against the rounding error of the factorization (which is amplified by small motor weights).
+#define TORQUE_ALLOCATION_STEP_TOLERANCE 1e-3f
+#endif // TORQUE_ALLOCATION_STEP_TOLERANCE
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief The index of each motor in the allocation's arrays.
+ */
+typedef enum
+{
+	TORQUE_ALLOCATION_FL = 0,
+	TORQUE_ALLOCATION_FR = 1,
+	TORQUE_ALLOCATION_RL = 2,
+	TORQUE_ALLOCATION_RR = 3
+} torqueAllocationMotor_t;
+
+typedef struct
+{
+	/// @brief The yaw moment transfer scalar of each motor, in Nm of yaw moment per Nm of motor torque (see
+	/// @c motorFlYawMomentTransfer and related functions).
+	float yawMomentTransfers [TORQUE_ALLOCATION_MOTOR_COUNT];
+
+	/// @brief The fraction of the total torque each motor should produce, when unconstrained. Should sum to 1 (ex. 0.25 for
+	/// each motor to distribute evenly).
+	float distribution [TORQUE_ALLOCATION_MOTOR_COUNT];
+
+	/// @brief The weight of the total torque error.
+	float torqueWeight;
+
+	/// @brief The weight of the yaw moment error. Note the transfer scalars are typically large, so a weight of the reciprocal
+	/// of a transfer scalar weighs a yaw moment error equally to the total torque error producing it.
+	float yawMomentWeight;
+
+	/// @brief The weight of each motor's deviation from its preferred torque. Should be small relative to the output weights,
+	/// but non-zero. The (weighted) outputs should not exceed these by more than ~1000x, otherwise the problem is too poorly
+	/// conditioned to be solved in single precision.
+	float motorWeights [TORQUE_ALLOCATION_MOTOR_COUNT];
+} torqueAllocationConfig_t;
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Allocates a total torque and yaw moment onto each motor, within the motors' limits.
+ * @param config The configuration of the allocation.
+ * @param torqueTotal The desired total torque of the motors, in Nm.
+ * @param yawMoment The desired yaw moment, in Nm (clockwise positive, see @c motorFlYawMomentTransfer ).
+ * @param torquesMin The lower limit of each motor's torque, in Nm.
+ * @param torquesMax The upper limit of each motor's torque, in Nm. Must not be less than the corresponding lower limit.
+ * @param torques The torque of each motor, in Nm. Upon calling, should contain the previous allocation, which is used as the
+ * starting point (use zeros if unknown). Written to contain the new allocation.
+ * @param iterations Written to contain the number of iterations performed. May be @c NULL if not needed.
+ * @return True if the allocation converged to the optimum, false if the iteration cap was reached first. In either case, the
+ * allocation is within the limits.
+ */
+bool torqueAllocate (const torqueAllocationConfig_t* config, float torqueTotal, float yawMoment, const float* torquesMin,
+	const float* torquesMax, float* torques, uint8_t* iterations);
+
+#endif // TORQUE_ALLOCATION_H
\ No newline at end of file
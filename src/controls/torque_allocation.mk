@@ -0,0 +1,9 @@
+ifndef TORQUE_ALLOCATION_MK
+define TORQUE_ALLOCATION_MK
+1
+endef
+
+# Add the module's source file to the compilation
+CSRC += common/src/controls/torque_allocation.c
+
+endif # TORQUE_ALLOCATION_MK
\ No newline at end of file
@@ -1,4 +1,68 @@
 // Header
 #include "vehicle_dynamics.h"
 
-// Nothing here yet...
\ No newline at end of file
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+/// @brief The number of entries in the sine table, one per degree in the range [0, 91]. The extra entry allows interpolating
+/// up to (and including) 90 degrees without bounds checking.
+#define SIN_TABLE_SIZE 92
+
+/// @brief Table of sin(x) for x in [0, 91] degrees, in 1 degree increments.
+static const float SIN_TABLE [SIN_TABLE_SIZE] =
+{
+	0.00000000f, 0.01745241f, 0.03489950f, 0.05233596f, 0.06975647f, 0.08715574f, 0.10452846f, 0.12186934f,
+	0.13917310f, 0.15643447f, 0.17364818f, 0.19080900f, 0.20791169f, 0.22495105f, 0.24192190f, 0.25881905f,
+	0.27563736f, 0.29237170f, 0.30901699f, 0.32556815f, 0.34202014f, 0.35836795f, 0.37460659f, 0.39073113f,
+	0.40673664f, 0.42261826f, 0.43837115f, 0.45399050f, 0.46947156f, 0.48480962f, 0.50000000f, 0.51503807f,
+	0.52991926f, 0.54463904f, 0.55919290f, 0.57357644f, 0.58778525f, 0.60181502f, 0.61566148f, 0.62932039f,
+	0.64278761f, 0.65605903f, 0.66913061f, 0.68199836f, 0.69465837f, 0.70710678f, 0.71933980f, 0.73135370f,
+	0.74314483f, 0.75470958f, 0.76604444f, 0.77714596f, 0.78801075f, 0.79863551f, 0.80901699f, 0.81915204f,
+	0.82903757f, 0.83867057f, 0.84804810f, 0.85716730f, 0.86602540f, 0.87461971f, 0.88294759f, 0.89100652f,
+	0.89879405f, 0.90630779f, 0.91354546f, 0.92050485f, 0.92718385f, 0.93358043f, 0.93969262f, 0.94551858f,
+	0.95105652f, 0.95630476f, 0.96126170f, 0.96592583f, 0.97029573f, 0.97437006f, 0.97814760f, 0.98162718f,
+	0.98480775f, 0.98768834f, 0.99026807f, 0.99254615f, 0.99452190f, 0.99619470f, 0.99756405f, 0.99862953f,
+	0.99939083f, 0.99984770f, 1.00000000f, 0.99984770f
+};
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+float sinLut (float angle)
+{
+	// Non-finite angles cannot be reduced, and cannot be used as an index.
+	if (!isfinite (angle))
+		return NAN;
+
+	// Reduce the angle to the range [0, 90], using the odd symmetry of sine and its symmetry about 90 degrees.
+	float sign = 1.0f;
+	if (angle < 0.0f)
+	{
+		angle = -angle;
+		sign = -1.0f;
+	}
+	if (angle >= 360.0f)
+		angle = fmodf (angle, 360.0f);
+	if (angle > 180.0f)
+	{
+		angle -= 180.0f;
+		sign = -sign;
+	}
+	if (angle > 90.0f)
+		angle = 180.0f - angle;
+
+	// Linearly interpolate between the neighboring entries.
+	uint8_t index = (uint8_t) angle;
+	float fraction = angle - index;
+	return sign * (SIN_TABLE [index] + fraction * (SIN_TABLE [index + 1] - SIN_TABLE [index]));
+}
+
+void yawMomentGeometryInit (yawMomentGeometry_t* geometry, float wheelBase, float weightFrontRearBias, float trackWidthFront,
+	float gearRatio, float wheelRadius)
+{
+	float x = trackWidthFront / 2.0f;
+	float y = wheelBase * weightFrontRearBias;
+
+	// Note that l * cos(a) = x and l * sin(a) = y, so the trigonometry cancels out of the coefficients.
+	float gain = gearRatio / INCHES_TO_METERS (wheelRadius);
+	geometry->transferCos	= gain * x;
+	geometry->transferSin	= gain * y;
+}
\ No newline at end of file
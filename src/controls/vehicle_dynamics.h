@@ -13,6 +13,7 @@
 // C Standard Library
 #define _USE_MATH_DEFINES
 #include "math.h"
+#include <stdint.h>
 
 // Unit Conversions -----------------------------------------------------------------------------------------------------------
 
@@ -62,6 +63,26 @@
 #define RADIUS_TO_DIAMETER(radius)			((radius) * 2.0f * M_PI)
 #define DIAMETER_TO_RADIUS(diameter)		((diameter) / (2.0f * M_PI))
 
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Pre-computed geometry of the front motors' yaw moment transfer, see @c yawMomentGeometryInit . The transfer of a front
+ * motor is the product of its lever arm (from the center of gravity to the wheel's contact patch) and the cosine of the angle
+ * between the lever arm and the wheel's heading. Only the wheel angle varies, so by the angle-addition identity:
+ *   l cos(a - theta) = l cos(a) cos(theta) + l sin(a) sin(theta)
+ * the transfer is evaluated using only the sine and cosine of the wheel angle (see @c motorFlYawMomentTransferCached ).
+ */
+typedef struct
+{
+	/// @brief The coefficient of the wheel angle's cosine, that is, the lever arm's cosine term scaled by the gear ratio and
+	/// wheel radius.
+	float transferCos;
+
+	/// @brief The coefficient of the wheel angle's sine, that is, the lever arm's sine term scaled by the gear ratio and wheel
+	/// radius.
+	float transferSin;
+} yawMomentGeometry_t;
+
 // Functions ------------------------------------------------------------------------------------------------------------------
 
 /**
@@ -161,7 +182,7 @@ static inline float motorRrYawMomentTransfer (float trackWidthRear, float gearRa
 static inline float motorFlYawMomentTransfer (float wheelBase, float weightFrontRearBias, float trackWidthFront,
 	float gearRatio, float wheelRadius, float wheelAngle)
 {
-	// TODO(Barach): This is very slow, need to optimize.
+	// Note: For repeated evaluation with the same geometry, prefer motorFlYawMomentTransferCached.
 	float x = trackWidthFront / 2.0f;
 	float y = wheelBase * weightFrontRearBias;
 	float l = sqrtf (x * x + y * y);
@@ -188,4 +209,58 @@ static inline float motorFrYawMomentTransfer (float wheelBase, float weightFront
 	return -motorFlYawMomentTransfer (wheelBase, weightFrontRearBias, trackWidthFront, gearRatio, wheelRadius, -wheelAngle);
 }
 
+/**
+ * @brief Calculates the sine of an angle using a lookup table with linear interpolation. The maximum error is roughly 4e-5.
+ * @param angle The angle, in degrees.
+ * @return The sine of the angle, NaN if the angle is not finite (as with @c sinf ).
+ */
+float sinLut (float angle);
+
+/**
+ * @brief Calculates the cosine of an angle using a lookup table with linear interpolation. See @c sinLut for details.
+ * @param angle The angle, in degrees.
+ * @return The cosine of the angle.
+ */
+static inline float cosLut (float angle)
+{
+	return sinLut (90.0f - angle);
+}
+
+/**
+ * @brief Pre-computes the static geometry of the front motors' yaw moment transfer. Parameters are the same as those of
+ * @c motorFlYawMomentTransfer .
+ * @param geometry The geometry to initialize.
+ * @param wheelBase The wheel base of the vehicle, in meters.
+ * @param weightFrontRearBias The front-to-rear bias of the vehicle's weight distribution. 1 => 100% rearwards, 0 => 100%
+ * frontwards.
+ * @param trackWidthFront The track width of the vehicle's front axle, in meters.
+ * @param gearRatio The gear ratio of the gearbox.
+ * @param wheelRadius The radius of the tire, in inches.
+ */
+void yawMomentGeometryInit (yawMomentGeometry_t* geometry, float wheelBase, float weightFrontRearBias, float trackWidthFront,
+	float gearRatio, float wheelRadius);
+
+/**
+ * @brief Equivalent to @c motorFlYawMomentTransfer , using pre-computed geometry. Uses no trigonometric functions, only a
+ * lookup table (see @c sinLut ).
+ * @param geometry The pre-computed geometry of the vehicle.
+ * @param wheelAngle The angle the FL wheel is steering in the clockwise direction, in degrees.
+ * @return The calculated transfer scalar.
+ */
+static inline float motorFlYawMomentTransferCached (const yawMomentGeometry_t* geometry, float wheelAngle)
+{
+	return geometry->transferCos * cosLut (wheelAngle) + geometry->transferSin * sinLut (wheelAngle);
+}
+
+/**
+ * @brief Equivalent to @c motorFrYawMomentTransfer , using pre-computed geometry. See @c motorFlYawMomentTransferCached .
+ * @param geometry The pre-computed geometry of the vehicle.
+ * @param wheelAngle The angle the FR wheel is steering in the clockwise direction, in degrees.
+ * @return The calculated transfer scalar.
+ */
+static inline float motorFrYawMomentTransferCached (const yawMomentGeometry_t* geometry, float wheelAngle)
+{
+	return -geometry->transferCos * cosLut (wheelAngle) + geometry->transferSin * sinLut (wheelAngle);
+}
+
 #endif // VEHICLE_DYNAMICS_H
\ No newline at end of file
@@ -44,6 +44,7 @@ bool am4096Init (am4096_t* am4096, const am4096Config_t* config)
 {
 	am4096->writeHandler	= writeBlock;
 	am4096->readHandler		= readBlock;
+	am4096->readBackHandler	= NULL;
 	am4096->config			= config;
 
 	am4096->state = AM4096_STATE_READY;
@@ -27,10 +27,11 @@ static bool pollAck (mc24lc32_t* mc24lc32);
  * @note There is no upper limit on this transaction size, so long as no errors occur.
  * @param mc24lc32 The device to read from.
  * @param address The byte address to begin the read at.
+ * @param rx The buffer to read into.
  * @param count The number of bytes to read.
  * @return True if successful, false otherwise.
  */
-static bool sequentialRead (mc24lc32_t* mc24lc32, uint16_t address, uint16_t count);
+static bool sequentialRead (mc24lc32_t* mc24lc32, uint16_t address, uint8_t* rx, uint16_t count);
 
 /**
  * @brief Write into a page of memory (see 24LC32 datasheet, Section 6.2).
@@ -74,17 +75,14 @@ bool pollAck (mc24lc32_t* mc24lc32)
 	return false;
 }
 
-bool sequentialRead (mc24lc32_t* mc24lc32, uint16_t address, uint16_t count)
+bool sequentialRead (mc24lc32_t* mc24lc32, uint16_t address, uint8_t* rx, uint16_t count)
 {
 	// Check the device is available for transfer
 	if (!pollAck (mc24lc32))
 		return false;
 
 	// Transactions starts with address (big-endian)
-	uint8_t tx [2] = { (uint8_t) (address) >> 8, (uint8_t) (address) };
-
-	// Receive into cache
-	uint8_t* rx = mc24lc32->cache + address;
+	uint8_t tx [2] = { (uint8_t) ((address) >> 8), (uint8_t) (address) };
 
 	if (i2cMasterTransmitTimeout (mc24lc32->config->i2c, mc24lc32->config->addr, tx, sizeof (tx),
 		rx, count, mc24lc32->config->timeout) != MSG_OK)
@@ -124,7 +122,7 @@ bool cacheRead (mc24lc32_t* mc24lc32)
 	i2cAcquireBus (mc24lc32->config->i2c);
 
 	// Perform a sequential read starting at address 0
-	bool result = sequentialRead (mc24lc32, 0x00, MC24LC32_SIZE);
+	bool result = sequentialRead (mc24lc32, 0x00, mc24lc32->cache, MC24LC32_SIZE);
 
 	// Release the bus
 	i2cReleaseBus (mc24lc32->config->i2c);
@@ -143,8 +141,9 @@ bool mc24lc32Init (mc24lc32_t* mc24lc32, const mc24lc32Config_t *config)
 	mc24lc32->config = config;
 
 	// Setup the virtual method table
-	mc24lc32->readHandler	= mc24lc32Read;
-	mc24lc32->writeHandler	= mc24lc32Write;
+	mc24lc32->readHandler		= mc24lc32Read;
+	mc24lc32->writeHandler		= mc24lc32Write;
+	mc24lc32->readBackHandler	= mc24lc32ReadBack;
 
 	// Start the device in the ready state
 	mc24lc32->state = MC24LC32_STATE_READY;
@@ -158,7 +157,7 @@ bool mc24lc32Write (void* object, uint16_t address, const void* data, uint16_t d
 	mc24lc32_t* mc24lc32 = (mc24lc32_t*) object;
 
 	// Memory boundary check
-	if (address + dataCount >= MC24LC32_SIZE)
+	if (address + dataCount > MC24LC32_SIZE)
 		return false;
 
 	// Page boundary check
@@ -210,7 +209,7 @@ bool mc24lc32Read (void* object, uint16_t address, void* data, uint16_t dataCoun
 	mc24lc32_t* mc24lc32 = (mc24lc32_t*) object;
 
 	// Memory boundary check
-	if (address + dataCount >= MC24LC32_SIZE)
+	if (address + dataCount > MC24LC32_SIZE)
 		return false;
 
 	// If a hardware error occurred, the cache is not valid.
@@ -229,6 +228,30 @@ bool mc24lc32Read (void* object, uint16_t address, void* data, uint16_t dataCoun
 	return true;
 }
 
+bool mc24lc32ReadBack (void* object, uint16_t address, void* data, uint16_t dataCount)
+{
+	mc24lc32_t* mc24lc32 = (mc24lc32_t*) object;
+
+	// Memory boundary check
+	if (address + dataCount > MC24LC32_SIZE)
+		return false;
+
+	// Acquire the bus
+	#if I2C_USE_MUTUAL_EXCLUSION
+	i2cAcquireBus (mc24lc32->config->i2c);
+	#endif // I2C_USE_MUTUAL_EXCLUSION
+
+	// Read the data from the device, leaving the cache as is.
+	bool result = sequentialRead (mc24lc32, address, data, dataCount);
+
+	// Release the bus
+	#if I2C_USE_MUTUAL_EXCLUSION
+	i2cReleaseBus (mc24lc32->config->i2c);
+	#endif // I2C_USE_MUTUAL_EXCLUSION
+
+	return result;
+}
+
 bool mc24lc32IsValid (mc24lc32_t* mc24lc32)
 {
 	// Check the magic string is correct (including terminator). Use strncmp as the cache is not guaranteed to have a
@@ -104,6 +104,16 @@ bool mc24lc32Write (void* mc24lc32, uint16_t address, const void* data, uint16_t
  */
 bool mc24lc32Read (void* mc24lc32, uint16_t address, void* data, uint16_t dataCount);
 
+/**
+ * @brief Reads data from the device itself, bypassing the cache. Used to verify the device's contents.
+ * @param mc24lc32 The device to read from.
+ * @param address The byte address to read from.
+ * @param data The buffer to write the data into.
+ * @param dataCount The number of bytes to read.
+ * @return True if successful, false otherwise.
+ */
+bool mc24lc32ReadBack (void* mc24lc32, uint16_t address, void* data, uint16_t dataCount);
+
 /**
  * @brief Checks whether the cached memory of the device is valid.
  * @param mc24lc32 The device to check.
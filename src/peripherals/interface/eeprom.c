@@ -7,18 +7,33 @@ bool virtualEepromWrite (void* object, uint16_t addr, const void* data, uint16_t
 
 bool virtualEepromRead (void* object, uint16_t addr, void* data, uint16_t dataCount);
 
+bool virtualEepromReadBack (void* object, uint16_t addr, void* data, uint16_t dataCount);
+
 // Functions ------------------------------------------------------------------------------------------------------------------
 
 void eepromInit (eeprom_t* eeprom, eepromWrite_t* writeHandler, eepromRead_t* readHandler)
 {
 	eeprom->writeHandler	= writeHandler;
 	eeprom->readHandler		= readHandler;
+	eeprom->readBackHandler	= NULL;
+}
+
+bool eepromReadBack (void* object, uint16_t addr, void* data, uint16_t dataCount)
+{
+	eeprom_t* eeprom = (eeprom_t*) object;
+
+	// Devices without a cache read from the device itself.
+	if (eeprom->readBackHandler == NULL)
+		return eeprom->readHandler (eeprom, addr, data, dataCount);
+
+	return eeprom->readBackHandler (eeprom, addr, data, dataCount);
 }
 
 void virtualEepromInit (virtualEeprom_t* eeprom, const virtualEepromConfig_t* config)
 {
 	eeprom->writeHandler	= virtualEepromWrite;
 	eeprom->readHandler		= virtualEepromRead;
+	eeprom->readBackHandler	= virtualEepromReadBack;
 	eeprom->config = config;
 }
 
@@ -37,7 +52,7 @@ bool virtualEepromWrite (void* object, uint16_t addr, const void* data, uint16_t
 			continue;
 
 		// Check the operation doesn't cross a boundary.
-		if (addr + dataCount >= addrMax)
+		if (addr + dataCount > addrMax)
 			return false;
 
 		// Pass the operation to the EEPROM's handler.
@@ -64,7 +79,7 @@ bool virtualEepromRead (void* object, uint16_t addr, void* data, uint16_t dataCo
 			continue;
 
 		// Check the operation doesn't cross a boundary.
-		if (addr + dataCount >= addrMax)
+		if (addr + dataCount > addrMax)
 			return false;
 
 		// Pass the operation to the EEPROM's handler.
@@ -72,6 +87,32 @@ bool virtualEepromRead (void* object, uint16_t addr, void* data, uint16_t dataCo
 			eeprom->config->entries [index].eeprom, addr - addrMin, data, dataCount);
 	}
 
+	// Failed
+	return false;
+}
+
+bool virtualEepromReadBack (void* object, uint16_t addr, void* data, uint16_t dataCount)
+{
+	virtualEeprom_t* eeprom = (virtualEeprom_t*) object;
+
+	// Traverse each EEPROM and check if the read address falls within its mapped memory.
+	for (uint16_t index = 0; index < eeprom->config->count; ++index)
+	{
+		uint16_t addrMin = eeprom->config->entries [index].addr;
+		uint16_t addrMax = addrMin + eeprom->config->entries [index].size;
+
+		// Find the correct EEPROM, skip others.
+		if (addr < addrMin || addr >= addrMax)
+			continue;
+
+		// Check the operation doesn't cross a boundary.
+		if (addr + dataCount > addrMax)
+			return false;
+
+		// Pass the operation to the EEPROM.
+		return eepromReadBack (eeprom->config->entries [index].eeprom, addr - addrMin, data, dataCount);
+	}
+
 	// Failed
 	return false;
 }
\ No newline at end of file
@@ -14,6 +14,7 @@
 
 // C Standard Library
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 // Datatypes ------------------------------------------------------------------------------------------------------------------
@@ -40,11 +41,15 @@ typedef bool (eepromRead_t) (void* eeprom, uint16_t addr, void* data, uint16_t d
 
 #define EEPROM_FIELDS						\
 	eepromWrite_t*		writeHandler;		\
-	eepromRead_t*		readHandler
+	eepromRead_t*		readHandler;		\
+	eepromRead_t*		readBackHandler
 
 /**
  * @brief Polymorphic base object representing an EEPROM.
- * @note When deriving this struct, use the @c EEPROM_FIELDS macro to define the first set of fields.
+ * @note When deriving this struct, use the @c EEPROM_FIELDS macro to define the first set of fields. The
+ * @c readBackHandler reads directly from the device's memory, bypassing any cache the @c readHandler reads from, and is used
+ * to verify writes. Devices without a cache should set it to @c NULL , in which case the @c readHandler is used instead (see
+ * @c eepromReadBack ).
  */
 typedef struct
 {
@@ -95,6 +100,16 @@ typedef struct
  */
 void eepromInit (eeprom_t* eeprom, eepromWrite_t* writeHandler, eepromRead_t* readHandler);
 
+/**
+ * @brief Reads a block of memory directly from an EEPROM, bypassing any cache. Used to verify the contents of the device.
+ * @param eeprom The EEPROM to read from ( @c eeprom_t* ).
+ * @param addr The address to read from.
+ * @param data Buffer to read the data into.
+ * @param dataCount The amount of data to read.
+ * @return True if successful, false otherwise.
+ */
+bool eepromReadBack (void* eeprom, uint16_t addr, void* data, uint16_t dataCount);
+
 /**
  * @brief Initializes a virtual EEPROM using the specified configuration.
  * @param eeprom The virtual EEPROM to initialize.
@@ -0,0 +1,67 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+// Host Benchmark Framework ---------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Timing helpers for the host-side benchmarks. Note host timings only indicate the relative cost of two
+//   implementations, absolute timings on the target will differ.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// C Standard Library
+#include <stdint.h>
+#include <time.h>
+
+#if defined (__x86_64__) || defined (__i386__)
+#include <x86intrin.h>
+#endif
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+/// @brief The number of times each benchmark is repeated, the median of the repetitions is reported.
+#define BENCHMARK_REPETITIONS 9
+
+/// @brief The unit of @c benchmarkTicks .
+#if defined (__x86_64__) || defined (__i386__)
+#define BENCHMARK_TICK_UNIT "cycles"
+#else
+#define BENCHMARK_TICK_UNIT "ns"
+#endif
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Gets the current value of the host's timestamp counter (reference cycles on x86, nanoseconds otherwise).
+ */
+static inline uint64_t benchmarkTicks (void)
+{
+#if defined (__x86_64__) || defined (__i386__)
+	return __rdtsc ();
+#else
+	struct timespec time;
+	clock_gettime (CLOCK_MONOTONIC, &time);
+	return (uint64_t) time.tv_sec * 1000000000 + time.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Gets the median of an array of samples. Note the array is sorted in the process.
+ */
+static inline uint64_t benchmarkMedian (uint64_t* samples, uint16_t count)
+{
+	for (uint16_t index = 1; index < count; ++index)
+	{
+		uint64_t sample = samples [index];
+		uint16_t position = index;
+		for (; position > 0 && samples [position - 1] > sample; --position)
+			samples [position] = samples [position - 1];
+		samples [position] = sample;
+	}
+
+	return samples [count / 2];
+}
+
+#endif // BENCHMARK_H
\ No newline at end of file
@@ -0,0 +1,322 @@
+// CAN Filter Packing Tests ---------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Table-driven tests of the CAN filter packing solver. Each case packs a set of identifiers and checks the number
+//   of banks used against the expected value. The resulting banks are then evaluated by a model of the bxCAN acceptance logic,
+//   checking that every requested identifier is accepted. Cases that fit in list mode banks are additionally checked to reject
+//   every other identifier. Lastly, random identifier sets are packed into random numbers of banks, checking the same
+//   properties.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// Includes
+#include "test.h"
+#include "can_filter.h"
+
+// C Standard Library
+#include <stdlib.h>
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+/// @brief The maximum number of identifiers in a single test case.
+#define CASE_ID_COUNT_MAX 32
+
+/// @brief The number of random identifier sets to test.
+#define FUZZ_CASE_COUNT 2000
+
+/// @brief The seed of the random identifier sets, fixed so failures are reproducible.
+#define FUZZ_SEED 0x5EED
+
+// Vehicle Identifiers --------------------------------------------------------------------------------------------------------
+
+// AMK inverters: motor feedback (+0x004), power consumption (+0x008), temperatures (+0x300) for each base ID.
+#define AMK_IDS(baseId) canIdStandard ((baseId) + 0x004), canIdStandard ((baseId) + 0x008), canIdStandard ((baseId) + 0x300)
+#define AMK_FLEET_IDS AMK_IDS (0x200), AMK_IDS (0x201), AMK_IDS (0x202), AMK_IDS (0x203)
+
+// BMS: status, power.
+#define BMS_IDS canIdStandard (0x101), canIdStandard (0x102)
+
+// ECUMaster GPS: position, velocity, heading / IMU 0, IMU 1, UTC.
+#define GPS_IDS canIdStandard (0x400), canIdStandard (0x401), canIdStandard (0x402), canIdStandard (0x403),					\
+	canIdStandard (0x404)
+
+// Bosch F02U V01: messages 1, 2, 3.
+#define BOSCH_IDS canIdStandard (0x174), canIdStandard (0x178), canIdStandard (0x17C)
+
+// TC charger: response.
+#define TC_IDS canIdExtended (0x18FF50E5)
+
+// Steering input board.
+#define SIB_IDS canIdStandard (0x600)
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+	/// @brief The name to print upon failure.
+	const char* name;
+
+	/// @brief The identifiers to pack.
+	canId_t ids [CASE_ID_COUNT_MAX];
+
+	/// @brief The number of elements in @c ids .
+	uint16_t idCount;
+
+	/// @brief The number of banks available to the solver.
+	uint8_t bankCount;
+
+	/// @brief The expected number of banks used, or -1 if the identifiers should not fit.
+	int8_t expectedBankCount;
+
+	/// @brief Indicates no identifiers other than those requested should be accepted.
+	bool exact;
+} testCase_t;
+
+// Test Cases -----------------------------------------------------------------------------------------------------------------
+
+#define CASE(caseName, bankCountMax, expected, isExact, ...)																\
+	{																														\
+		.name				= caseName,																						\
+		.ids				= { __VA_ARGS__ },																				\
+		.idCount			= sizeof ((canId_t []) { __VA_ARGS__ }) / sizeof (canId_t),										\
+		.bankCount			= bankCountMax,																					\
+		.expectedBankCount	= expected,																						\
+		.exact				= isExact																						\
+	}
+
+static const testCase_t CASES [] =
+{
+	// Individual nodes, each fits in list mode banks.
+	CASE ("AMK (1x)",			28, 1,	true,	AMK_IDS (0x200)),
+	CASE ("AMK (4x)",			28, 3,	true,	AMK_FLEET_IDS),
+	CASE ("BMS",				28, 1,	true,	BMS_IDS),
+	CASE ("GPS",				28, 2,	true,	GPS_IDS),
+	CASE ("Bosch",				28, 1,	true,	BOSCH_IDS),
+	CASE ("TC",					28, 1,	true,	TC_IDS),
+	CASE ("SIB",				28, 1,	true,	SIB_IDS),
+
+	// Duplicates are ignored.
+	CASE ("BMS (duplicated)",	28, 1,	true,	BMS_IDS, BMS_IDS, BMS_IDS),
+
+	// The full vehicle: 23 standard identifiers in 6 list banks, 1 extended identifier in 1 list bank.
+	CASE ("Vehicle",			28, 7,	true,	AMK_FLEET_IDS, BMS_IDS, GPS_IDS, BOSCH_IDS, TC_IDS, SIB_IDS),
+
+	// The full vehicle with too few banks, merges into mask mode banks.
+	CASE ("Vehicle (6 banks)",	6,	6,	false,	AMK_FLEET_IDS, BMS_IDS, GPS_IDS, BOSCH_IDS, TC_IDS, SIB_IDS),
+	CASE ("Vehicle (4 banks)",	4,	4,	false,	AMK_FLEET_IDS, BMS_IDS, GPS_IDS, BOSCH_IDS, TC_IDS, SIB_IDS),
+	CASE ("Vehicle (2 banks)",	2,	2,	false,	AMK_FLEET_IDS, BMS_IDS, GPS_IDS, BOSCH_IDS, TC_IDS, SIB_IDS),
+
+	// Standard and extended identifiers cannot share a bank.
+	CASE ("Vehicle (1 bank)",	1,	-1,	false,	AMK_FLEET_IDS, BMS_IDS, GPS_IDS, BOSCH_IDS, TC_IDS, SIB_IDS),
+
+	// Standard identifiers always merge into a single bank.
+	CASE ("AMK (4x, 1 bank)",	1,	1,	false,	AMK_FLEET_IDS),
+
+	// 5 standard identifiers: 1 list bank + 1 mask slot uses 2 banks, as does 2 list banks.
+	CASE ("GPS (2 banks)",		2,	2,	true,	GPS_IDS),
+	CASE ("GPS (1 bank)",		1,	1,	false,	GPS_IDS),
+
+	// Adjacent identifiers merge without accepting unwanted identifiers, 0x400 to 0x403 merge into a single mask.
+	CASE ("GPS (1 bank, mask)",	1,	1,	false,	canIdStandard (0x400), canIdStandard (0x401), canIdStandard (0x402),
+		canIdStandard (0x403)),
+
+	// Extended identifiers, 2 per list bank.
+	CASE ("Extended (3x)",		28, 2,	true,	canIdExtended (0x18FF50E5), canIdExtended (0x1806E5F4),
+		canIdExtended (0x00000001)),
+	CASE ("Extended (3x, 1)",	1,	1,	false,	canIdExtended (0x18FF50E5), canIdExtended (0x1806E5F4),
+		canIdExtended (0x00000001)),
+
+	// A standard and extended identifier sharing a value are distinct.
+	CASE ("Shared value",		28, 2,	true,	canIdStandard (0x123), canIdExtended (0x123)),
+};
+
+// Acceptance Model -----------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Gets the 16-bit filter representation of a received data frame (STID[10:0], RTR, IDE, EXID[17:15]).
+ */
+static uint32_t frameToFilter16 (canId_t id)
+{
+	uint32_t value = canIdGetValue (id);
+	if (!canIdIsExtended (id))
+		return value << 5;
+
+	return ((value >> 18) << 5) | (1 << 3) | ((value >> 15) & 0x7);
+}
+
+/**
+ * @brief Gets the 32-bit filter representation of a received data frame (STID[10:0] / EXID[28:0], IDE, RTR).
+ */
+static uint32_t frameToFilter32 (canId_t id)
+{
+	uint32_t value = canIdGetValue (id);
+	if (!canIdIsExtended (id))
+		return value << 21;
+
+	return (value << 3) | (1 << 2);
+}
+
+/**
+ * @brief Checks whether a bank accepts a data frame, modelling the bxCAN acceptance logic.
+ */
+static bool bankAccepts (const canFilterBank_t* bank, canId_t id)
+{
+	if (bank->scale == CAN_FILTER_SCALE_16)
+	{
+		uint32_t frame = frameToFilter16 (id);
+		uint32_t r1Low	= bank->register1 & 0xFFFF;
+		uint32_t r1High	= bank->register1 >> 16;
+		uint32_t r2Low	= bank->register2 & 0xFFFF;
+		uint32_t r2High	= bank->register2 >> 16;
+
+		if (bank->mode == CAN_FILTER_MODE_LIST)
+			return frame == r1Low || frame == r1High || frame == r2Low || frame == r2High;
+
+		// Each register is an identifier (low half) / mask (high half) pair.
+		return ((frame ^ r1Low) & r1High) == 0 || ((frame ^ r2Low) & r2High) == 0;
+	}
+
+	uint32_t frame = frameToFilter32 (id);
+
+	if (bank->mode == CAN_FILTER_MODE_LIST)
+		return frame == bank->register1 || frame == bank->register2;
+
+	return ((frame ^ bank->register1) & bank->register2) == 0;
+}
+
+static bool banksAccept (const canFilterBank_t* banks, int8_t bankCount, canId_t id)
+{
+	for (int8_t index = 0; index < bankCount; ++index)
+		if (bankAccepts (&banks [index], id))
+			return true;
+
+	return false;
+}
+
+static bool idsContain (const canId_t* ids, uint16_t idCount, canId_t id)
+{
+	for (uint16_t index = 0; index < idCount; ++index)
+		if (ids [index] == id)
+			return true;
+
+	return false;
+}
+
+// Tests ----------------------------------------------------------------------------------------------------------------------
+
+static void testCase (const testCase_t* test)
+{
+	// Fill the unused banks with a pattern, checking the solver writes only the banks it reports.
+	canFilterBank_t banks [CAN_FILTER_BANK_COUNT + 1];
+	for (uint8_t index = 0; index < CAN_FILTER_BANK_COUNT + 1; ++index)
+		banks [index] = (canFilterBank_t) { .mode = CAN_FILTER_MODE_MASK, .scale = CAN_FILTER_SCALE_32,
+			.register1 = 0xA5A5A5A5, .register2 = 0xFFFFFFFF };
+
+	int8_t bankCount = canFilterPack (test->ids, test->idCount, banks, test->bankCount);
+
+	TEST_CHECK (bankCount == test->expectedBankCount, "%s: Expected %i banks, got %i.", test->name,
+		test->expectedBankCount, bankCount);
+
+	if (bankCount < 0)
+		return;
+
+	TEST_CHECK (banks [test->bankCount].register1 == 0xA5A5A5A5, "%s: Bank %u overwritten.", test->name, test->bankCount);
+
+	// Each requested identifier must be accepted.
+	for (uint16_t index = 0; index < test->idCount; ++index)
+		TEST_CHECK (banksAccept (banks, bankCount, test->ids [index]), "%s: Identifier 0x%08X rejected.", test->name,
+			test->ids [index]);
+
+	// Remote frames are always rejected, as are identifiers sharing a value in the other domain.
+	for (uint16_t index = 0; index < test->idCount; ++index)
+	{
+		canId_t id = test->ids [index];
+		canId_t other = canIdIsExtended (id) ? canIdStandard (canIdGetValue (id)) : canIdExtended (canIdGetValue (id));
+		if (test->exact && !idsContain (test->ids, test->idCount, other))
+			TEST_CHECK (!banksAccept (banks, bankCount, other), "%s: Identifier 0x%08X accepted.", test->name, other);
+	}
+
+	if (!test->exact)
+		return;
+
+	// Exact cases must reject every other standard identifier.
+	for (uint32_t value = 0; value <= CAN_ID_STANDARD_MASK; ++value)
+	{
+		canId_t id = canIdStandard (value);
+		if (!idsContain (test->ids, test->idCount, id))
+			TEST_CHECK (!banksAccept (banks, bankCount, id), "%s: Identifier 0x%08X accepted.", test->name, id);
+	}
+}
+
+static void testFuzz (void)
+{
+	srand (FUZZ_SEED);
+
+	for (uint16_t caseIndex = 0; caseIndex < FUZZ_CASE_COUNT; ++caseIndex)
+	{
+		canId_t ids [CAN_FILTER_ID_COUNT_MAX];
+		uint16_t idCount = 1 + rand () % CAN_FILTER_ID_COUNT_MAX;
+		uint8_t bankCount = 1 + rand () % CAN_FILTER_BANK_COUNT;
+
+		// Mix dense identifiers (a small window, sharing bits) with sparse identifiers.
+		bool standard = false;
+		bool extended = false;
+		uint32_t window = rand () % 2 == 0 ? 0x3F : CAN_ID_EXTENDED_MASK;
+		uint8_t extendedPercent = rand () % 101;
+		for (uint16_t index = 0; index < idCount; ++index)
+		{
+			uint32_t value = ((uint32_t) rand () << 16 ^ (uint32_t) rand ()) & window;
+			if (rand () % 100 < extendedPercent)
+			{
+				ids [index] = canIdExtended (value);
+				extended = true;
+			}
+			else
+			{
+				ids [index] = canIdStandard (value);
+				standard = true;
+			}
+		}
+
+		canFilterBank_t banks [CAN_FILTER_BANK_COUNT];
+		int8_t result = canFilterPack (ids, idCount, banks, bankCount);
+
+		// Packing only fails when standard and extended identifiers must share the only bank.
+		bool feasible = bankCount >= standard + extended;
+		TEST_CHECK ((result >= 0) == feasible, "Fuzz case %u: %u identifiers, %u banks, result %i.", caseIndex, idCount,
+			bankCount, result);
+
+		if (result < 0)
+			continue;
+
+		TEST_CHECK (result <= bankCount, "Fuzz case %u: Used %i of %u banks.", caseIndex, result, bankCount);
+
+		for (uint16_t index = 0; index < idCount; ++index)
+			TEST_CHECK (banksAccept (banks, result, ids [index]), "Fuzz case %u: Identifier 0x%08X rejected.", caseIndex,
+				ids [index]);
+	}
+}
+
+int main (void)
+{
+	for (size_t index = 0; index < sizeof (CASES) / sizeof (CASES [0]); ++index)
+		testCase (&CASES [index]);
+
+	testFuzz ();
+
+	// The reject-all bank rejects every data frame, standard or extended.
+	canFilterBank_t rejectAll = canFilterRejectAll ();
+	for (uint32_t sid = 0; sid <= 0x7FF; ++sid)
+		TEST_CHECK (!bankAccepts (&rejectAll, canIdStandard (sid)), "Reject-all: Identifier 0x%03X accepted.", sid);
+	for (uint32_t eid = 0; eid <= 0x1FFFFFFF; eid += 0x1FFF)
+		TEST_CHECK (!bankAccepts (&rejectAll, canIdExtended (eid)), "Reject-all: Identifier 0x%08X accepted.", eid);
+
+	// Too many identifiers are rejected.
+	canId_t ids [CAN_FILTER_ID_COUNT_MAX + 1] = { 0 };
+	canFilterBank_t banks [CAN_FILTER_BANK_COUNT];
+	TEST_CHECK (canFilterPack (ids, CAN_FILTER_ID_COUNT_MAX + 1, banks, CAN_FILTER_BANK_COUNT) == -1, "Expected failure.");
+
+	return testResult ("can_filter_test");
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+// CAN ISO-TP Tests -----------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Tests of the reception side of the ISO-TP link, as performed by the CAN thread. Checks segmented messages are
+//   re-assembled, that flow control frames are sent without blocking, and that a message is aborted if its flow control frame
+//   cannot be sent.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// Includes
+#include "test.h"
+#include "can_iso_tp.h"
+
+// C Standard Library
+#include <string.h>
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+#define RX_ID		0x7E0
+#define TX_ID		0x7E8
+#define BLOCK_SIZE	2
+
+// Global Memory --------------------------------------------------------------------------------------------------------------
+
+static uint8_t buffer [64];
+
+static const canIsoTpConfig_t CONFIG =
+{
+	.name				= "iso_tp_test",
+	.driver				= &CAND1,
+	.rxId				= canIdStandard (RX_ID),
+	.txId				= canIdStandard (TX_ID),
+	.buffer				= buffer,
+	.bufferSize			= sizeof (buffer),
+	.blockSize			= BLOCK_SIZE,
+	.separationTime		= 0,
+	.transmitTimeout	= TIME_MS2I (10),
+	.flowControlTimeout	= TIME_MS2I (100)
+};
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+static CANRxFrame buildFrame (const uint8_t* data)
+{
+	CANRxFrame frame = { .IDE = CAN_IDE_STD, .SID = RX_ID, .DLC = 8 };
+	memcpy (frame.data8, data, 8);
+	return frame;
+}
+
+static bool isFlowControl (const CANTxFrame* frame, uint8_t flowStatus)
+{
+	return frame->IDE == CAN_IDE_STD && frame->SID == TX_ID && frame->data8 [0] == (0x30 | flowStatus) &&
+		frame->data8 [1] == BLOCK_SIZE;
+}
+
+// Tests ----------------------------------------------------------------------------------------------------------------------
+
+static void testReceiveSegmented (void)
+{
+	canIsoTpLink_t link;
+	canIsoTpInit (&link, &CONFIG);
+	stubTransmitReset ();
+
+	// 20 byte message: first frame (6 bytes), then 2 consecutive frames (7 bytes each).
+	CANRxFrame frame = buildFrame ((uint8_t []) { 0x10, 20, 0, 1, 2, 3, 4, 5 });
+	TEST_CHECK (canIsoTpReceive (&link, &frame), "First frame not accepted.");
+	TEST_CHECK (link.rxState == CAN_ISO_TP_RX_RECEIVING, "Expected receiving state, got %i.", link.rxState);
+
+	// Flow control must be sent, without blocking.
+	TEST_CHECK (stubTransmitCount == 1 && isFlowControl (&stubTransmitFrames [0], 0x0), "Expected a continue frame.");
+	TEST_CHECK (stubTransmitBlockingCount == 0, "Flow control sent using a blocking transmit.");
+
+	frame = buildFrame ((uint8_t []) { 0x21, 6, 7, 8, 9, 10, 11, 12 });
+	canIsoTpReceive (&link, &frame);
+
+	// Block complete, the next flow control is sent.
+	TEST_CHECK (stubTransmitCount == 1, "Flow control sent mid-block.");
+	frame = buildFrame ((uint8_t []) { 0x22, 13, 14, 15, 16, 17, 18, 19 });
+	canIsoTpReceive (&link, &frame);
+
+	TEST_CHECK (link.rxState == CAN_ISO_TP_RX_COMPLETE, "Expected complete state, got %i.", link.rxState);
+	TEST_CHECK (link.rxSize == 20 && link.rxMessageCount == 1 && link.rxErrorCount == 0, "Bad counts.");
+	for (uint8_t index = 0; index < 20; ++index)
+		TEST_CHECK (buffer [index] == index, "Byte %u: Expected %u, got %u.", index, index, buffer [index]);
+
+	TEST_CHECK (stubTransmitBlockingCount == 0, "Flow control sent using a blocking transmit.");
+}
+
+static void testReceiveBlocks (void)
+{
+	canIsoTpLink_t link;
+	canIsoTpInit (&link, &CONFIG);
+	stubTransmitReset ();
+
+	// 30 byte message: first frame, then 4 consecutive frames. Flow control is expected after the first frame and after the
+	// 2nd consecutive frame.
+	CANRxFrame frame = buildFrame ((uint8_t []) { 0x10, 30, 0, 0, 0, 0, 0, 0 });
+	canIsoTpReceive (&link, &frame);
+	for (uint8_t sequence = 1; sequence <= 4; ++sequence)
+	{
+		frame = buildFrame ((uint8_t []) { 0x20 | sequence, 0, 0, 0, 0, 0, 0, 0 });
+		canIsoTpReceive (&link, &frame);
+	}
+
+	TEST_CHECK (link.rxState == CAN_ISO_TP_RX_COMPLETE, "Expected complete state, got %i.", link.rxState);
+	TEST_CHECK (stubTransmitCount == 2, "Expected 2 flow control frames, got %u.", stubTransmitCount);
+	TEST_CHECK (stubTransmitBlockingCount == 0, "Flow control sent using a blocking transmit.");
+}
+
+static void testMailboxFull (void)
+{
+	canIsoTpLink_t link;
+	canIsoTpInit (&link, &CONFIG);
+	stubTransmitReset ();
+
+	// If the flow control frame cannot be sent, the message is aborted rather than waiting for a mailbox.
+	stubTransmitFull = true;
+	CANRxFrame frame = buildFrame ((uint8_t []) { 0x10, 20, 0, 1, 2, 3, 4, 5 });
+	canIsoTpReceive (&link, &frame);
+
+	TEST_CHECK (link.rxState == CAN_ISO_TP_RX_IDLE, "Expected idle state, got %i.", link.rxState);
+	TEST_CHECK (link.rxErrorCount == 1, "Expected 1 error, got %u.", link.rxErrorCount);
+	TEST_CHECK (stubTransmitBlockingCount == 0, "Flow control sent using a blocking transmit.");
+
+	// Consecutive frames of the aborted message are ignored.
+	frame = buildFrame ((uint8_t []) { 0x21, 6, 7, 8, 9, 10, 11, 12 });
+	canIsoTpReceive (&link, &frame);
+	TEST_CHECK (link.rxState == CAN_ISO_TP_RX_IDLE, "Expected idle state, got %i.", link.rxState);
+
+	// The next message is received once a mailbox is free.
+	stubTransmitFull = false;
+	frame = buildFrame ((uint8_t []) { 0x10, 20, 0, 1, 2, 3, 4, 5 });
+	canIsoTpReceive (&link, &frame);
+	TEST_CHECK (link.rxState == CAN_ISO_TP_RX_RECEIVING, "Expected receiving state, got %i.", link.rxState);
+	TEST_CHECK (stubTransmitCount == 1, "Expected a continue frame.");
+}
+
+int main (void)
+{
+	testReceiveSegmented ();
+	testReceiveBlocks ();
+	testMailboxFull ();
+
+	return testResult ("can_iso_tp_test");
+}
\ No newline at end of file
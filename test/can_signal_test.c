@@ -0,0 +1,260 @@
+// CAN Signal Decoding Tests --------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Tests of the table-driven signal decoder against the hand-written receive handlers of the BMS, Bosch IMU, and
+//   ECUMaster GPS nodes (see signal_tables.h). Each frame is decoded by both the node's receive handler and the node's signal
+//   table, checking the outputs are bit-for-bit identical. The ECUMaster GPS covers big-endian signals, and is additionally
+//   decoded one signal at a time using canSignalDecodeSignal.
+//
+//   Frames are generated by sweeping every value of each 16-bit word of the payload (with the remaining bytes randomized),
+//   followed by fully random payloads.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// Includes
+#include "test.h"
+#include "signal_tables.h"
+#include "ecumaster_gps_v2.h"
+
+// C Standard Library
+#include <stdlib.h>
+#include <string.h>
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+/// @brief The number of random payloads to test, per message.
+#define RANDOM_FRAME_COUNT 100000
+
+/// @brief The seed of the random payloads, fixed so failures are reproducible.
+#define RANDOM_SEED 0x5EED
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+	/// @brief The name to print upon failure.
+	const char* name;
+
+	/// @brief The struct decoded by the signal table.
+	canNode_t* node;
+
+	/// @brief The receive handler decoding the node's signal table.
+	canReceiveHandler_t* handler;
+
+	/// @brief The reference node, initialized by the node's init function.
+	canNode_t* reference;
+
+	/// @brief The offset of the node's decoded fields (following the node's common fields).
+	size_t fieldsOffset;
+
+	/// @brief The size of the node's struct.
+	size_t size;
+
+	/// @brief The identifiers to test.
+	uint16_t ids [4];
+
+	/// @brief The number of elements in @c ids .
+	uint8_t idCount;
+} testCase_t;
+
+// Tests ----------------------------------------------------------------------------------------------------------------------
+
+static uint8_t randomByte (void)
+{
+	return (uint8_t) (rand () >> 4);
+}
+
+static void testFrame (const testCase_t* test, CANRxFrame* frame)
+{
+	int8_t index = test->handler (test->node, frame);
+	int8_t referenceIndex = test->reference->receiveHandler (test->reference, frame);
+
+	TEST_CHECK (index == referenceIndex, "%s: ID 0x%03X: Expected index %i, got %i.", test->name, frame->SID, referenceIndex,
+		index);
+
+	// Compare the decoded fields bit-for-bit.
+	const uint8_t* fields = (uint8_t*) test->node + test->fieldsOffset;
+	const uint8_t* referenceFields = (uint8_t*) test->reference + test->fieldsOffset;
+	TEST_CHECK (memcmp (fields, referenceFields, test->size - test->fieldsOffset) == 0,
+		"%s: ID 0x%03X: Payload 0x%016llX decoded differently.", test->name, frame->SID,
+		(unsigned long long) frame->data64 [0]);
+}
+
+static void testCase (const testCase_t* test)
+{
+	// Both structs start from the same (zeroed) state, such that fields not written by a message compare equal.
+	memset ((uint8_t*) test->node + test->fieldsOffset, 0, test->size - test->fieldsOffset);
+	memset ((uint8_t*) test->reference + test->fieldsOffset, 0, test->size - test->fieldsOffset);
+
+	CANRxFrame frame = { .IDE = CAN_IDE_STD, .DLC = 8 };
+
+	for (uint8_t idIndex = 0; idIndex < test->idCount; ++idIndex)
+	{
+		frame.SID = test->ids [idIndex];
+
+		// Sweep each 16-bit word.
+		for (uint8_t word = 0; word < 4; ++word)
+		{
+			for (uint32_t value = 0; value <= UINT16_MAX; ++value)
+			{
+				for (uint8_t byte = 0; byte < 8; ++byte)
+					frame.data8 [byte] = randomByte ();
+				frame.data16 [word] = (uint16_t) value;
+
+				testFrame (test, &frame);
+			}
+		}
+
+		// Random payloads.
+		for (uint32_t count = 0; count < RANDOM_FRAME_COUNT; ++count)
+		{
+			for (uint8_t byte = 0; byte < 8; ++byte)
+				frame.data8 [byte] = randomByte ();
+
+			testFrame (test, &frame);
+		}
+	}
+
+	// Messages not belonging to the node are ignored.
+	frame.SID = 0x7FF;
+	testFrame (test, &frame);
+}
+
+static bool floatsIdentical (float a, float b)
+{
+	return memcmp (&a, &b, sizeof (float)) == 0;
+}
+
+static bool ecumasterIdentical (const ecumasterSignals_t* signals, const ecumasterGps_t* gps)
+{
+	return floatsIdentical (signals->latitude, gps->latitude) && floatsIdentical (signals->longitude, gps->longitude) &&
+		floatsIdentical (signals->speed, gps->speed) && floatsIdentical (signals->height, gps->height) &&
+		signals->satellitesNumber == gps->satellitesNumber && signals->gpsFrameIndex == gps->gpsFrameIndex &&
+		signals->emptyFrameIndex == gps->emptyFrameIndex && signals->gpsStatus == gps->gpsStatus &&
+		floatsIdentical (signals->headingMotion, gps->headingMotion) &&
+		floatsIdentical (signals->headingVehicle, gps->headingVehicle) &&
+		floatsIdentical (signals->xAngleRate, gps->xAngleRate) && floatsIdentical (signals->yAngleRate, gps->yAngleRate) &&
+		floatsIdentical (signals->zAngleRate, gps->zAngleRate) &&
+		floatsIdentical (signals->xAcceleration, gps->xAcceleration) &&
+		floatsIdentical (signals->yAcceleration, gps->yAcceleration) &&
+		floatsIdentical (signals->zAcceleration, gps->zAcceleration);
+}
+
+static void testEcumasterFrame (ecumasterGps_t* gps, ecumasterSignals_t* signals, ecumasterSignals_t* signalsSingle,
+	CANRxFrame* frame)
+{
+	int8_t referenceIndex = gps->receiveHandler (gps, frame);
+	int8_t index = canSignalDecode (ECUMASTER_MESSAGES, ECUMASTER_MESSAGE_COUNT, signals, canIdFromFrame (frame),
+		frame->data8);
+
+	TEST_CHECK (index == referenceIndex, "ECUMaster: ID 0x%03X: Expected index %i, got %i.", frame->SID, referenceIndex,
+		index);
+	TEST_CHECK (ecumasterIdentical (signals, gps), "ECUMaster: ID 0x%03X: Payload 0x%016llX decoded differently.", frame->SID,
+		(unsigned long long) frame->data64 [0]);
+
+	// Decoding each signal individually must match decoding the whole message.
+	if (index < 0)
+		return;
+
+	const canSignalMessage_t* message = &ECUMASTER_MESSAGES [index];
+	for (uint8_t signal = 0; signal < message->signalCount; ++signal)
+		canSignalDecodeSignal (&message->signals [signal], signalsSingle, frame->data8);
+
+	TEST_CHECK (ecumasterIdentical (signalsSingle, gps),
+		"ECUMaster: ID 0x%03X: Payload 0x%016llX decoded differently by canSignalDecodeSignal.", frame->SID,
+		(unsigned long long) frame->data64 [0]);
+}
+
+static void testEcumaster (void)
+{
+	ecumasterGps_t gps;
+	ecumasterInit (&gps, &(ecumasterGpsConfig_t) { .driver = &CAND1, .timeoutPeriod = TIME_MS2I (100),
+		.lazyDecode = false });
+
+	// All structs start from the same (zeroed) state, such that fields not written by a message compare equal.
+	ecumasterSignals_t signals = { 0 };
+	ecumasterSignals_t signalsSingle = { 0 };
+	memset (&gps.latitude, 0, offsetof (ecumasterGps_t, lazyDecode) - offsetof (ecumasterGps_t, latitude));
+
+	const uint16_t ids [] =
+	{
+		ECUMASTER_POSITION_MESSAGE_ID, ECUMASTER_VELOCITY_MESSAGE_ID, ECUMASTER_HEADING_IMU0_MESSAGE_ID,
+		ECUMASTER_IMU1_MESSAGE_ID
+	};
+
+	CANRxFrame frame = { .IDE = CAN_IDE_STD, .DLC = 8 };
+
+	for (uint8_t idIndex = 0; idIndex < sizeof (ids) / sizeof (ids [0]); ++idIndex)
+	{
+		frame.SID = ids [idIndex];
+
+		// Sweep each 16-bit word.
+		for (uint8_t word = 0; word < 4; ++word)
+		{
+			for (uint32_t value = 0; value <= UINT16_MAX; ++value)
+			{
+				for (uint8_t byte = 0; byte < 8; ++byte)
+					frame.data8 [byte] = randomByte ();
+				frame.data16 [word] = (uint16_t) value;
+
+				testEcumasterFrame (&gps, &signals, &signalsSingle, &frame);
+			}
+		}
+
+		// Random payloads.
+		for (uint32_t count = 0; count < RANDOM_FRAME_COUNT; ++count)
+		{
+			for (uint8_t byte = 0; byte < 8; ++byte)
+				frame.data8 [byte] = randomByte ();
+
+			testEcumasterFrame (&gps, &signals, &signalsSingle, &frame);
+		}
+	}
+
+	// Messages not belonging to the node are ignored.
+	frame.SID = 0x7FF;
+	testEcumasterFrame (&gps, &signals, &signalsSingle, &frame);
+}
+
+int main (void)
+{
+	srand (RANDOM_SEED);
+
+	bms_t bms;
+	bms_t bmsReference;
+	bmsInit (&bmsReference, &(bmsConfig_t) { .driver = &CAND1, .timeoutPeriod = TIME_MS2I (100) });
+
+	testCase (&(testCase_t)
+	{
+		.name				= "BMS",
+		.node				= (canNode_t*) &bms,
+		.handler			= bmsTableHandler,
+		.reference			= (canNode_t*) &bmsReference,
+		.fieldsOffset		= offsetof (bms_t, bmsFault),
+		.size				= sizeof (bms_t),
+		.ids				= { BMS_STATUS_MESSAGE_ID, BMS_POWER_MESSAGE_ID },
+		.idCount			= 2
+	});
+
+	boschF02uV01_t imu;
+	boschF02uV01_t imuReference;
+	boschF02uV01Init (&imuReference, &(boschF02uV01Config_t) { .driver = &CAND1, .timeoutPeriod = TIME_MS2I (100) });
+
+	testCase (&(testCase_t)
+	{
+		.name				= "Bosch F02U V01",
+		.node				= (canNode_t*) &imu,
+		.handler			= boschTableHandler,
+		.reference			= (canNode_t*) &imuReference,
+		.fieldsOffset		= offsetof (boschF02uV01_t, xAcceleration),
+		.size				= sizeof (boschF02uV01_t),
+		.ids				= { BOSCH_MESSAGE_1_ID, BOSCH_MESSAGE_2_ID, BOSCH_MESSAGE_3_ID },
+		.idCount			= 3
+	});
+
+	testEcumaster ();
+
+	return testResult ("can_signal_test");
+}
\ No newline at end of file
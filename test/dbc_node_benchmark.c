@@ -0,0 +1,128 @@
+// DBC Node Generator Benchmark -----------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Compares the cost of the receive handler generated from dbc/bms.dbc against the hand-written BMS node's receive
+//   handler and the table-driven decoder (using the BMS signal table of signal_tables.h). Each handler decodes the same set of
+//   random frames, and is called through a function pointer, as by @c canNodeReceive . The fastest of many interleaved
+//   repetitions of each handler is compared, and the benchmark fails if the generated handler is more than 5% slower than the
+//   hand-written one, the noise of the comparison. Note the generated handler additionally rejects extended identifiers, which
+//   the hand-written handler does not.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// Includes
+#include "benchmark.h"
+#include "signal_tables.h"
+#include "dbc_bms.h"
+
+// C Standard Library
+#include <stdio.h>
+#include <stdlib.h>
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+/// @brief The number of distinct frames to decode.
+#define FRAME_COUNT 1024
+
+/// @brief The number of times each frame is decoded, per repetition.
+#define PASS_COUNT 1000
+
+/// @brief The number of repetitions of each handler, the fastest of which is compared.
+#define REPETITION_COUNT 31
+
+/// @brief The tolerance of the comparison, allowing for the noise of the fastest repetitions.
+#define TOLERANCE 1.05f
+
+/// @brief The seed of the random payloads, fixed so results are reproducible.
+#define RANDOM_SEED 0x5EED
+
+// Global Memory --------------------------------------------------------------------------------------------------------------
+
+static CANRxFrame frames [FRAME_COUNT];
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Measures the cost of a single pass of a receive handler over each frame.
+ * @return The number of ticks elapsed.
+ */
+static uint64_t measure (canReceiveHandler_t* volatile handler, void* node)
+{
+	uint64_t start = benchmarkTicks ();
+	for (uint16_t pass = 0; pass < PASS_COUNT; ++pass)
+		for (uint16_t index = 0; index < FRAME_COUNT; ++index)
+			handler (node, &frames [index]);
+	return benchmarkTicks () - start;
+}
+
+int main (void)
+{
+	srand (RANDOM_SEED);
+
+	// Frames are a random mix of the status message, the power message, and messages of other nodes.
+	const uint16_t ids [] = { BMS_STATUS_MESSAGE_ID, BMS_POWER_MESSAGE_ID, 0x174, 0x400 };
+	for (uint16_t index = 0; index < FRAME_COUNT; ++index)
+	{
+		frames [index] = (CANRxFrame) { .IDE = CAN_IDE_STD, .DLC = 8 };
+		frames [index].SID = ids [rand () % (sizeof (ids) / sizeof (ids [0]))];
+		for (uint8_t byte = 0; byte < 8; ++byte)
+			frames [index].data8 [byte] = (uint8_t) (rand () >> 4);
+	}
+
+	bms_t reference;
+	bmsInit (&reference, &(bmsConfig_t) { .driver = &CAND1, .timeoutPeriod = TIME_MS2I (100) });
+
+	bms_t table;
+
+	dbcBms_t generated;
+	dbcBmsInit (&generated, &(dbcBmsConfig_t) { .driver = &CAND1, .timeoutPeriod = TIME_MS2I (100) });
+
+	// Repetitions of each handler are interleaved, alternating their order, such that changes in the host's clock and the state
+	// left by the previous handler affect each equally. The fastest repetition of each is compared, as interference from the
+	// host only ever adds to a repetition's cost.
+	uint64_t referenceMinimum = UINT64_MAX;
+	uint64_t tableMinimum = UINT64_MAX;
+	uint64_t generatedMinimum = UINT64_MAX;
+	for (uint16_t repetition = 0; repetition < REPETITION_COUNT; ++repetition)
+	{
+		uint64_t referenceSample;
+		uint64_t tableSample;
+		uint64_t generatedSample;
+		if (repetition % 2 == 0)
+		{
+			referenceSample	= measure (reference.receiveHandler, &reference);
+			tableSample		= measure (bmsTableHandler, &table);
+			generatedSample	= measure (generated.receiveHandler, &generated);
+		}
+		else
+		{
+			generatedSample	= measure (generated.receiveHandler, &generated);
+			tableSample		= measure (bmsTableHandler, &table);
+			referenceSample	= measure (reference.receiveHandler, &reference);
+		}
+
+		referenceMinimum	= referenceSample < referenceMinimum ? referenceSample : referenceMinimum;
+		tableMinimum		= tableSample < tableMinimum ? tableSample : tableMinimum;
+		generatedMinimum	= generatedSample < generatedMinimum ? generatedSample : generatedMinimum;
+	}
+
+	float frameCount = (float) PASS_COUNT * FRAME_COUNT;
+	float referenceTicks = referenceMinimum / frameCount;
+	float tableTicks = tableMinimum / frameCount;
+	float generatedTicks = generatedMinimum / frameCount;
+
+	printf ("dbc_node_benchmark: BMS receive handler (%s per frame):\n", BENCHMARK_TICK_UNIT);
+	printf ("  Hand-written:  %6.2f\n", referenceTicks);
+	printf ("  Signal table:  %6.2f (%.2fx)\n", tableTicks, referenceTicks / tableTicks);
+	printf ("  Generated:     %6.2f (%.2fx)\n", generatedTicks, referenceTicks / generatedTicks);
+
+	if (generatedTicks > referenceTicks * TOLERANCE)
+	{
+		printf ("dbc_node_benchmark: Generated handler is more than 5%% slower than the hand-written handler.\n");
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
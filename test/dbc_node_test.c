@@ -0,0 +1,203 @@
+// DBC Node Generator Tests ---------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Tests of the CAN node generated from dbc/bms.dbc by tools/dbc_to_can_node.py. The generated receive handler is
+//   checked against the hand-written BMS node's receive handler, and the generated pack function is checked to
+//   round and saturate each signal, including big-endian, signed, and offset signals. The node generated from dbc/inverter.dbc
+//   is checked to qualify signal names reused across messages.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// Includes
+#include "test.h"
+#include "signal_tables.h"
+#include "dbc_bms.h"
+#include "dbc_inverter.h"
+
+// C Standard Library
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+/// @brief The number of random payloads to test, per message.
+#define RANDOM_FRAME_COUNT 100000
+
+/// @brief The seed of the random payloads, fixed so failures are reproducible.
+#define RANDOM_SEED 0x5EED
+
+// Tests ----------------------------------------------------------------------------------------------------------------------
+
+static bool floatsIdentical (float a, float b)
+{
+	return memcmp (&a, &b, sizeof (float)) == 0;
+}
+
+static void testReceive (void)
+{
+	dbcBms_t node;
+	dbcBmsInit (&node, &(dbcBmsConfig_t) { .driver = &CAND1, .timeoutPeriod = TIME_MS2I (100) });
+
+	bms_t reference;
+	bmsInit (&reference, &(bmsConfig_t) { .driver = &CAND1, .timeoutPeriod = TIME_MS2I (100) });
+	const uint16_t ids [] = { BMS_STATUS_MESSAGE_ID, BMS_POWER_MESSAGE_ID, 0x7FF };
+
+	for (uint8_t idIndex = 0; idIndex < sizeof (ids) / sizeof (ids [0]); ++idIndex)
+	{
+		CANRxFrame frame = { .IDE = CAN_IDE_STD, .DLC = 8, .SID = ids [idIndex] };
+
+		for (uint32_t count = 0; count < RANDOM_FRAME_COUNT; ++count)
+		{
+			for (uint8_t byte = 0; byte < 8; ++byte)
+				frame.data8 [byte] = (uint8_t) (rand () >> 4);
+
+			int8_t index = node.receiveHandler (&node, &frame);
+			int8_t referenceIndex = reference.receiveHandler (&reference, &frame);
+			TEST_CHECK (index == referenceIndex, "ID 0x%03X: Expected index %i, got %i.", frame.SID, referenceIndex, index);
+
+			if (index == BMS_STATUS_MESSAGE_FLAG_POS)
+			{
+				TEST_CHECK (node.bmsFault == reference.bmsFault && node.imdFault == reference.imdFault &&
+					node.charging == reference.charging && node.balancing == reference.balancing &&
+					node.negativeIrClosed == reference.negativeIrClosed && node.positiveIrClosed == reference.positiveIrClosed,
+					"Status payload 0x%016llX decoded differently.", (unsigned long long) frame.data64 [0]);
+			}
+			else if (index == BMS_POWER_MESSAGE_FLAG_POS)
+			{
+				TEST_CHECK (floatsIdentical (node.packVoltage, reference.packVoltage) &&
+					floatsIdentical (node.packCurrent, reference.packCurrent) &&
+					floatsIdentical (node.powerDelivery, reference.powerDelivery),
+					"Power payload 0x%016llX decoded differently.", (unsigned long long) frame.data64 [0]);
+			}
+		}
+	}
+
+	// Extended identifiers sharing the value of a message's identifier are rejected.
+	CANRxFrame frame = { .IDE = CAN_IDE_EXT, .DLC = 8, .EID = BMS_STATUS_MESSAGE_ID };
+	TEST_CHECK (node.receiveHandler (&node, &frame) == -1, "Extended identifier accepted.");
+}
+
+typedef struct
+{
+	float currentLimit;
+	float temperatureOffset;
+	float voltageTarget;
+	bool enable;
+
+	uint16_t currentLimitRaw;
+	int8_t temperatureOffsetRaw;
+	uint16_t voltageTargetRaw;
+} packCase_t;
+
+static const packCase_t PACK_CASES [] =
+{
+	// Exact values.
+	{ .currentLimit = 100.0f,	.temperatureOffset = 0.0f,		.voltageTarget = 400.0f,	.enable = true,
+		.currentLimitRaw = 1000,	.temperatureOffsetRaw = 20,		.voltageTargetRaw = 40000 },
+
+	// Rounding to the nearest raw value (rather than truncating), halfway cases away from zero.
+	{ .currentLimit = 0.04f,	.temperatureOffset = -10.3f,	.voltageTarget = 0.006f,	.enable = false,
+		.currentLimitRaw = 0,		.temperatureOffsetRaw = -1,		.voltageTargetRaw = 1 },
+	{ .currentLimit = 0.06f,	.temperatureOffset = -10.75f,	.voltageTarget = 0.004f,	.enable = false,
+		.currentLimitRaw = 1,		.temperatureOffsetRaw = -2,		.voltageTargetRaw = 0 },
+	{ .currentLimit = 0.15f,	.temperatureOffset = -9.75f,	.voltageTarget = 1.235f,	.enable = false,
+		.currentLimitRaw = 2,		.temperatureOffsetRaw = 1,		.voltageTargetRaw = 124 },
+
+	// Saturation below the range, including negative values into unsigned signals.
+	{ .currentLimit = -5.0f,	.temperatureOffset = -100.0f,	.voltageTarget = -1e30f,	.enable = true,
+		.currentLimitRaw = 0,		.temperatureOffsetRaw = -128,	.voltageTargetRaw = 0 },
+
+	// Saturation above the range.
+	{ .currentLimit = 7000.0f,	.temperatureOffset = 100.0f,	.voltageTarget = 1e30f,		.enable = true,
+		.currentLimitRaw = 65535,	.temperatureOffsetRaw = 127,	.voltageTargetRaw = 65535 },
+
+	// Limits of the range.
+	{ .currentLimit = 6553.5f,	.temperatureOffset = 53.5f,		.voltageTarget = 655.35f,	.enable = true,
+		.currentLimitRaw = 65535,	.temperatureOffsetRaw = 127,	.voltageTargetRaw = 65535 },
+	{ .currentLimit = 0.0f,		.temperatureOffset = -74.0f,	.voltageTarget = 0.0f,		.enable = false,
+		.currentLimitRaw = 0,		.temperatureOffsetRaw = -128,	.voltageTargetRaw = 0 },
+
+	// Non-finite values.
+	{ .currentLimit = NAN,		.temperatureOffset = NAN,		.voltageTarget = INFINITY,	.enable = false,
+		.currentLimitRaw = 0,		.temperatureOffsetRaw = -128,	.voltageTargetRaw = 65535 },
+	{ .currentLimit = INFINITY,	.temperatureOffset = -INFINITY,	.voltageTarget = NAN,		.enable = false,
+		.currentLimitRaw = 65535,	.temperatureOffsetRaw = -128,	.voltageTargetRaw = 0 },
+};
+
+static void testPack (void)
+{
+	for (size_t index = 0; index < sizeof (PACK_CASES) / sizeof (PACK_CASES [0]); ++index)
+	{
+		const packCase_t* test = &PACK_CASES [index];
+
+		CANTxFrame frame;
+		dbcBmsPackLimits (&frame, test->currentLimit, test->temperatureOffset, test->voltageTarget, test->enable);
+
+		TEST_CHECK (frame.IDE == CAN_IDE_STD && frame.SID == 0x300 && frame.DLC == 8, "Case %zu: Bad header.", index);
+
+		// Current limit: little-endian unsigned, bytes 0 & 1.
+		uint16_t currentLimitRaw = frame.data8 [0] | (frame.data8 [1] << 8);
+		TEST_CHECK (currentLimitRaw == test->currentLimitRaw, "Case %zu: Current limit: Expected %u, got %u.", index,
+			test->currentLimitRaw, currentLimitRaw);
+
+		// Temperature offset: little-endian signed, byte 2.
+		int8_t temperatureOffsetRaw = (int8_t) frame.data8 [2];
+		TEST_CHECK (temperatureOffsetRaw == test->temperatureOffsetRaw, "Case %zu: Temperature offset: Expected %i, got %i.",
+			index, test->temperatureOffsetRaw, temperatureOffsetRaw);
+
+		// Voltage target: big-endian unsigned, MSB in byte 3, LSB in byte 4.
+		uint16_t voltageTargetRaw = (frame.data8 [3] << 8) | frame.data8 [4];
+		TEST_CHECK (voltageTargetRaw == test->voltageTargetRaw, "Case %zu: Voltage target: Expected %u, got %u.", index,
+			test->voltageTargetRaw, voltageTargetRaw);
+
+		// Enable: bit 0 of byte 5. Saturated signals must not overflow into neighbouring signals.
+		TEST_CHECK (frame.data8 [5] == (test->enable ? 1 : 0), "Case %zu: Enable: Got 0x%02X.", index, frame.data8 [5]);
+		TEST_CHECK (frame.data8 [6] == 0 && frame.data8 [7] == 0, "Case %zu: Unused bytes written.", index);
+	}
+}
+
+static void testNameCollisions (void)
+{
+	static const sysinterval_t MESSAGE_TIMEOUT_PERIODS [] = { TIME_MS2I (10), TIME_MS2I (100) };
+
+	dbcInverter_t node;
+	dbcInverterInit (&node, &(dbcInverterConfig_t)
+	{
+		.driver					= &CAND1,
+		.timeoutPeriod			= TIME_MS2I (100),
+		.messageTimeoutPeriods	= MESSAGE_TIMEOUT_PERIODS
+	});
+	TEST_CHECK (node.messageTimeoutPeriods == MESSAGE_TIMEOUT_PERIODS, "Message timeout periods not forwarded.");
+
+	// Signals named uniquely keep their own name, reused names and names of the CAN node's fields are qualified with their
+	// message's name.
+	CANRxFrame frame = { .IDE = CAN_IDE_STD, .DLC = 8, .SID = 0x201, .data64 = { 0x5A00000000000123 } };
+	node.receiveHandler (&node, &frame);
+	frame = (CANRxFrame) { .IDE = CAN_IDE_STD, .DLC = 8, .SID = 0x202, .data64 = { 0x3C000000000000A7 } };
+	node.receiveHandler (&node, &frame);
+
+	TEST_CHECK (node.speed == 0x123 && node.feedbackCounter == 0xA && node.feedbackCrc == 0x5,
+		"Feedback decoded as %f, %f, %f.", node.speed, node.feedbackCounter, node.feedbackCrc);
+	TEST_CHECK (node.statusState == 0xA7 && node.statusCounter == 0xC && node.statusCrc == 0x3,
+		"Status decoded as %f, %f, %f.", node.statusState, node.statusCounter, node.statusCrc);
+
+	// Signals colliding with the frame parameter are qualified with their message's name.
+	CANTxFrame txFrame;
+	dbcInverterPackCommand (&txFrame, 0x42, 0x7);
+	TEST_CHECK (txFrame.SID == 0x301 && txFrame.data64 [0] == 0x0700000000000042, "Command packed as 0x%016llX.",
+		(unsigned long long) txFrame.data64 [0]);
+}
+
+int main (void)
+{
+	srand (RANDOM_SEED);
+
+	testReceive ();
+	testPack ();
+	testNameCollisions ();
+
+	return testResult ("dbc_node_test");
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+// ECUMaster GPS Tests --------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Tests of the ECUMaster GPS node's lazy decoding. Checks the accessor functions decode pending messages
+//   themselves, such that a lazy node reads identically to an eager node.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// Includes
+#include "test.h"
+#include "ecumaster_gps_v2.h"
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+#define POSITION_MESSAGE_ID		0x400
+#define VELOCITY_MESSAGE_ID		0x401
+#define HEADING_IMU0_MESSAGE_ID	0x402
+#define IMU1_MESSAGE_ID			0x403
+#define UTC_MESSAGE_ID			0x404
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+static void receive (ecumasterGps_t* gps, uint16_t id, ecumasterGpsStatus_t status)
+{
+	// The GPS status is the lower 3 bits of the velocity message's last byte.
+	CANRxFrame frame = { .IDE = CAN_IDE_STD, .SID = id, .DLC = 8 };
+	frame.data8 [7] = (uint8_t) status;
+	canNodeReceive ((canNode_t*) gps, &frame);
+}
+
+static void receiveAll (ecumasterGps_t* gps, ecumasterGpsStatus_t status)
+{
+	const uint16_t ids [] = { POSITION_MESSAGE_ID, VELOCITY_MESSAGE_ID, HEADING_IMU0_MESSAGE_ID, IMU1_MESSAGE_ID, UTC_MESSAGE_ID };
+	for (uint8_t index = 0; index < sizeof (ids) / sizeof (ids [0]); ++index)
+		receive (gps, ids [index], status);
+}
+
+// Tests ----------------------------------------------------------------------------------------------------------------------
+
+static void testAccessors (bool lazyDecode)
+{
+	ecumasterGps_t gps;
+	ecumasterInit (&gps, &(ecumasterGpsConfig_t) { .driver = &CAND1, .timeoutPeriod = TIME_MS2I (100),
+		.lazyDecode = lazyDecode });
+
+	TEST_CHECK (ecumasterGetGpsStatusLock (&gps) == ECUMASTER_GPS_STATUS_INVALID, "Lazy %i: Incomplete node not invalid.",
+		lazyDecode);
+
+	// Accessors must reflect the latest message, without an explicit decode.
+	receiveAll (&gps, ECUMASTER_GPS_STATUS_3D);
+	TEST_CHECK (ecumasterGetGpsStatusLock (&gps) == ECUMASTER_GPS_STATUS_3D, "Lazy %i: Expected 3D status, got %i.",
+		lazyDecode, gps.gpsStatus);
+	TEST_CHECK (ecumasterGpsValidLock (&gps), "Lazy %i: Expected valid GPS.", lazyDecode);
+
+	receive (&gps, VELOCITY_MESSAGE_ID, ECUMASTER_GPS_STATUS_NO_FIX);
+	TEST_CHECK (!ecumasterGpsValidLock (&gps), "Lazy %i: Expected invalid GPS, got status %i.", lazyDecode, gps.gpsStatus);
+
+	// Unlocked accessors decode the node as well.
+	receive (&gps, VELOCITY_MESSAGE_ID, ECUMASTER_GPS_STATUS_2D);
+	canNodeLock ((canNode_t*) &gps);
+	TEST_CHECK (ecumasterGpsValid (&gps), "Lazy %i: Expected valid GPS, got status %i.", lazyDecode, gps.gpsStatus);
+	TEST_CHECK (gps.lazy.pendingFlags == 0, "Lazy %i: Messages left pending.", lazyDecode);
+	canNodeUnlock ((canNode_t*) &gps);
+}
+
+int main (void)
+{
+	testAccessors (false);
+	testAccessors (true);
+
+	return testResult ("ecumaster_gps_test");
+}
\ No newline at end of file
@@ -0,0 +1,188 @@
+#ifndef SIGNAL_TABLES_H
+#define SIGNAL_TABLES_H
+
+// Signal Tables --------------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Signal tables (see can_signal.h) describing the messages of the BMS, Bosch IMU, and ECUMaster GPS nodes. The
+//   nodes themselves use hand-written receive handlers, as these are several times cheaper than the table-driven decoder.
+//   These tables are used to check the decoder against the hand-written handlers, covering both byte orders (the BMS and
+//   Bosch IMU are little-endian, the ECUMaster GPS is big-endian).
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+#include "can_signal.h"
+#include "bms.h"
+#include "bosch_f_02u_v01.h"
+
+// BMS ------------------------------------------------------------------------------------------------------------------------
+
+#define BMS_STATUS_MESSAGE_ID		0x101
+#define BMS_POWER_MESSAGE_ID		0x102
+
+#define BMS_STATUS_MESSAGE_FLAG_POS 0x00
+#define BMS_POWER_MESSAGE_FLAG_POS	0x01
+
+static const canSignal_t BMS_STATUS_SIGNALS [] =
+{
+	{ .startBit = 7,	.length = 1,	.type = CAN_SIGNAL_BOOL,	.destination = offsetof (bms_t, bmsFault) },
+	{ .startBit = 8,	.length = 1,	.type = CAN_SIGNAL_BOOL,	.destination = offsetof (bms_t, imdFault) },
+	{ .startBit = 9,	.length = 1,	.type = CAN_SIGNAL_BOOL,	.destination = offsetof (bms_t, charging) },
+	{ .startBit = 10,	.length = 1,	.type = CAN_SIGNAL_BOOL,	.destination = offsetof (bms_t, balancing) },
+	{ .startBit = 16,	.length = 1,	.type = CAN_SIGNAL_BOOL,	.destination = offsetof (bms_t, negativeIrClosed) },
+	{ .startBit = 17,	.length = 1,	.type = CAN_SIGNAL_BOOL,	.destination = offsetof (bms_t, positiveIrClosed) }
+};
+
+static const canSignal_t BMS_POWER_SIGNALS [] =
+{
+	{ .startBit = 0,	.length = 16,					.factor = 0.0125f,				.type = CAN_SIGNAL_FLOAT,
+		.destination = offsetof (bms_t, packVoltage) },
+	{ .startBit = 16,	.length = 16,	.isSigned = true,	.factor = 0.019073486328125f,	.type = CAN_SIGNAL_FLOAT,
+		.destination = offsetof (bms_t, packCurrent) },
+	{ .startBit = 32,	.length = 16,	.isSigned = true,	.factor = 4.0f,					.type = CAN_SIGNAL_FLOAT,
+		.destination = offsetof (bms_t, powerDelivery) }
+};
+
+static const canSignalMessage_t BMS_MESSAGES [] =
+{
+	[BMS_STATUS_MESSAGE_FLAG_POS]	= { .id = canIdStandard (BMS_STATUS_MESSAGE_ID),	.signals = BMS_STATUS_SIGNALS,	.signalCount = 6 },
+	[BMS_POWER_MESSAGE_FLAG_POS]	= { .id = canIdStandard (BMS_POWER_MESSAGE_ID),		.signals = BMS_POWER_SIGNALS,	.signalCount = 3 }
+};
+
+/**
+ * @brief Receive handler decoding a @c bms_t using the BMS signal table.
+ */
+static inline int8_t bmsTableHandler (void* node, CANRxFrame* frame)
+{
+	return canSignalDecode (BMS_MESSAGES, 2, node, canIdFromFrame (frame), frame->data8);
+}
+
+// Bosch F02U V01 -------------------------------------------------------------------------------------------------------------
+
+#define BOSCH_MESSAGE_1_ID				0x174
+#define BOSCH_MESSAGE_2_ID				0x178
+#define BOSCH_MESSAGE_3_ID				0x17C
+
+/// @brief Angle rate signal, first word of a message.
+#define BOSCH_ANGLE_RATE_SIGNAL(field)																						\
+	{ .startBit = 0, .length = 16, .factor = 0.005f, .offset = -163.84f, .type = CAN_SIGNAL_FLOAT,							\
+		.destination = offsetof (boschF02uV01_t, field) }
+
+/// @brief Acceleration signal, third word of a message.
+#define BOSCH_ACCELERATION_SIGNAL(field)																					\
+	{ .startBit = 32, .length = 16, .factor = 0.0001274f, .offset = -4.1746432f, .type = CAN_SIGNAL_FLOAT,					\
+		.destination = offsetof (boschF02uV01_t, field) }
+
+static const canSignal_t BOSCH_MESSAGE_1_SIGNALS [] =
+{
+	BOSCH_ANGLE_RATE_SIGNAL (zAngleRate),
+	BOSCH_ACCELERATION_SIGNAL (yAcceleration)
+};
+
+static const canSignal_t BOSCH_MESSAGE_2_SIGNALS [] =
+{
+	BOSCH_ANGLE_RATE_SIGNAL (xAngleRate),
+	BOSCH_ACCELERATION_SIGNAL (xAcceleration)
+};
+
+static const canSignal_t BOSCH_MESSAGE_3_SIGNALS [] =
+{
+	BOSCH_ACCELERATION_SIGNAL (zAcceleration)
+};
+
+static const canSignalMessage_t BOSCH_MESSAGES [] =
+{
+	{ .id = canIdStandard (BOSCH_MESSAGE_1_ID),	.signals = BOSCH_MESSAGE_1_SIGNALS,	.signalCount = 2 },
+	{ .id = canIdStandard (BOSCH_MESSAGE_2_ID),	.signals = BOSCH_MESSAGE_2_SIGNALS,	.signalCount = 2 },
+	{ .id = canIdStandard (BOSCH_MESSAGE_3_ID),	.signals = BOSCH_MESSAGE_3_SIGNALS,	.signalCount = 1 }
+};
+
+/**
+ * @brief Receive handler decoding a @c boschF02uV01_t using the Bosch IMU signal table.
+ */
+static inline int8_t boschTableHandler (void* node, CANRxFrame* frame)
+{
+	return canSignalDecode (BOSCH_MESSAGES, 3, node, canIdFromFrame (frame), frame->data8);
+}
+
+// ECUMaster GPS V2 -----------------------------------------------------------------------------------------------------------
+
+#define ECUMASTER_POSITION_MESSAGE_ID		0x400
+#define ECUMASTER_VELOCITY_MESSAGE_ID		0x401
+#define ECUMASTER_HEADING_IMU0_MESSAGE_ID	0x402
+#define ECUMASTER_IMU1_MESSAGE_ID			0x403
+
+/**
+ * @brief The signals of the ECUMaster GPS. The GPS status is decoded as a @c uint8_t rather than into the node's enum, so the
+ * signals are decoded into this struct rather than the node itself.
+ */
+typedef struct
+{
+	float latitude;
+	float longitude;
+	float speed;
+	float height;
+	uint8_t satellitesNumber;
+	uint8_t gpsFrameIndex;
+	uint8_t emptyFrameIndex;
+	uint8_t gpsStatus;
+	float headingMotion;
+	float headingVehicle;
+	float xAngleRate;
+	float yAngleRate;
+	float zAngleRate;
+	float xAcceleration;
+	float yAcceleration;
+	float zAcceleration;
+} ecumasterSignals_t;
+
+/// @brief Big-endian signal, @c startBit being the position of the MSB.
+#define ECUMASTER_SIGNAL(start, bits, sign, scale, datatype, field)														\
+	{ .startBit = start, .length = bits, .byteOrder = CAN_SIGNAL_BIG_ENDIAN, .isSigned = sign, .factor = scale,				\
+		.type = datatype, .destination = offsetof (ecumasterSignals_t, field) }
+
+static const canSignal_t ECUMASTER_POSITION_SIGNALS [] =
+{
+	ECUMASTER_SIGNAL (7,	32,	true,	1E-7f,	CAN_SIGNAL_FLOAT,	latitude),
+	ECUMASTER_SIGNAL (39,	32,	true,	1E-7f,	CAN_SIGNAL_FLOAT,	longitude)
+};
+
+static const canSignal_t ECUMASTER_VELOCITY_SIGNALS [] =
+{
+	ECUMASTER_SIGNAL (7,	16,	true,	0.036f,	CAN_SIGNAL_FLOAT,	speed),
+	ECUMASTER_SIGNAL (23,	16,	true,	1.0f,	CAN_SIGNAL_FLOAT,	height),
+	ECUMASTER_SIGNAL (47,	8,	false,	0.0f,	CAN_SIGNAL_UINT8,	satellitesNumber),
+	ECUMASTER_SIGNAL (51,	4,	false,	0.0f,	CAN_SIGNAL_UINT8,	gpsFrameIndex),
+	ECUMASTER_SIGNAL (55,	4,	false,	0.0f,	CAN_SIGNAL_UINT8,	emptyFrameIndex),
+	ECUMASTER_SIGNAL (58,	3,	false,	0.0f,	CAN_SIGNAL_UINT8,	gpsStatus)
+};
+
+static const canSignal_t ECUMASTER_HEADING_IMU0_SIGNALS [] =
+{
+	ECUMASTER_SIGNAL (7,	16,	false,	1.0f,	CAN_SIGNAL_FLOAT,	headingMotion),
+	ECUMASTER_SIGNAL (23,	16,	false,	1.0f,	CAN_SIGNAL_FLOAT,	headingVehicle),
+	ECUMASTER_SIGNAL (39,	16,	true,	0.01f,	CAN_SIGNAL_FLOAT,	xAngleRate),
+	ECUMASTER_SIGNAL (55,	16,	true,	0.01f,	CAN_SIGNAL_FLOAT,	yAngleRate)
+};
+
+static const canSignal_t ECUMASTER_IMU1_SIGNALS [] =
+{
+	ECUMASTER_SIGNAL (7,	16,	true,	0.01f,	CAN_SIGNAL_FLOAT,	zAngleRate),
+	ECUMASTER_SIGNAL (23,	16,	true,	0.01f,	CAN_SIGNAL_FLOAT,	xAcceleration),
+	ECUMASTER_SIGNAL (39,	16,	true,	0.01f,	CAN_SIGNAL_FLOAT,	yAcceleration),
+	ECUMASTER_SIGNAL (55,	16,	true,	0.01f,	CAN_SIGNAL_FLOAT,	zAcceleration)
+};
+
+static const canSignalMessage_t ECUMASTER_MESSAGES [] =
+{
+	{ .id = canIdStandard (ECUMASTER_POSITION_MESSAGE_ID),		.signals = ECUMASTER_POSITION_SIGNALS,		.signalCount = 2 },
+	{ .id = canIdStandard (ECUMASTER_VELOCITY_MESSAGE_ID),		.signals = ECUMASTER_VELOCITY_SIGNALS,		.signalCount = 6 },
+	{ .id = canIdStandard (ECUMASTER_HEADING_IMU0_MESSAGE_ID),	.signals = ECUMASTER_HEADING_IMU0_SIGNALS,	.signalCount = 4 },
+	{ .id = canIdStandard (ECUMASTER_IMU1_MESSAGE_ID),			.signals = ECUMASTER_IMU1_SIGNALS,			.signalCount = 4 }
+};
+
+#define ECUMASTER_MESSAGE_COUNT (sizeof (ECUMASTER_MESSAGES) / sizeof (ECUMASTER_MESSAGES [0]))
+
+#endif // SIGNAL_TABLES_H
\ No newline at end of file
@@ -0,0 +1,128 @@
+#ifndef CH_H
+#define CH_H
+
+// ChibiOS/RT Stub ------------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Minimal stand-in for the ChibiOS/RT kernel, allowing modules to be compiled and tested on a host machine. Only
+//   the declarations used by the library are provided. Tests are single-threaded, so locks and semaphores are no-ops. See
+//   stub.c for the implementations.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// C Standard Library
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+#define TRUE						1
+#define FALSE						0
+
+#define CH_CFG_ST_FREQUENCY			10000
+#define CH_CFG_USE_EVENTS			TRUE
+
+#define MSG_OK						0
+#define MSG_TIMEOUT					-1
+#define MSG_RESET					-2
+
+#define TIME_IMMEDIATE				((sysinterval_t) 0)
+#define TIME_INFINITE				((sysinterval_t) -1)
+#define TIME_MAX_INTERVAL			((sysinterval_t) -2)
+
+#define LOWPRIO						1
+#define NORMALPRIO					128
+#define HIGHPRIO					255
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+typedef uint32_t systime_t;
+typedef uint32_t sysinterval_t;
+typedef int32_t msg_t;
+typedef uint32_t tprio_t;
+typedef uint32_t eventmask_t;
+typedef uint32_t eventflags_t;
+typedef uint32_t cnt_t;
+
+typedef struct { int unused; } mutex_t;
+typedef struct { int unused; } binary_semaphore_t;
+typedef struct { int unused; } semaphore_t;
+typedef struct { int unused; } event_source_t;
+typedef struct { int unused; } event_listener_t;
+typedef struct { int unused; } thread_t;
+typedef struct { int unused; } virtual_timer_t;
+
+typedef void (*vtfunc_t) (virtual_timer_t*, void*);
+typedef void (tfunc_t) (void*);
+
+// Macros ---------------------------------------------------------------------------------------------------------------------
+
+#define TIME_MS2I(ms)				((sysinterval_t) (ms) * (CH_CFG_ST_FREQUENCY / 1000))
+#define TIME_US2I(us)				((sysinterval_t) (us) / (1000000 / CH_CFG_ST_FREQUENCY))
+#define TIME_I2MS(i)				((i) / (CH_CFG_ST_FREQUENCY / 1000))
+#define TIME_I2US(i)				((i) * (1000000 / CH_CFG_ST_FREQUENCY))
+
+#define THD_WORKING_AREA(s, n)		uint64_t s [(n) / 8 + 64]
+#define THD_WORKING_AREA_SIZE(n)	((n) + 512)
+#define THD_FUNCTION(tname, arg)	void tname (void* arg)
+
+#define osalDbgCheck(c)				chDbgCheck (c)
+#define osalDbgAssert(c, remark)	chDbgCheck (c)
+
+// Global Memory --------------------------------------------------------------------------------------------------------------
+
+/// @brief The current system time, returned by @c chVTGetSystemTime . Tests may modify this freely.
+extern systime_t stubSystemTime;
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+systime_t chVTGetSystemTime (void);
+systime_t chVTGetSystemTimeX (void);
+systime_t chTimeAddX (systime_t time, sysinterval_t interval);
+sysinterval_t chTimeDiffX (systime_t start, systime_t end);
+bool chTimeIsInRangeX (systime_t time, systime_t start, systime_t end);
+
+void chMtxObjectInit (mutex_t* mutex);
+void chMtxLock (mutex_t* mutex);
+void chMtxUnlock (mutex_t* mutex);
+bool chMtxTryLock (mutex_t* mutex);
+
+void chRegSetThreadName (const char* name);
+thread_t* chThdCreateStatic (void* workingArea, size_t size, tprio_t priority, tfunc_t* function, void* arg);
+void chThdSleep (sysinterval_t interval);
+void chThdSleepMilliseconds (uint32_t milliseconds);
+void chThdSleepUntil (systime_t time);
+systime_t chThdSleepUntilWindowed (systime_t previous, systime_t next);
+void chThdYield (void);
+tprio_t chThdGetPriorityX (void);
+
+void chSysLock (void);
+void chSysUnlock (void);
+void chSysLockFromISR (void);
+void chSysUnlockFromISR (void);
+void chSchRescheduleS (void);
+
+void chBSemObjectInit (binary_semaphore_t* semaphore, bool taken);
+msg_t chBSemWait (binary_semaphore_t* semaphore);
+msg_t chBSemWaitTimeout (binary_semaphore_t* semaphore, sysinterval_t timeout);
+msg_t chBSemWaitTimeoutS (binary_semaphore_t* semaphore, sysinterval_t timeout);
+void chBSemSignal (binary_semaphore_t* semaphore);
+void chBSemSignalI (binary_semaphore_t* semaphore);
+void chBSemReset (binary_semaphore_t* semaphore, bool taken);
+void chSemObjectInit (semaphore_t* semaphore, cnt_t count);
+
+void chEvtObjectInit (event_source_t* source);
+void chEvtBroadcastFlags (event_source_t* source, eventflags_t flags);
+void chEvtBroadcastFlagsI (event_source_t* source, eventflags_t flags);
+void chEvtRegisterMaskWithFlags (event_source_t* source, event_listener_t* listener, eventmask_t events,
+	eventflags_t flags);
+void chEvtUnregister (event_source_t* source, event_listener_t* listener);
+eventflags_t chEvtGetAndClearFlags (event_listener_t* listener);
+eventmask_t chEvtWaitAnyTimeout (eventmask_t events, sysinterval_t timeout);
+
+void chDbgCheck (bool condition);
+
+#endif // CH_H
\ No newline at end of file
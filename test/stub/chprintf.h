@@ -0,0 +1,19 @@
+#ifndef CHPRINTF_H
+#define CHPRINTF_H
+
+// ChibiOS chprintf Stub ------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Minimal stand-in for the ChibiOS formatted printing module, see ch.h for details.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+#include "hal.h"
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+int chprintf (BaseSequentialStream* stream, const char* format, ...);
+
+#endif // CHPRINTF_H
\ No newline at end of file
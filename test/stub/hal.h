@@ -0,0 +1,189 @@
+#ifndef HAL_H
+#define HAL_H
+
+// ChibiOS/HAL Stub -----------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Minimal stand-in for the ChibiOS HAL and the STM32F405 CMSIS definitions, see ch.h for details. Transmitted
+//   CAN frames are recorded, such that tests can inspect them.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+#include "ch.h"
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+#define BOARD_NAME					"stub"
+#define STM32_SYSCLK				168000000
+
+#define STM32_CAN_USE_CAN1			TRUE
+#define STM32_CAN_USE_CAN2			TRUE
+#define STM32_CAN_MAX_FILTERS		28
+
+#define CAN_ANY_MAILBOX				0U
+#define CAN_IDE_STD					0
+#define CAN_IDE_EXT					1
+#define CAN_RTR_DATA				0
+#define CAN_RTR_REMOTE				1
+
+#define CAN_MCR_INRQ				(1U << 0)
+#define CAN_MCR_ABOM				(1U << 6)
+#define CAN_MSR_INAK				(1U << 0)
+#define CAN_ESR_EWGF				(1U << 0)
+#define CAN_ESR_EPVF				(1U << 1)
+#define CAN_ESR_BOFF				(1U << 2)
+#define CAN_ESR_LEC_Pos				4
+#define CAN_ESR_LEC_Msk				(0x7U << CAN_ESR_LEC_Pos)
+#define CAN_ESR_TEC_Pos				16
+#define CAN_ESR_TEC_Msk				(0xFFU << CAN_ESR_TEC_Pos)
+#define CAN_ESR_REC_Pos				24
+#define CAN_ESR_REC_Msk				(0xFFU << CAN_ESR_REC_Pos)
+
+#define DWT_CTRL_CYCCNTENA_Msk		(1U << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk	(1U << 24)
+
+/// @brief The number of transmitted frames recorded by the stub.
+#define STUB_TRANSMIT_COUNT_MAX		64
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+	volatile uint32_t MCR, MSR, TSR, RF0R, RF1R, IER, ESR, BTR;
+} CAN_TypeDef;
+
+typedef struct
+{
+	uint32_t mcr;
+	uint32_t btr;
+} CANConfig;
+
+typedef enum
+{
+	CAN_UNINIT = 0,
+	CAN_STOP = 1,
+	CAN_STARTING = 2,
+	CAN_READY = 3,
+	CAN_SLEEP = 4
+} canstate_t;
+
+typedef struct
+{
+	canstate_t state;
+	const CANConfig* config;
+	CAN_TypeDef* can;
+	event_source_t error_event;
+} CANDriver;
+
+typedef uint32_t canmbx_t;
+
+typedef struct
+{
+	uint8_t DLC : 4;
+	uint8_t RTR : 1;
+	uint8_t IDE : 1;
+	union
+	{
+		uint32_t SID : 11;
+		uint32_t EID : 29;
+	};
+	union
+	{
+		uint8_t data8 [8];
+		uint16_t data16 [4];
+		uint32_t data32 [2];
+		uint64_t data64 [1];
+	};
+} CANTxFrame;
+
+typedef struct
+{
+	uint8_t FMI;
+	uint16_t TIME;
+	uint8_t DLC : 4;
+	uint8_t RTR : 1;
+	uint8_t IDE : 1;
+	union
+	{
+		uint32_t SID : 11;
+		uint32_t EID : 29;
+	};
+	union
+	{
+		uint8_t data8 [8];
+		uint16_t data16 [4];
+		uint32_t data32 [2];
+		uint64_t data64 [1];
+	};
+} CANRxFrame;
+
+typedef struct
+{
+	uint32_t filter;
+	uint32_t mode : 1;
+	uint32_t scale : 1;
+	uint32_t assignment : 1;
+	uint32_t register1;
+	uint32_t register2;
+} CANFilter;
+
+typedef struct
+{
+	volatile uint32_t CTRL, CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+	volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+typedef uint32_t ioline_t;
+typedef struct { int unused; } SerialDriver;
+typedef struct { int unused; } SerialConfig;
+typedef struct { int unused; } BaseSequentialStream;
+
+// Global Memory --------------------------------------------------------------------------------------------------------------
+
+extern CANDriver CAND1;
+extern CANDriver CAND2;
+
+extern DWT_Type* DWT;
+extern CoreDebug_Type* CoreDebug;
+
+/// @brief The frames transmitted since the last call to @c stubTransmitReset .
+extern CANTxFrame stubTransmitFrames [STUB_TRANSMIT_COUNT_MAX];
+
+/// @brief The number of elements in @c stubTransmitFrames .
+extern uint16_t stubTransmitCount;
+
+/// @brief The number of calls to @c canTransmitTimeout since the last call to @c stubTransmitReset .
+extern uint16_t stubTransmitBlockingCount;
+
+/// @brief Indicates the transmit mailboxes are full, causing transmissions to fail.
+extern bool stubTransmitFull;
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Clears the record of transmitted frames.
+ */
+void stubTransmitReset (void);
+
+msg_t canReceiveTimeout (CANDriver* driver, canmbx_t mailbox, CANRxFrame* frame, sysinterval_t timeout);
+msg_t canTransmitTimeout (CANDriver* driver, canmbx_t mailbox, const CANTxFrame* frame, sysinterval_t timeout);
+bool canTryTransmitI (CANDriver* driver, canmbx_t mailbox, const CANTxFrame* frame);
+bool canTryReceiveI (CANDriver* driver, canmbx_t mailbox, CANRxFrame* frame);
+void canStart (CANDriver* driver, const CANConfig* config);
+void canStop (CANDriver* driver);
+void canSTM32SetFilters (CANDriver* driver, uint32_t can2sb, uint32_t num, const CANFilter* filters);
+
+uint32_t __REV (uint32_t value);
+uint32_t __REV16 (uint32_t value);
+void __DMB (void);
+void __DSB (void);
+
+size_t streamWrite (BaseSequentialStream* stream, const uint8_t* data, size_t size);
+
+#endif // HAL_H
\ No newline at end of file
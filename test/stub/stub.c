@@ -0,0 +1,161 @@
+// ChibiOS Stub ---------------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Implementations of the ChibiOS stand-ins, see ch.h for details.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+#include "ch.h"
+#include "hal.h"
+#include "chprintf.h"
+
+// Global Memory --------------------------------------------------------------------------------------------------------------
+
+systime_t stubSystemTime = 0;
+
+CANDriver CAND1;
+CANDriver CAND2;
+
+static DWT_Type dwt;
+DWT_Type* DWT = &dwt;
+
+static CoreDebug_Type coreDebug;
+CoreDebug_Type* CoreDebug = &coreDebug;
+
+CANTxFrame stubTransmitFrames [STUB_TRANSMIT_COUNT_MAX];
+uint16_t stubTransmitCount = 0;
+uint16_t stubTransmitBlockingCount = 0;
+bool stubTransmitFull = false;
+
+// Kernel ---------------------------------------------------------------------------------------------------------------------
+
+systime_t chVTGetSystemTime (void) { return stubSystemTime; }
+systime_t chVTGetSystemTimeX (void) { return stubSystemTime; }
+systime_t chTimeAddX (systime_t time, sysinterval_t interval) { return time + interval; }
+sysinterval_t chTimeDiffX (systime_t start, systime_t end) { return end - start; }
+bool chTimeIsInRangeX (systime_t time, systime_t start, systime_t end) { return time - start < end - start; }
+
+void chMtxObjectInit (mutex_t* mutex) { (void) mutex; }
+void chMtxLock (mutex_t* mutex) { (void) mutex; }
+void chMtxUnlock (mutex_t* mutex) { (void) mutex; }
+bool chMtxTryLock (mutex_t* mutex) { (void) mutex; return true; }
+
+void chRegSetThreadName (const char* name) { (void) name; }
+
+thread_t* chThdCreateStatic (void* workingArea, size_t size, tprio_t priority, tfunc_t* function, void* arg)
+{
+	// Threads are not run, tests call the thread's functions directly.
+	(void) workingArea; (void) size; (void) priority; (void) function; (void) arg;
+	static thread_t thread;
+	return &thread;
+}
+
+void chThdSleep (sysinterval_t interval) { stubSystemTime += interval; }
+void chThdSleepMilliseconds (uint32_t milliseconds) { stubSystemTime += TIME_MS2I (milliseconds); }
+void chThdSleepUntil (systime_t time) { stubSystemTime = time; }
+systime_t chThdSleepUntilWindowed (systime_t previous, systime_t next) { (void) previous; stubSystemTime = next; return next; }
+void chThdYield (void) { }
+tprio_t chThdGetPriorityX (void) { return NORMALPRIO; }
+
+void chSysLock (void) { }
+void chSysUnlock (void) { }
+void chSysLockFromISR (void) { }
+void chSysUnlockFromISR (void) { }
+void chSchRescheduleS (void) { }
+
+void chBSemObjectInit (binary_semaphore_t* semaphore, bool taken) { (void) semaphore; (void) taken; }
+msg_t chBSemWait (binary_semaphore_t* semaphore) { (void) semaphore; return MSG_OK; }
+msg_t chBSemWaitTimeout (binary_semaphore_t* semaphore, sysinterval_t timeout) { (void) semaphore; (void) timeout; return MSG_OK; }
+msg_t chBSemWaitTimeoutS (binary_semaphore_t* semaphore, sysinterval_t timeout) { (void) semaphore; (void) timeout; return MSG_OK; }
+void chBSemSignal (binary_semaphore_t* semaphore) { (void) semaphore; }
+void chBSemSignalI (binary_semaphore_t* semaphore) { (void) semaphore; }
+void chBSemReset (binary_semaphore_t* semaphore, bool taken) { (void) semaphore; (void) taken; }
+void chSemObjectInit (semaphore_t* semaphore, cnt_t count) { (void) semaphore; (void) count; }
+
+void chEvtObjectInit (event_source_t* source) { (void) source; }
+void chEvtBroadcastFlags (event_source_t* source, eventflags_t flags) { (void) source; (void) flags; }
+void chEvtBroadcastFlagsI (event_source_t* source, eventflags_t flags) { (void) source; (void) flags; }
+
+void chEvtRegisterMaskWithFlags (event_source_t* source, event_listener_t* listener, eventmask_t events,
+	eventflags_t flags)
+{
+	(void) source; (void) listener; (void) events; (void) flags;
+}
+
+void chEvtUnregister (event_source_t* source, event_listener_t* listener) { (void) source; (void) listener; }
+eventflags_t chEvtGetAndClearFlags (event_listener_t* listener) { (void) listener; return 0; }
+eventmask_t chEvtWaitAnyTimeout (eventmask_t events, sysinterval_t timeout) { (void) events; (void) timeout; return 0; }
+
+void chDbgCheck (bool condition) { (void) condition; }
+
+// HAL ------------------------------------------------------------------------------------------------------------------------
+
+void stubTransmitReset (void)
+{
+	stubTransmitCount = 0;
+	stubTransmitBlockingCount = 0;
+	stubTransmitFull = false;
+}
+
+bool canTryTransmitI (CANDriver* driver, canmbx_t mailbox, const CANTxFrame* frame)
+{
+	(void) driver; (void) mailbox;
+
+	// Note this returns true upon failure, as ChibiOS does.
+	if (stubTransmitFull || stubTransmitCount >= STUB_TRANSMIT_COUNT_MAX)
+		return true;
+
+	stubTransmitFrames [stubTransmitCount] = *frame;
+	++stubTransmitCount;
+	return false;
+}
+
+msg_t canTransmitTimeout (CANDriver* driver, canmbx_t mailbox, const CANTxFrame* frame, sysinterval_t timeout)
+{
+	(void) timeout;
+	++stubTransmitBlockingCount;
+	return canTryTransmitI (driver, mailbox, frame) ? MSG_TIMEOUT : MSG_OK;
+}
+
+msg_t canReceiveTimeout (CANDriver* driver, canmbx_t mailbox, CANRxFrame* frame, sysinterval_t timeout)
+{
+	(void) driver; (void) mailbox; (void) frame; (void) timeout;
+	return MSG_TIMEOUT;
+}
+
+bool canTryReceiveI (CANDriver* driver, canmbx_t mailbox, CANRxFrame* frame)
+{
+	(void) driver; (void) mailbox; (void) frame;
+	return true;
+}
+
+void canStart (CANDriver* driver, const CANConfig* config) { driver->config = config; driver->state = CAN_READY; }
+void canStop (CANDriver* driver) { driver->state = CAN_STOP; }
+
+void canSTM32SetFilters (CANDriver* driver, uint32_t can2sb, uint32_t num, const CANFilter* filters)
+{
+	(void) driver; (void) can2sb; (void) num; (void) filters;
+}
+
+// CMSIS ----------------------------------------------------------------------------------------------------------------------
+
+uint32_t __REV (uint32_t value) { return __builtin_bswap32 (value); }
+uint32_t __REV16 (uint32_t value) { return ((value & 0x00FF00FF) << 8) | ((value & 0xFF00FF00) >> 8); }
+void __DMB (void) { __sync_synchronize (); }
+void __DSB (void) { __sync_synchronize (); }
+
+// Streams --------------------------------------------------------------------------------------------------------------------
+
+size_t streamWrite (BaseSequentialStream* stream, const uint8_t* data, size_t size)
+{
+	(void) stream; (void) data;
+	return size;
+}
+
+int chprintf (BaseSequentialStream* stream, const char* format, ...)
+{
+	(void) stream; (void) format;
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef TEST_H
+#define TEST_H
+
+// Host Test Framework --------------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Minimal assertion macros for the host-side tests. Each test is a standalone program, which prints each failed
+//   check and returns a non-zero exit code if any check failed (see @c testResult ).
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// C Standard Library
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Global Memory --------------------------------------------------------------------------------------------------------------
+
+/// @brief The number of failed checks.
+static uint32_t testFailureCount = 0;
+
+/// @brief The number of performed checks.
+static uint32_t testCheckCount = 0;
+
+// Macros ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Checks a condition, printing the failure (with a formatted message) if false.
+ * @param condition The condition to check.
+ * @param ... The printf-style format and arguments of the message to print upon failure.
+ */
+#define TEST_CHECK(condition, ...)																							\
+	do																														\
+	{																														\
+		++testCheckCount;																									\
+		if (!(condition))																									\
+		{																													\
+			++testFailureCount;																								\
+			printf ("%s:%d: Check failed: %s: ", __FILE__, __LINE__, #condition);											\
+			printf (__VA_ARGS__);																							\
+			printf ("\n");																									\
+		}																													\
+	} while (0)
+
+/**
+ * @brief Prints the summary of a test program.
+ * @param name The name of the test program.
+ * @return The exit code of the test program, 0 if every check passed, 1 otherwise.
+ */
+static inline int testResult (const char* name)
+{
+	printf ("%s: %u / %u checks passed.\n", name, testCheckCount - testFailureCount, testCheckCount);
+	return testFailureCount == 0 ? 0 : 1;
+}
+
+#endif // TEST_H
\ No newline at end of file
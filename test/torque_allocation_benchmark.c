@@ -0,0 +1,172 @@
+// Torque Allocation Benchmark ------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Measures the cost of the torque allocation, in time and in iterations. A sequence of outputs, as requested by
+//   the control loop over a number of cycles (including saturated outputs and motors de-rating), is allocated both
+//   warm-started from the previous cycle's allocation, and cold-started from zero. Fails if an allocation does not converge.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// Includes
+#include "benchmark.h"
+#include "torque_allocation.h"
+#include "vehicle_dynamics.h"
+
+// C Standard Library
+#include <math.h>
+#include <stdio.h>
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+#define N TORQUE_ALLOCATION_MOTOR_COUNT
+
+/// @brief The number of control cycles in the sequence.
+#define CYCLE_COUNT 4096
+
+// Vehicle geometry (typical values).
+#define WHEEL_BASE			1.55f
+#define WEIGHT_BIAS			0.5f
+#define TRACK_WIDTH_FRONT	1.22f
+#define TRACK_WIDTH_REAR	1.2f
+#define GEAR_RATIO			11.83f
+#define WHEEL_RADIUS		8.0f
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+	float torqueTotal;
+	float yawMoment;
+	float torquesMin [N];
+	float torquesMax [N];
+} cycle_t;
+
+typedef struct
+{
+	/// @brief The median number of ticks of the whole sequence.
+	uint64_t ticks;
+
+	/// @brief The total number of iterations of the sequence.
+	uint32_t iterations;
+
+	/// @brief The largest number of iterations of a single allocation.
+	uint8_t iterationsMax;
+
+	/// @brief The number of allocations that did not converge.
+	uint32_t unconverged;
+} result_t;
+
+// Global Memory --------------------------------------------------------------------------------------------------------------
+
+static torqueAllocationConfig_t config =
+{
+	.distribution		= { 0.25f, 0.25f, 0.25f, 0.25f },
+	.torqueWeight		= 1.0f,
+	.motorWeights		= { 0.01f, 0.01f, 0.01f, 0.01f }
+};
+
+static cycle_t cycles [CYCLE_COUNT];
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Allocates each cycle of the sequence.
+ * @param warmStart Indicates whether to start each allocation from the previous, rather than from zero.
+ * @param result The result to accumulate the iterations into.
+ * @return The number of ticks elapsed.
+ */
+static uint64_t measure (bool warmStart, result_t* result)
+{
+	float torques [N] = { 0.0f };
+	uint8_t iterations [CYCLE_COUNT];
+	bool converged [CYCLE_COUNT];
+
+	uint64_t start = benchmarkTicks ();
+	for (uint16_t index = 0; index < CYCLE_COUNT; ++index)
+	{
+		if (!warmStart)
+			for (uint8_t i = 0; i < N; ++i)
+				torques [i] = 0.0f;
+
+		const cycle_t* cycle = &cycles [index];
+		converged [index] = torqueAllocate (&config, cycle->torqueTotal, cycle->yawMoment, cycle->torquesMin, cycle->torquesMax,
+			torques, &iterations [index]);
+	}
+	uint64_t ticks = benchmarkTicks () - start;
+
+	*result = (result_t) { 0 };
+	for (uint16_t index = 0; index < CYCLE_COUNT; ++index)
+	{
+		result->iterations += iterations [index];
+		if (iterations [index] > result->iterationsMax)
+			result->iterationsMax = iterations [index];
+		if (!converged [index])
+			++result->unconverged;
+	}
+
+	return ticks;
+}
+
+static void printResult (const char* name, const result_t* result)
+{
+	printf ("  %s  %8.1f %s, %5.2f iterations (max %u), %6.1f %s per iteration\n", name,
+		(float) result->ticks / CYCLE_COUNT, BENCHMARK_TICK_UNIT, (float) result->iterations / CYCLE_COUNT,
+		result->iterationsMax, (float) result->ticks / result->iterations, BENCHMARK_TICK_UNIT);
+}
+
+int main (void)
+{
+	config.yawMomentTransfers [TORQUE_ALLOCATION_FL] = motorFlYawMomentTransfer (WHEEL_BASE, WEIGHT_BIAS, TRACK_WIDTH_FRONT,
+		GEAR_RATIO, WHEEL_RADIUS, 0.0f);
+	config.yawMomentTransfers [TORQUE_ALLOCATION_FR] = motorFrYawMomentTransfer (WHEEL_BASE, WEIGHT_BIAS, TRACK_WIDTH_FRONT,
+		GEAR_RATIO, WHEEL_RADIUS, 0.0f);
+	config.yawMomentTransfers [TORQUE_ALLOCATION_RL] = motorRlYawMomentTransfer (TRACK_WIDTH_REAR, GEAR_RATIO, WHEEL_RADIUS);
+	config.yawMomentTransfers [TORQUE_ALLOCATION_RR] = motorRrYawMomentTransfer (TRACK_WIDTH_REAR, GEAR_RATIO, WHEEL_RADIUS);
+	config.yawMomentWeight = 1.0f / config.yawMomentTransfers [TORQUE_ALLOCATION_RL];
+
+	// The sequence sweeps the total torque between full regen and beyond full drive, while the yaw moment sweeps through
+	// corners in either direction. The rear motors periodically de-rate.
+	for (uint16_t index = 0; index < CYCLE_COUNT; ++index)
+	{
+		float time = (float) index / CYCLE_COUNT;
+		cycle_t* cycle = &cycles [index];
+		cycle->torqueTotal = 110.0f * sinf (2.0f * M_PI * 3.0f * time);
+		cycle->yawMoment = 2500.0f * sinf (2.0f * M_PI * 7.0f * time);
+
+		float derating = 0.5f + 0.5f * fabsf (cosf (2.0f * M_PI * 2.0f * time));
+		for (uint8_t i = 0; i < N; ++i)
+		{
+			bool rear = i == TORQUE_ALLOCATION_RL || i == TORQUE_ALLOCATION_RR;
+			cycle->torquesMin [i] = -21.0f * (rear ? derating : 1.0f);
+			cycle->torquesMax [i] = 21.0f * (rear ? derating : 1.0f);
+		}
+	}
+
+	// Repetitions of each case are interleaved, such that changes in the host's clock affect each equally.
+	result_t warm;
+	result_t cold;
+	uint64_t warmSamples [BENCHMARK_REPETITIONS];
+	uint64_t coldSamples [BENCHMARK_REPETITIONS];
+	for (uint16_t repetition = 0; repetition < BENCHMARK_REPETITIONS; ++repetition)
+	{
+		warmSamples [repetition] = measure (true, &warm);
+		coldSamples [repetition] = measure (false, &cold);
+	}
+	warm.ticks = benchmarkMedian (warmSamples, BENCHMARK_REPETITIONS);
+	cold.ticks = benchmarkMedian (coldSamples, BENCHMARK_REPETITIONS);
+
+	printf ("torque_allocation_benchmark: Allocation of %u control cycles (per allocation):\n", CYCLE_COUNT);
+	printResult ("Warm start:", &warm);
+	printResult ("Cold start:", &cold);
+
+	if (warm.unconverged != 0 || cold.unconverged != 0)
+	{
+		printf ("torque_allocation_benchmark: %u warm-started and %u cold-started allocations did not converge.\n",
+			warm.unconverged, cold.unconverged);
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,311 @@
+// Torque Allocation Tests ----------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Tests of the accuracy of the torque allocation. Checks achievable outputs are met exactly, and that outputs
+//   exceeding the motors' limits saturate as the weights dictate (total torque, yaw moment, and every motor saturated).
+//
+//   Every allocation is additionally checked against the optimality (KKT) conditions of the problem, computed independently of
+//   the solver: a free motor has no gradient, a motor at its lower limit has a non-negative gradient, and a motor at its upper
+//   limit has a non-positive gradient. This is followed by random allocations, warm-started from either the previous
+//   allocation or a random point.
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// Includes
+#include "test.h"
+#include "torque_allocation.h"
+#include "vehicle_dynamics.h"
+
+// C Standard Library
+#include <math.h>
+#include <stdlib.h>
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+#define N TORQUE_ALLOCATION_MOTOR_COUNT
+
+/// @brief The number of random allocations to test.
+#define RANDOM_ALLOCATION_COUNT 100000
+
+/// @brief The seed of the random allocations, fixed so failures are reproducible.
+#define RANDOM_SEED 0x5EED
+
+/// @brief The tolerance of an output error, relative to the magnitude of the output, for achievable outputs.
+#define OUTPUT_TOLERANCE 1e-3f
+
+/// @brief The tolerance of the prioritized output's error, relative to the magnitude of the output, for saturated outputs.
+#define PRIORITY_TOLERANCE 0.05f
+
+/// @brief The tolerance of a motor's torque, in Nm.
+#define TORQUE_TOLERANCE 1e-3f
+
+/// @brief The tolerance of the optimality conditions, relative to the magnitude of the cost's terms.
+#define GRADIENT_TOLERANCE 1e-4f
+
+// Vehicle geometry (typical values).
+#define WHEEL_BASE			1.55f
+#define WEIGHT_BIAS			0.5f
+#define TRACK_WIDTH_FRONT	1.22f
+#define TRACK_WIDTH_REAR	1.2f
+#define GEAR_RATIO			11.83f
+#define WHEEL_RADIUS		8.0f
+
+// Global Memory --------------------------------------------------------------------------------------------------------------
+
+static torqueAllocationConfig_t config =
+{
+	.distribution		= { 0.25f, 0.25f, 0.25f, 0.25f },
+	.torqueWeight		= 1.0f,
+	.yawMomentWeight	= 1.0f,	// Normalized by the transfer scalars, see main.
+	.motorWeights		= { 0.01f, 0.01f, 0.01f, 0.01f }
+};
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+static float getTorqueTotal (const float* torques)
+{
+	return torques [0] + torques [1] + torques [2] + torques [3];
+}
+
+static float getYawMoment (const float* torques)
+{
+	float yawMoment = 0.0f;
+	for (uint8_t i = 0; i < N; ++i)
+		yawMoment += config.yawMomentTransfers [i] * torques [i];
+	return yawMoment;
+}
+
+/**
+ * @brief Checks an allocation is within the limits, and satisfies the optimality conditions of the problem.
+ */
+static void checkOptimal (const char* name, float torqueTotal, float yawMoment, const float* torquesMin,
+	const float* torquesMax, const float* torques)
+{
+	// Residuals of the outputs and each motor's preferred torque.
+	float wt2 = config.torqueWeight * config.torqueWeight;
+	float wm2 = config.yawMomentWeight * config.yawMomentWeight;
+	float torqueError = getTorqueTotal (torques) - torqueTotal;
+	float yawMomentError = getYawMoment (torques) - yawMoment;
+
+	// Scale of the gradient's terms, such that the tolerance is relative.
+	float scale = wt2 * fabsf (torqueTotal) + wm2 * fabsf (yawMoment) + 1.0f;
+	for (uint8_t i = 0; i < N; ++i)
+		scale += (wt2 + wm2 * fabsf (config.yawMomentTransfers [i])) * fabsf (torques [i]) * N;
+
+	for (uint8_t i = 0; i < N; ++i)
+	{
+		TEST_CHECK (torques [i] >= torquesMin [i] - TORQUE_TOLERANCE && torques [i] <= torquesMax [i] + TORQUE_TOLERANCE,
+			"%s: Motor %u: Torque %f outside of [%f, %f].", name, i, torques [i], torquesMin [i], torquesMax [i]);
+
+		// Gradient of the cost, with respect to the motor's torque (less the common factor of 2).
+		float wu2 = config.motorWeights [i] * config.motorWeights [i];
+		float gradient = wt2 * torqueError + wm2 * config.yawMomentTransfers [i] * yawMomentError +
+			wu2 * (torques [i] - config.distribution [i] * torqueTotal);
+
+		float tolerance = GRADIENT_TOLERANCE * scale;
+		bool atMin = torques [i] <= torquesMin [i] + TORQUE_TOLERANCE;
+		bool atMax = torques [i] >= torquesMax [i] - TORQUE_TOLERANCE;
+		bool optimal = (atMin && gradient >= -tolerance) || (atMax && gradient <= tolerance) || fabsf (gradient) <= tolerance;
+		TEST_CHECK (optimal, "%s: Motor %u: Torque %f in [%f, %f] not optimal, gradient %f.", name, i, torques [i],
+			torquesMin [i], torquesMax [i], gradient);
+	}
+}
+
+/**
+ * @brief Performs an allocation from a cold start, checking it converges to the optimum.
+ */
+static void allocate (const char* name, float torqueTotal, float yawMoment, const float* torquesMin, const float* torquesMax,
+	float* torques)
+{
+	for (uint8_t i = 0; i < N; ++i)
+		torques [i] = 0.0f;
+
+	uint8_t iterations;
+	bool converged = torqueAllocate (&config, torqueTotal, yawMoment, torquesMin, torquesMax, torques, &iterations);
+	TEST_CHECK (converged, "%s: Not converged after %u iterations.", name, iterations);
+	TEST_CHECK (iterations >= 1 && iterations <= TORQUE_ALLOCATION_ITERATIONS_MAX, "%s: Bad iteration count %u.", name,
+		iterations);
+
+	checkOptimal (name, torqueTotal, yawMoment, torquesMin, torquesMax, torques);
+}
+
+static float randomFloat (float min, float max)
+{
+	return min + (max - min) * ((float) rand () / (float) RAND_MAX);
+}
+
+// Tests ----------------------------------------------------------------------------------------------------------------------
+
+static void testExact (void)
+{
+	const float torquesMin [N] = { -21.0f, -21.0f, -21.0f, -21.0f };
+	const float torquesMax [N] = { 21.0f, 21.0f, 21.0f, 21.0f };
+	float torques [N];
+
+	// Achievable outputs are met, each motor being left within its limits.
+	const float outputs [][2] = { { 0.0f, 0.0f }, { 40.0f, 0.0f }, { -40.0f, 0.0f }, { 40.0f, 500.0f }, { 20.0f, -800.0f } };
+	for (uint8_t index = 0; index < sizeof (outputs) / sizeof (outputs [0]); ++index)
+	{
+		float torqueTotal = outputs [index][0];
+		float yawMoment = outputs [index][1];
+		allocate ("Exact", torqueTotal, yawMoment, torquesMin, torquesMax, torques);
+
+		TEST_CHECK (fabsf (getTorqueTotal (torques) - torqueTotal) <= OUTPUT_TOLERANCE * (fabsf (torqueTotal) + 1.0f),
+			"Exact %u: Expected total torque %f, got %f.", index, torqueTotal, getTorqueTotal (torques));
+		TEST_CHECK (fabsf (getYawMoment (torques) - yawMoment) <= OUTPUT_TOLERANCE * (fabsf (yawMoment) + 1.0f),
+			"Exact %u: Expected yaw moment %f, got %f.", index, yawMoment, getYawMoment (torques));
+	}
+
+	// Without a yaw moment, the total torque is distributed per the configuration.
+	allocate ("Exact", 40.0f, 0.0f, torquesMin, torquesMax, torques);
+	for (uint8_t i = 0; i < N; ++i)
+		TEST_CHECK (fabsf (torques [i] - 10.0f) <= TORQUE_TOLERANCE, "Exact: Motor %u: Expected 10, got %f.", i, torques [i]);
+}
+
+static void testTorqueSaturated (void)
+{
+	const float torquesMin [N] = { -21.0f, -21.0f, -21.0f, -21.0f };
+	const float torquesMax [N] = { 21.0f, 21.0f, 21.0f, 21.0f };
+	float torques [N];
+
+	// The total torque exceeds the motors' capability. Prioritizing the yaw moment, it is nearly met, the total torque
+	// being sacrificed instead. Note the weights only balance the errors, so neither output is met exactly.
+	float yawMomentWeight = config.yawMomentWeight;
+	config.yawMomentWeight *= 10.0f;
+	allocate ("Torque saturated", 100.0f, 300.0f, torquesMin, torquesMax, torques);
+	config.yawMomentWeight = yawMomentWeight;
+
+	TEST_CHECK (fabsf (getYawMoment (torques) - 300.0f) <= PRIORITY_TOLERANCE * 300.0f,
+		"Torque saturated: Expected yaw moment 300, got %f.", getYawMoment (torques));
+	TEST_CHECK (getTorqueTotal (torques) < 84.0f && getTorqueTotal (torques) > 70.0f,
+		"Torque saturated: Expected total torque below 84, got %f.", getTorqueTotal (torques));
+}
+
+static void testYawMomentSaturated (void)
+{
+	const float torquesMin [N] = { -21.0f, -21.0f, -21.0f, -21.0f };
+	const float torquesMax [N] = { 21.0f, 21.0f, 21.0f, 21.0f };
+	float torques [N];
+
+	// The yaw moment exceeds the motors' capability. Prioritizing the total torque, it is met exactly, while the yaw moment
+	// is as large as possible: the motors on one side at their upper limit, the other at their lower limit.
+	config.torqueWeight = 10.0f;
+	allocate ("Yaw moment saturated", 0.0f, 10000.0f, torquesMin, torquesMax, torques);
+	config.torqueWeight = 1.0f;
+
+	float yawMomentMax = 0.0f;
+	for (uint8_t i = 0; i < N; ++i)
+		yawMomentMax += fabsf (config.yawMomentTransfers [i]) * torquesMax [i];
+
+	TEST_CHECK (fabsf (getTorqueTotal (torques)) <= TORQUE_TOLERANCE * N, "Yaw moment saturated: Expected no total torque, "
+		"got %f.", getTorqueTotal (torques));
+	TEST_CHECK (fabsf (getYawMoment (torques) - yawMomentMax) <= OUTPUT_TOLERANCE * yawMomentMax,
+		"Yaw moment saturated: Expected yaw moment %f, got %f.", yawMomentMax, getYawMoment (torques));
+	for (uint8_t i = 0; i < N; ++i)
+	{
+		float expected = config.yawMomentTransfers [i] > 0.0f ? torquesMax [i] : torquesMin [i];
+		TEST_CHECK (fabsf (torques [i] - expected) <= TORQUE_TOLERANCE, "Yaw moment saturated: Motor %u: Expected %f, got %f.",
+			i, expected, torques [i]);
+	}
+}
+
+static void testAllSaturated (void)
+{
+	// Asymmetric limits, as if each motor were de-rated differently.
+	const float torquesMin [N] = { -9.0f, -12.0f, -15.0f, -18.0f };
+	const float torquesMax [N] = { 10.0f, 14.0f, 18.0f, 21.0f };
+	float torques [N];
+
+	// Both outputs exceed the motors' capability in the same direction, so every motor is at its limit.
+	allocate ("All saturated", 1000.0f, 0.0f, torquesMin, torquesMax, torques);
+	for (uint8_t i = 0; i < N; ++i)
+		TEST_CHECK (torques [i] == torquesMax [i], "All saturated: Motor %u: Expected %f, got %f.", i, torquesMax [i],
+			torques [i]);
+
+	allocate ("All saturated", -1000.0f, 0.0f, torquesMin, torquesMax, torques);
+	for (uint8_t i = 0; i < N; ++i)
+		TEST_CHECK (torques [i] == torquesMin [i], "All saturated: Motor %u: Expected %f, got %f.", i, torquesMin [i],
+			torques [i]);
+
+	// Limits collapsed to a single point leave no freedom.
+	allocate ("All saturated", 50.0f, 100.0f, torquesMax, torquesMax, torques);
+	for (uint8_t i = 0; i < N; ++i)
+		TEST_CHECK (torques [i] == torquesMax [i], "All saturated: Motor %u: Expected %f, got %f.", i, torquesMax [i],
+			torques [i]);
+}
+
+static void testRandom (void)
+{
+	float torques [N] = { 0.0f };
+	for (uint32_t count = 0; count < RANDOM_ALLOCATION_COUNT; ++count)
+	{
+		float torquesMin [N];
+		float torquesMax [N];
+		for (uint8_t i = 0; i < N; ++i)
+		{
+			torquesMin [i] = randomFloat (-21.0f, 0.0f);
+			torquesMax [i] = randomFloat (0.0f, 21.0f);
+		}
+
+		float torqueTotal = randomFloat (-120.0f, 120.0f);
+		float yawMoment = randomFloat (-3000.0f, 3000.0f);
+
+		// Half of the allocations are warm-started from the last, half from a random point.
+		if (count % 2 != 0)
+			for (uint8_t i = 0; i < N; ++i)
+				torques [i] = randomFloat (-30.0f, 30.0f);
+
+		uint8_t iterations;
+		bool converged = torqueAllocate (&config, torqueTotal, yawMoment, torquesMin, torquesMax, torques, &iterations);
+		TEST_CHECK (converged, "Random %u: Not converged after %u iterations.", count, iterations);
+		checkOptimal ("Random", torqueTotal, yawMoment, torquesMin, torquesMax, torques);
+	}
+}
+
+static void testWarmStart (void)
+{
+	const float torquesMin [N] = { -21.0f, -21.0f, -21.0f, -21.0f };
+	const float torquesMax [N] = { 21.0f, 21.0f, 21.0f, 21.0f };
+
+	// Starting from the opposite limits requires releasing every motor.
+	float torques [N] = { -21.0f, 21.0f, -21.0f, 21.0f };
+	uint8_t iterations;
+	bool converged = torqueAllocate (&config, 80.0f, 0.0f, torquesMin, torquesMax, torques, &iterations);
+	TEST_CHECK (converged && iterations > N, "Warm start: Expected convergence after more than %u iterations, got %i after "
+		"%u.", N, converged, iterations);
+
+	// Re-allocating the same outputs, warm-started from the solution, only confirms the solution.
+	converged = torqueAllocate (&config, 80.0f, 0.0f, torquesMin, torquesMax, torques, &iterations);
+	TEST_CHECK (converged && iterations == 1, "Warm start: Expected convergence after 1 iteration, got %i after %u.",
+		converged, iterations);
+
+	// The iteration count is optional.
+	TEST_CHECK (torqueAllocate (&config, 80.0f, 0.0f, torquesMin, torquesMax, torques, NULL), "Warm start: Not converged.");
+}
+
+int main (void)
+{
+	srand (RANDOM_SEED);
+
+	// Transfer scalars of the vehicle, with the wheels straight.
+	config.yawMomentTransfers [TORQUE_ALLOCATION_FL] = motorFlYawMomentTransfer (WHEEL_BASE, WEIGHT_BIAS, TRACK_WIDTH_FRONT,
+		GEAR_RATIO, WHEEL_RADIUS, 0.0f);
+	config.yawMomentTransfers [TORQUE_ALLOCATION_FR] = motorFrYawMomentTransfer (WHEEL_BASE, WEIGHT_BIAS, TRACK_WIDTH_FRONT,
+		GEAR_RATIO, WHEEL_RADIUS, 0.0f);
+	config.yawMomentTransfers [TORQUE_ALLOCATION_RL] = motorRlYawMomentTransfer (TRACK_WIDTH_REAR, GEAR_RATIO, WHEEL_RADIUS);
+	config.yawMomentTransfers [TORQUE_ALLOCATION_RR] = motorRrYawMomentTransfer (TRACK_WIDTH_REAR, GEAR_RATIO, WHEEL_RADIUS);
+
+	// Weigh a yaw moment error equally to the total torque error producing it.
+	config.yawMomentWeight = 1.0f / config.yawMomentTransfers [TORQUE_ALLOCATION_RL];
+
+	testExact ();
+	testTorqueSaturated ();
+	testYawMomentSaturated ();
+	testAllSaturated ();
+	testRandom ();
+	testWarmStart ();
+
+	return testResult ("torque_allocation_test");
+}
\ No newline at end of file
@@ -0,0 +1,244 @@
+// Vehicle Dynamics Benchmark -------------------------------------------------------------------------------------------------
+//
+// Author: Cole Barach
+// Date Created: 2026.10.16
+//
+// Description: Compares the lookup table trigonometry (see @c sinLut ) and the cached yaw moment transfers (see
+//   @c motorFlYawMomentTransferCached ) against the functions they replace, in both cost and maximum error. Fails if an
+//   approximation exceeds its documented error, or if a non-finite angle does not give NaN.
+//
+//   Each function is evaluated over a sweep of angles, as when reading a sensor (ex. the steering angle), and over random
+//   angles, which defeat the host's branch prediction. Note the cost is not checked, as the host's math library is not
+//   representative of the target's (on which @c sinf and @c cosf are software routines).
+
+// Includes -------------------------------------------------------------------------------------------------------------------
+
+// Includes
+#include "benchmark.h"
+#include "vehicle_dynamics.h"
+
+// C Standard Library
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Constants ------------------------------------------------------------------------------------------------------------------
+
+/// @brief The number of distinct angles to evaluate.
+#define ANGLE_COUNT 4096
+
+/// @brief The number of times each angle is evaluated, per repetition.
+#define PASS_COUNT 100
+
+/// @brief The seed of the random angles, fixed so results are reproducible.
+#define RANDOM_SEED 0x5EED
+
+/// @brief The maximum error of @c sinLut and @c cosLut , as documented.
+#define TRIG_ERROR_MAX 4e-5f
+
+/// @brief The maximum error of the cached transfers, relative to the magnitude of the transfer.
+#define TRANSFER_ERROR_MAX 1e-4f
+
+// Vehicle geometry (typical values).
+#define WHEEL_BASE			1.55f
+#define WEIGHT_BIAS			0.5f
+#define TRACK_WIDTH_FRONT	1.22f
+#define GEAR_RATIO			11.83f
+#define WHEEL_RADIUS		8.0f
+
+// Datatypes ------------------------------------------------------------------------------------------------------------------
+
+typedef float (function_t) (float);
+
+typedef struct
+{
+	/// @brief The name to print.
+	const char* name;
+
+	/// @brief The approximation under test.
+	function_t* approximation;
+
+	/// @brief The function the approximation replaces.
+	function_t* reference;
+
+	/// @brief The angles to evaluate as a sweep.
+	const float* sweepAngles;
+
+	/// @brief The angles to evaluate in a random order.
+	const float* randomAngles;
+
+	/// @brief The magnitude of the function, the error is relative to this.
+	float magnitude;
+
+	/// @brief The maximum (relative) error of the approximation.
+	float errorMax;
+} benchmarkCase_t;
+
+// Global Memory --------------------------------------------------------------------------------------------------------------
+
+/// @brief Angles of the full range of the trigonometric functions, in degrees.
+static float sweepAngles [ANGLE_COUNT];
+static float randomAngles [ANGLE_COUNT];
+
+/// @brief Angles of the steering range of the wheels, in degrees.
+static float sweepWheelAngles [ANGLE_COUNT];
+static float randomWheelAngles [ANGLE_COUNT];
+
+static yawMomentGeometry_t geometry;
+
+/// @brief The geometry of the vehicle. Read from volatile memory, as the vehicle's parameters would be, such that the
+/// trigonometry of @c motorFlYawMomentTransfer is not folded into constants.
+static volatile float wheelBase			= WHEEL_BASE;
+static volatile float weightBias		= WEIGHT_BIAS;
+static volatile float trackWidthFront	= TRACK_WIDTH_FRONT;
+
+/// @brief Sink of the evaluated functions, such that they cannot be optimized out.
+static volatile float sink;
+
+// Functions ------------------------------------------------------------------------------------------------------------------
+
+static float sinDegrees (float angle)
+{
+	return sinf (DEGREES_TO_RADIANS (angle));
+}
+
+static float cosDegrees (float angle)
+{
+	return cosf (DEGREES_TO_RADIANS (angle));
+}
+
+static float transferCached (float wheelAngle)
+{
+	return motorFlYawMomentTransferCached (&geometry, wheelAngle) + motorFrYawMomentTransferCached (&geometry, wheelAngle);
+}
+
+static float transfer (float wheelAngle)
+{
+	return motorFlYawMomentTransfer (wheelBase, weightBias, trackWidthFront, GEAR_RATIO, WHEEL_RADIUS, wheelAngle) +
+		motorFrYawMomentTransfer (wheelBase, weightBias, trackWidthFront, GEAR_RATIO, WHEEL_RADIUS, wheelAngle);
+}
+
+/**
+ * @brief Measures the cost of a single pass of a function over each angle. The function is called through a volatile
+ * pointer, such that each implementation pays the same call overhead, and cannot be folded into the loop.
+ * @return The number of ticks elapsed.
+ */
+static uint64_t measure (function_t* volatile function, const float* angles)
+{
+	float sum = 0.0f;
+	uint64_t start = benchmarkTicks ();
+	for (uint16_t pass = 0; pass < PASS_COUNT; ++pass)
+		for (uint16_t index = 0; index < ANGLE_COUNT; ++index)
+			sum += function (angles [index]);
+	uint64_t ticks = benchmarkTicks () - start;
+
+	sink = sum;
+	return ticks;
+}
+
+/**
+ * @brief Calculates the maximum error of an approximation over each angle.
+ */
+static float getErrorMax (const benchmarkCase_t* test, const float* angles)
+{
+	float errorMax = 0.0f;
+	for (uint16_t index = 0; index < ANGLE_COUNT; ++index)
+	{
+		float error = fabsf (test->approximation (angles [index]) - test->reference (angles [index]));
+		errorMax = fmaxf (errorMax, error / test->magnitude);
+	}
+	return errorMax;
+}
+
+/**
+ * @brief Benchmarks an approximation against the function it replaces.
+ * @return True if the approximation is within its maximum error, false otherwise.
+ */
+static bool benchmark (const benchmarkCase_t* test)
+{
+	// Repetitions of each measurement are interleaved, such that changes in the host's clock affect each equally.
+	uint64_t samples [4][BENCHMARK_REPETITIONS];
+	for (uint16_t repetition = 0; repetition < BENCHMARK_REPETITIONS; ++repetition)
+	{
+		samples [0][repetition] = measure (test->approximation, test->sweepAngles);
+		samples [1][repetition] = measure (test->reference, test->sweepAngles);
+		samples [2][repetition] = measure (test->approximation, test->randomAngles);
+		samples [3][repetition] = measure (test->reference, test->randomAngles);
+	}
+
+	float callCount = (float) PASS_COUNT * ANGLE_COUNT;
+	float sweepTicks = benchmarkMedian (samples [0], BENCHMARK_REPETITIONS) / callCount;
+	float sweepReferenceTicks = benchmarkMedian (samples [1], BENCHMARK_REPETITIONS) / callCount;
+	float randomTicks = benchmarkMedian (samples [2], BENCHMARK_REPETITIONS) / callCount;
+	float randomReferenceTicks = benchmarkMedian (samples [3], BENCHMARK_REPETITIONS) / callCount;
+
+	float errorMax = fmaxf (getErrorMax (test, test->sweepAngles), getErrorMax (test, test->randomAngles));
+
+	printf ("  %-17s %6.2f vs. %6.2f (%.2fx)  %6.2f vs. %6.2f (%.2fx)  %.2e\n", test->name, sweepTicks, sweepReferenceTicks,
+		sweepReferenceTicks / sweepTicks, randomTicks, randomReferenceTicks, randomReferenceTicks / randomTicks, errorMax);
+
+	if (errorMax > test->errorMax)
+	{
+		printf ("vehicle_dynamics_benchmark: %s exceeds its maximum error of %.2e.\n", test->name, test->errorMax);
+		return false;
+	}
+
+	return true;
+}
+
+static float randomFloat (float min, float max)
+{
+	return min + (max - min) * ((float) rand () / (float) RAND_MAX);
+}
+
+int main (void)
+{
+	srand (RANDOM_SEED);
+
+	for (uint16_t index = 0; index < ANGLE_COUNT; ++index)
+	{
+		float fraction = (float) index / ANGLE_COUNT;
+		sweepAngles [index] = -360.0f + 720.0f * fraction;
+		randomAngles [index] = randomFloat (-360.0f, 360.0f);
+
+		// Steering back and forth between full lock.
+		sweepWheelAngles [index] = 30.0f * sinf (2.0f * M_PI * 4.0f * fraction);
+		randomWheelAngles [index] = randomFloat (-30.0f, 30.0f);
+	}
+
+	yawMomentGeometryInit (&geometry, WHEEL_BASE, WEIGHT_BIAS, TRACK_WIDTH_FRONT, GEAR_RATIO, WHEEL_RADIUS);
+
+	// The transfer error is relative to the magnitude of the transfer, that is, the lever arm scaled by the gear ratio.
+	float transferMagnitude = sqrtf (geometry.transferCos * geometry.transferCos +
+		geometry.transferSin * geometry.transferSin);
+
+	const benchmarkCase_t cases [] =
+	{
+		{ "sinLut", sinLut, sinDegrees, sweepAngles, randomAngles, 1.0f, TRIG_ERROR_MAX },
+		{ "cosLut", cosLut, cosDegrees, sweepAngles, randomAngles, 1.0f, TRIG_ERROR_MAX },
+		{ "Cached transfers", transferCached, transfer, sweepWheelAngles, randomWheelAngles, transferMagnitude,
+			TRANSFER_ERROR_MAX }
+	};
+
+	printf ("vehicle_dynamics_benchmark: Approximation vs. replaced function (%s per call):\n", BENCHMARK_TICK_UNIT);
+	printf ("  %-17s %-27s %-27s %s\n", "", "Sweep", "Random", "Error");
+
+	int result = 0;
+	for (uint8_t index = 0; index < sizeof (cases) / sizeof (cases [0]); ++index)
+		if (!benchmark (&cases [index]))
+			result = 1;
+
+	// Non-finite angles must not be used as a table index.
+	volatile float nonFinite [] = { NAN, INFINITY, -INFINITY };
+	for (uint8_t index = 0; index < sizeof (nonFinite) / sizeof (nonFinite [0]); ++index)
+	{
+		if (!isnan (sinLut (nonFinite [index])) || !isnan (cosLut (nonFinite [index])))
+		{
+			printf ("vehicle_dynamics_benchmark: sinLut / cosLut of %f is not NaN.\n", nonFinite [index]);
+			result = 1;
+		}
+	}
+
+	return result;
+}
\ No newline at end of file
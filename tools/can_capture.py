@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+
+# CAN Capture Converter --------------------------------------------------------------------------------------------------------
+#
+# Author: Cole Barach
+# Date Created: 2026.10.16
+#
+# Description: Converts between the binary capture format written by the can_capture module (see src/can/can_capture.h) and
+#   the candump log format used by can-utils. A converted capture can be replayed onto a real bus using can-utils' canplayer,
+#   for example to feed a bench board's CAN node handlers with traffic captured on the vehicle.
+#
+# Usage:
+#   can_capture.py to-candump <capture file> <log file> [--interfaces can0,can1]
+#   can_capture.py from-candump <log file> <capture file> [--interfaces can0,can1] [--frequency <Hz>]
+#   can_capture.py print <capture file> [--interfaces can0,can1]
+#
+#   Interfaces map capture channels to candump interface names, by index (channel 0 is the first interface).
+
+import argparse
+import re
+import struct
+import sys
+
+# Binary Format ----------------------------------------------------------------------------------------------------------------
+
+MAGIC			= b"CCAP"
+VERSION			= 1
+HEADER_FORMAT	= "<4sBBHII"
+RECORD_FORMAT	= "<IIBBBB8s"
+HEADER_SIZE		= struct.calcsize (HEADER_FORMAT)
+RECORD_SIZE		= struct.calcsize (RECORD_FORMAT)
+
+ID_EXTENDED_FLAG	= 0x80000000
+ID_VALUE_MASK		= 0x1FFFFFFF
+FLAG_RTR			= 0x01
+
+class Record:
+	def __init__ (self, time, id, extended, dlc, rtr, channel, data):
+		self.time		= time
+		self.id			= id
+		self.extended	= extended
+		self.dlc		= dlc
+		self.rtr		= rtr
+		self.channel	= channel
+		self.data		= data
+
+def readCapture (path):
+	with open (path, "rb") as file:
+		content = file.read ()
+
+	# Captures read from a serial port may be preceded by other output, so search for the header.
+	start = content.find (MAGIC)
+	if start < 0:
+		raise ValueError ("No capture header found in '%s'." % path)
+
+	magic, version, recordSize, _, frequency, count = struct.unpack_from (HEADER_FORMAT, content, start)
+	if version != VERSION or recordSize != RECORD_SIZE:
+		raise ValueError ("Unsupported capture version %d (record size %d)." % (version, recordSize))
+
+	records = []
+	offset = start + HEADER_SIZE
+	for index in range (count):
+		if offset + RECORD_SIZE > len (content):
+			print ("Warning: Capture truncated after %d of %d records." % (index, count), file = sys.stderr)
+			break
+
+		time, id, dlc, flags, channel, _, data = struct.unpack_from (RECORD_FORMAT, content, offset)
+		offset += RECORD_SIZE
+		records.append (Record (time, id & ID_VALUE_MASK, (id & ID_EXTENDED_FLAG) != 0, dlc, (flags & FLAG_RTR) != 0,
+			channel, data [:min (dlc, 8)]))
+
+	return frequency, records
+
+def writeCapture (path, frequency, records):
+	with open (path, "wb") as file:
+		file.write (struct.pack (HEADER_FORMAT, MAGIC, VERSION, RECORD_SIZE, 0, frequency, len (records)))
+		for record in records:
+			id = record.id | (ID_EXTENDED_FLAG if record.extended else 0)
+			flags = FLAG_RTR if record.rtr else 0
+			file.write (struct.pack (RECORD_FORMAT, record.time & 0xFFFFFFFF, id, record.dlc, flags, record.channel, 0,
+				record.data.ljust (8, b"\0")))
+
+# Candump Format ---------------------------------------------------------------------------------------------------------------
+
+CANDUMP_PATTERN = re.compile (r"^\((\d+\.\d+)\)\s+(\S+)\s+([0-9A-Fa-f]+)#(R\d?|[0-9A-Fa-f]*)$")
+
+def recordsToCandump (frequency, records, interfaces):
+	lines = []
+	timeOffset = 0
+	timePrevious = None
+	for record in records:
+		# Timestamps are 32-bit tick counts, account for them overflowing.
+		if timePrevious != None and record.time < timePrevious:
+			timeOffset += 1 << 32
+		timePrevious = record.time
+		seconds = (record.time + timeOffset) / frequency
+
+		interface = interfaces [record.channel] if record.channel < len (interfaces) else "can%d" % record.channel
+		id = ("%08X" if record.extended else "%03X") % record.id
+		payload = ("R%d" % record.dlc) if record.rtr else record.data.hex ().upper ()
+		lines.append ("(%.6f) %s %s#%s" % (seconds, interface, id, payload))
+	return "\n".join (lines) + "\n"
+
+def candumpToRecords (text, frequency, interfaces):
+	records = []
+	for line in text.splitlines ():
+		match = CANDUMP_PATTERN.match (line.strip ())
+		if not match:
+			continue
+
+		seconds, interface, id, payload = match.groups ()
+		channel = interfaces.index (interface) if interface in interfaces else 0
+		rtr = payload.startswith ("R")
+		data = b"" if rtr else bytes.fromhex (payload)
+		dlc = (int (payload [1:]) if len (payload) > 1 else 0) if rtr else len (data)
+		records.append (Record (int (float (seconds) * frequency), int (id, 16), len (id) > 3, dlc, rtr, channel, data))
+	return records
+
+# Entrypoint -------------------------------------------------------------------------------------------------------------------
+
+def main ():
+	parser = argparse.ArgumentParser (description = "Converts CAN captures to and from candump log files.")
+	commands = parser.add_subparsers (dest = "command", required = True)
+
+	toCandump = commands.add_parser ("to-candump", help = "Converts a binary capture into a candump log file.")
+	toCandump.add_argument ("capture")
+	toCandump.add_argument ("log")
+	toCandump.add_argument ("--interfaces", default = "can0,can1", help = "Interface name of each channel.")
+
+	fromCandump = commands.add_parser ("from-candump", help = "Converts a candump log file into a binary capture.")
+	fromCandump.add_argument ("log")
+	fromCandump.add_argument ("capture")
+	fromCandump.add_argument ("--interfaces", default = "can0,can1", help = "Interface name of each channel.")
+	fromCandump.add_argument ("--frequency", type = int, default = 10000, help = "System tick frequency, in Hz.")
+
+	printCapture = commands.add_parser ("print", help = "Prints a binary capture in candump format.")
+	printCapture.add_argument ("capture")
+	printCapture.add_argument ("--interfaces", default = "can0,can1", help = "Interface name of each channel.")
+
+	args = parser.parse_args ()
+
+	if args.command == "to-candump":
+		frequency, records = readCapture (args.capture)
+		with open (args.log, "w") as file:
+			file.write (recordsToCandump (frequency, records, args.interfaces.split (",")))
+	elif args.command == "from-candump":
+		with open (args.log, "r") as file:
+			records = candumpToRecords (file.read (), args.frequency, args.interfaces.split (","))
+		writeCapture (args.capture, args.frequency, records)
+	else:
+		frequency, records = readCapture (args.capture)
+		sys.stdout.write (recordsToCandump (frequency, records, args.interfaces.split (",")))
+
+	return 0
+
+if __name__ == "__main__":
+	sys.exit (main ())
@@ -0,0 +1,532 @@
+#!/usr/bin/env python3
+
+# DBC to CAN Node Generator ----------------------------------------------------------------------------------------------------
+#
+# Author: Cole Barach
+# Date Created: 2026.10.16
+#
+# Description: Generates a CAN node (header / source pair) from a DBC file. The node receives each message transmitted by the
+#   specified DBC node, and provides pack functions for each message received by it. The generated node has:
+#   - A struct containing the CAN node fields and a field per received signal. Signal names reused across messages are
+#     qualified with the message's name (ex. 'Counter' of message 'Status' becomes 'statusCounter').
+#   - A configuration struct and init function, forwarding optional per-message timeout periods.
+#   - A switch-based receive handler, decoding each signal using constant shifts and masks.
+#   - An ID handler, for indexing by the CAN thread.
+#   - A pack function per transmitted message. Values are rounded to the nearest raw value, and saturated to the range of the
+#     signal.
+#
+#   Multiplexed signals are not supported, messages containing them are skipped.
+#
+# Usage: dbc_to_can_node.py <DBC file> <output directory> [--node <DBC node>] [--name <file name>] [--prefix <prefix>]
+#   If not specified, the DBC node defaults to the DBC file's name, the file name defaults to the DBC file's name prefixed with
+#   'dbc_' (such that generated files cannot collide with the library's hand-written nodes), and the prefix defaults to the file
+#   name in camel case. For example, 'bms.dbc' generates 'dbc_bms.h' and 'dbc_bms.c', defining 'dbcBms_t'.
+
+import argparse
+import os
+import re
+import sys
+import textwrap
+
+# DBC Parsing ------------------------------------------------------------------------------------------------------------------
+
+class Signal:
+	def __init__ (self, name, startBit, length, littleEndian, isSigned, factor, offset, unit, receivers):
+		self.name			= name
+		self.startBit		= startBit
+		self.length			= length
+		self.littleEndian	= littleEndian
+		self.isSigned		= isSigned
+		self.factor			= factor
+		self.offset			= offset
+		self.unit			= unit
+		self.receivers		= receivers
+		self.comment		= None
+		self.multiplexed	= False
+
+class Message:
+	def __init__ (self, id, extended, name, dlc, transmitter):
+		self.id				= id
+		self.extended		= extended
+		self.name			= name
+		self.dlc			= dlc
+		self.transmitter	= transmitter
+		self.signals		= []
+		self.comment		= None
+
+MESSAGE_PATTERN = re.compile (r"^BO_\s+(\d+)\s+(\w+)\s*:\s*(\d+)\s+(\w+)")
+SIGNAL_PATTERN = re.compile (r"^SG_\s+(\w+)\s*(\w+)?\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*\(([^,]+),([^)]+)\)\s*\[[^\]]*\]\s*\"([^\"]*)\"\s*(.*)$")
+MESSAGE_COMMENT_PATTERN = re.compile (r"^CM_\s+BO_\s+(\d+)\s+\"([^\"]*)\"\s*;", re.DOTALL)
+SIGNAL_COMMENT_PATTERN = re.compile (r"^CM_\s+SG_\s+(\d+)\s+(\w+)\s+\"([^\"]*)\"\s*;", re.DOTALL)
+
+def parseDbc (path):
+	comments = {}
+	messages = []
+	message = None
+
+	with open (path, "r", encoding = "latin-1") as file:
+		text = file.read ()
+
+	# Comments may span multiple lines, so they are parsed from the whole text.
+	for statement in re.findall (r"^CM_ [^;]*;", text, re.MULTILINE | re.DOTALL):
+		match = SIGNAL_COMMENT_PATTERN.match (statement)
+		if match:
+			rawId, name, comment = match.groups ()
+			comments [("signal", int (rawId), name)] = " ".join (comment.split ())
+			continue
+
+		match = MESSAGE_COMMENT_PATTERN.match (statement)
+		if match:
+			rawId, comment = match.groups ()
+			comments [("message", int (rawId))] = " ".join (comment.split ())
+
+	for line in text.splitlines ():
+		line = line.strip ()
+
+		match = MESSAGE_PATTERN.match (line)
+		if match:
+			rawId, name, dlc, transmitter = match.groups ()
+			rawId = int (rawId)
+			message = Message (rawId & 0x1FFFFFFF, (rawId & 0x80000000) != 0, name, int (dlc), transmitter)
+			message.comment = comments.get (("message", rawId))
+			messages.append (message)
+			continue
+
+		match = SIGNAL_PATTERN.match (line)
+		if match and message != None:
+			name, multiplexer, startBit, length, byteOrder, sign, factor, offset, unit, receivers = match.groups ()
+			signal = Signal (name, int (startBit), int (length), byteOrder == "1", sign == "-", float (factor), float (offset),
+				unit, [receiver.strip () for receiver in receivers.split (",") if receiver.strip () != ""])
+			signal.comment = comments.get (("signal", message.id | (0x80000000 if message.extended else 0), name))
+			signal.multiplexed = multiplexer != None
+			message.signals.append (signal)
+			continue
+
+		# Any other statement ends the current message.
+		if line != "" and not line.startswith ("SG_"):
+			message = None
+
+	return messages
+
+# Naming -----------------------------------------------------------------------------------------------------------------------
+
+def camelCase (name, upperFirst = False):
+	words = [word for word in re.split (r"[_\W]+|(?<=[a-z0-9])(?=[A-Z])", name) if word != ""]
+	result = "".join (word [0].upper () + word [1:].lower () for word in words)
+	if not upperFirst and result != "":
+		result = result [0].lower () + result [1:]
+	return result
+
+def macroCase (name):
+	words = [word for word in re.split (r"[_\W]+|(?<=[a-z0-9])(?=[A-Z])", name) if word != ""]
+	return "_".join (word.upper () for word in words)
+
+# Fields of the CAN node base (see CAN_NODE_FIELDS), which signal fields may not shadow.
+NODE_FIELD_NAMES = { "state", "driver", "receiveHandler", "timeoutHandler", "idHandler", "timeoutPeriod", "timeoutDeadline",
+	"messageCount", "messageFlags", "validFlags", "messageTimeoutPeriods", "receiveTimes", "sequence", "stats", "eventSource",
+	"mutex" }
+
+def qualifiedName (message, signal):
+	return camelCase (message.name) + camelCase (signal.name, True)
+
+def nameFields (messages):
+	"""Names the node's field of each received signal. DBC files commonly reuse signal names across messages (ex. 'Counter'),
+	so colliding names are qualified with their message's name (ex. 'statusCounter'). Returns an error message if the
+	qualified names still collide, otherwise None."""
+	counts = {}
+	for message in messages:
+		for signal in message.signals:
+			counts [camelCase (signal.name)] = counts.get (camelCase (signal.name), 0) + 1
+
+	owners = {}
+	for message in messages:
+		for signal in message.signals:
+			signal.fieldName = camelCase (signal.name)
+			if counts [signal.fieldName] > 1 or signal.fieldName in NODE_FIELD_NAMES:
+				signal.fieldName = qualifiedName (message, signal)
+
+			if signal.fieldName in owners or signal.fieldName in NODE_FIELD_NAMES:
+				return "Signal '%s.%s' collides with field '%s'%s." % (message.name, signal.name, signal.fieldName,
+					" of signal '%s'" % owners [signal.fieldName] if signal.fieldName in owners else " of the CAN node")
+			owners [signal.fieldName] = message.name + "." + signal.name
+
+	return None
+
+def nameParameters (message):
+	"""Names the pack function's parameter of each signal of a message. Signals are qualified with the message's name if they
+	collide with the frame parameter. Returns an error message if the names still collide, otherwise None."""
+	owners = { "frame": None }
+	for signal in message.signals:
+		signal.parameterName = camelCase (signal.name)
+		if signal.parameterName == "frame":
+			signal.parameterName = qualifiedName (message, signal)
+
+		if signal.parameterName in owners:
+			return "Signal '%s.%s' collides with parameter '%s' of signal '%s.%s'." % (message.name, signal.name,
+				signal.parameterName, message.name, owners [signal.parameterName])
+		owners [signal.parameterName] = signal.name
+
+	return None
+
+def banner (title):
+	line = "// " + title + " "
+	return line + "-" * (127 - len (line))
+
+def floatLiteral (value):
+	text = repr (float (value))
+	if "e" not in text and "." not in text:
+		text += ".0"
+	return text + "f"
+
+# Signal Encoding --------------------------------------------------------------------------------------------------------------
+
+def isBoolean (signal):
+	return signal.length == 1 and not signal.isSigned and signal.factor == 1 and signal.offset == 0
+
+def signalShift (signal):
+	"""Gets the shift of a signal's LSB within the payload, read as a little-endian (Intel) or big-endian (Motorola) integer."""
+	if signal.littleEndian:
+		return signal.startBit
+	msb = (7 - signal.startBit // 8) * 8 + signal.startBit % 8
+	return msb - signal.length + 1
+
+def signalMask (signal):
+	return "0x%XU" % ((1 << signal.length) - 1)
+
+def signalRange (signal):
+	"""Gets the minimum and maximum raw values of a signal."""
+	if signal.isSigned:
+		return -(1 << (signal.length - 1)), (1 << (signal.length - 1)) - 1
+	return 0, (1 << signal.length) - 1
+
+def decodeExpression (signal):
+	payload = "payload" if signal.littleEndian else "payloadReversed"
+	raw = "(uint32_t) ((%s >> %d) & %s)" % (payload, signalShift (signal), signalMask (signal))
+
+	if isBoolean (signal):
+		return raw + " != 0"
+
+	if signal.isSigned:
+		# Sign-extend by shifting the sign bit into the MSB, then arithmetic shifting back.
+		if signal.length < 32:
+			raw = "(((int32_t) (%s << %d)) >> %d)" % (raw, 32 - signal.length, 32 - signal.length)
+		else:
+			raw = "(int32_t) " + raw
+
+	expression = raw
+	if signal.factor != 1:
+		expression = "%s * %s" % (expression, floatLiteral (signal.factor))
+	else:
+		expression = "(float) " + expression
+	if signal.offset != 0:
+		expression = "%s + %s" % (expression, floatLiteral (signal.offset))
+	return expression
+
+def encodeStatement (signal, parameter):
+	if isBoolean (signal):
+		raw = "(uint64_t) (%s ? 1 : 0)" % parameter
+	else:
+		value = parameter
+		if signal.offset > 0:
+			value = "(%s - %s)" % (value, floatLiteral (signal.offset))
+		elif signal.offset < 0:
+			value = "(%s + %s)" % (value, floatLiteral (-signal.offset))
+		if signal.factor != 1:
+			value = "%s * %s" % (value, floatLiteral (1.0 / signal.factor))
+		minimum, maximum = signalRange (signal)
+		raw = "((uint64_t) encodeRaw (%s, %dLL, %dLL) & %s)" % (value, minimum, maximum, signalMask (signal))
+
+	payload = "payload" if signal.littleEndian else "payloadReversed"
+	return "%s |= %s << %d;" % (payload, raw, signalShift (signal))
+
+# Code Generation --------------------------------------------------------------------------------------------------------------
+
+def idExpression (message):
+	return ("canIdExtended (0x%X)" if message.extended else "canIdStandard (0x%X)") % message.id
+
+def fieldComment (signal):
+	comment = signal.comment if signal.comment != None else signal.name
+	if signal.unit != "":
+		comment += " (%s)" % signal.unit
+	return comment
+
+def generateHeader (dbcName, name, prefix, rxMessages, txMessages):
+	guard = macroCase (name) + "_H"
+	typeName = prefix + "_t"
+	configName = prefix + "Config_t"
+
+	lines = []
+	lines.append ("#ifndef %s" % guard)
+	lines.append ("#define %s" % guard)
+	lines.append ("")
+	lines.append (banner (camelCase (name, True) + " CAN Node"))
+	lines.append ("//")
+	lines.append ("// Author: Generated by dbc_to_can_node.py")
+	lines.append ("//")
+	lines.append ("// Description: Object representing the %s CAN node. Generated from %s, do not modify by hand." % (name, dbcName))
+	lines.append ("")
+	lines.append (banner ("Includes"))
+	lines.append ("")
+	lines.append ("// Includes")
+	lines.append ("#include \"can/can_node.h\"")
+	lines.append ("")
+	lines.append (banner ("Datatypes"))
+	lines.append ("")
+	lines.append ("typedef struct")
+	lines.append ("{")
+	lines.append ("\t/// @brief The CAN driver of the bus the node belongs to.")
+	lines.append ("\tCANDriver* driver;")
+	lines.append ("")
+	lines.append ("\t/// @brief The interval to timeout the node's data after.")
+	lines.append ("\tsysinterval_t timeoutPeriod;")
+	lines.append ("")
+	comment = ("@brief Optional array of the timeout period of each message (see @c canNodeConfig_t ), indexed as the %s " +
+		"messages. Use @c NULL to only time-out the node as a whole.") % ", ".join (message.name for message in rxMessages)
+	for line in textwrap.wrap (comment, 120):
+		lines.append ("\t/// " + line)
+	lines.append ("\tconst sysinterval_t* messageTimeoutPeriods;")
+	lines.append ("} %s;" % configName)
+	lines.append ("")
+	lines.append ("typedef struct")
+	lines.append ("{")
+	lines.append ("\tCAN_NODE_FIELDS;")
+	for message in rxMessages:
+		lines.append ("")
+		lines.append ("\t// %s" % message.name)
+		for signal in message.signals:
+			lines.append ("")
+			lines.append ("\t/// @brief %s" % fieldComment (signal))
+			lines.append ("\t%s %s;" % ("bool" if isBoolean (signal) else "float", signal.fieldName))
+	lines.append ("} %s;" % typeName)
+	lines.append ("")
+	lines.append (banner ("Functions"))
+	lines.append ("")
+	lines.append ("/**")
+	lines.append (" * @brief Initializes the CAN node using the specified configuration.")
+	lines.append (" * @param node The node to initialize.")
+	lines.append (" * @param config The configuration to use.")
+	lines.append (" */")
+	lines.append ("void %sInit (%s* node, const %s* config);" % (prefix, typeName, configName))
+
+	for message in txMessages:
+		lines.append ("")
+		lines.append ("/**")
+		lines.append (" * @brief Packs the %s message. %s" % (message.name, message.comment if message.comment != None else ""))
+		lines [-1] = lines [-1].rstrip ()
+		lines.append (" * @param frame The frame to pack the message into.")
+		for signal in message.signals:
+			lines.append (" * @param %s %s" % (signal.parameterName, fieldComment (signal)))
+		lines.append (" */")
+		parameters = ["CANTxFrame* frame"] + ["%s %s" % ("bool" if isBoolean (signal) else "float", signal.parameterName)
+			for signal in message.signals]
+		lines.append ("void %sPack%s (%s);" % (prefix, camelCase (message.name, True), ", ".join (parameters)))
+
+	lines.append ("")
+	lines.append ("#endif // %s" % guard)
+	return "\n".join (lines)
+
+def generateSource (name, prefix, rxMessages, txMessages):
+	typeName = prefix + "_t"
+	configName = prefix + "Config_t"
+
+	lines = []
+	lines.append ("// Header")
+	lines.append ("#include \"%s.h\"" % name)
+	lines.append ("")
+	lines.append (banner ("Message IDs"))
+	lines.append ("")
+	for message in rxMessages + txMessages:
+		lines.append ("#define %s_ID\t%s" % (macroCase (message.name), idExpression (message)))
+	lines.append ("")
+	lines.append (banner ("Message Flags"))
+	lines.append ("")
+	lines.append ("#define FLAG_COUNT\t%d" % len (rxMessages))
+	lines.append ("")
+	for index, message in enumerate (rxMessages):
+		lines.append ("#define %s_FLAG_POS\t0x%02X" % (macroCase (message.name), index))
+	lines.append ("")
+	lines.append ("/// @brief The ID of each message, indexed by the message's flag position.")
+	lines.append ("static const canId_t MESSAGE_IDS [FLAG_COUNT] =")
+	lines.append ("{")
+	lines.append (",\n".join ("\t[%s_FLAG_POS] = %s_ID" % (macroCase (message.name), macroCase (message.name))
+		for message in rxMessages))
+	lines.append ("};")
+	lines.append ("")
+	if any (not isBoolean (signal) for message in txMessages for signal in message.signals):
+		lines.append (banner ("Conversions"))
+		lines.append ("")
+		lines.append ("/**")
+		lines.append (" * @brief Converts an unscaled value into a raw signal value, rounding to the nearest integer (halfway cases away from")
+		lines.append (" * zero) and saturating to the signal's range. NaN is converted to the minimum.")
+		lines.append (" */")
+		lines.append ("static inline int64_t encodeRaw (float value, int64_t minimum, int64_t maximum)")
+		lines.append ("{")
+		lines.append ("\tif (!(value > minimum))")
+		lines.append ("\t\treturn minimum;")
+		lines.append ("\tif (value >= maximum)")
+		lines.append ("\t\treturn maximum;")
+		lines.append ("")
+		lines.append ("\t// The value is in range, so truncating it is defined. Note the remainder is exact, and rounding cannot leave the")
+		lines.append ("\t// range.")
+		lines.append ("\tint64_t raw = (int64_t) value;")
+		lines.append ("\tfloat remainder = value - raw;")
+		lines.append ("\tif (remainder >= 0.5f)")
+		lines.append ("\t\treturn raw + 1;")
+		lines.append ("\tif (remainder <= -0.5f)")
+		lines.append ("\t\treturn raw - 1;")
+		lines.append ("\treturn raw;")
+		lines.append ("}")
+		lines.append ("")
+	lines.append (banner ("Receive Functions"))
+	lines.append ("")
+	lines.append ("static int8_t receiveHandler (void* object, CANRxFrame* frame)")
+	lines.append ("{")
+	lines.append ("\t%s* node = object;" % typeName)
+	lines.append ("\tuint64_t payload = frame->data64 [0];")
+	if any (not signal.littleEndian for message in rxMessages for signal in message.signals):
+		lines.append ("\tuint64_t payloadReversed = __builtin_bswap64 (payload);")
+	lines.append ("")
+	# If the node's identifiers are all of one type, the frame's identifier value is compared directly, rather than packing it.
+	# The identifier type is only checked once the value matches, as most frames do not.
+	extended = set (message.extended for message in rxMessages)
+	if len (extended) == 1:
+		isExtended = rxMessages [0].extended
+		lines.append ("\t// Identify and decode the message. Only %s identifiers belong to this node." %
+			("extended" if isExtended else "standard"))
+		lines.append ("\tswitch (frame->%s)" % ("EID" if isExtended else "SID"))
+	else:
+		lines.append ("\t// Identify and decode the message.")
+		lines.append ("\tswitch (canIdFromFrame (frame))")
+	lines.append ("\t{")
+	for message in rxMessages:
+		if len (extended) == 1:
+			lines.append ("\tcase canIdGetValue (%s_ID):" % macroCase (message.name))
+			lines.append ("\t\tif (frame->IDE != %s)" % ("CAN_IDE_EXT" if isExtended else "CAN_IDE_STD"))
+			lines.append ("\t\t\treturn -1;")
+		else:
+			lines.append ("\tcase %s_ID:" % macroCase (message.name))
+		for signal in message.signals:
+			lines.append ("\t\tnode->%s = %s;" % (signal.fieldName, decodeExpression (signal)))
+		lines.append ("\t\treturn %s_FLAG_POS;" % macroCase (message.name))
+		lines.append ("")
+	lines.append ("\tdefault:")
+	lines.append ("\t\t// Message doesn't belong to this node.")
+	lines.append ("\t\treturn -1;")
+	lines.append ("\t}")
+	lines.append ("}")
+	lines.append ("")
+	lines.append ("static canId_t idHandler (void* node, uint8_t index)")
+	lines.append ("{")
+	lines.append ("\t(void) node;")
+	lines.append ("\treturn MESSAGE_IDS [index];")
+	lines.append ("}")
+	lines.append ("")
+	lines.append (banner ("Functions"))
+	lines.append ("")
+	lines.append ("void %sInit (%s* node, const %s* config)" % (prefix, typeName, configName))
+	lines.append ("{")
+	lines.append ("\t// Initialize the CAN node")
+	lines.append ("\tcanNodeConfig_t nodeConfig =")
+	lines.append ("\t{")
+	lines.append ("\t\t.driver\t\t\t\t\t= config->driver,")
+	lines.append ("\t\t.receiveHandler\t\t\t= receiveHandler,")
+	lines.append ("\t\t.timeoutHandler\t\t\t= NULL,")
+	lines.append ("\t\t.idHandler\t\t\t\t= idHandler,")
+	lines.append ("\t\t.timeoutPeriod\t\t\t= config->timeoutPeriod,")
+	lines.append ("\t\t.messageCount\t\t\t= FLAG_COUNT,")
+	lines.append ("\t\t.messageTimeoutPeriods\t= config->messageTimeoutPeriods")
+	lines.append ("\t};")
+	lines.append ("\tcanNodeInit ((canNode_t*) node, &nodeConfig);")
+	lines.append ("}")
+
+	for message in txMessages:
+		parameters = ["CANTxFrame* frame"] + ["%s %s" % ("bool" if isBoolean (signal) else "float", signal.parameterName)
+			for signal in message.signals]
+		lines.append ("")
+		lines.append ("void %sPack%s (%s)" % (prefix, camelCase (message.name, True), ", ".join (parameters)))
+		lines.append ("{")
+		lines.append ("\tuint64_t payload = 0;")
+		reversed = any (not signal.littleEndian for signal in message.signals)
+		if reversed:
+			lines.append ("\tuint64_t payloadReversed = 0;")
+		lines.append ("")
+		for signal in message.signals:
+			lines.append ("\t" + encodeStatement (signal, signal.parameterName))
+		if reversed:
+			lines.append ("\tpayload |= __builtin_bswap64 (payloadReversed);")
+		lines.append ("")
+		if message.extended:
+			lines.append ("\tframe->IDE = CAN_IDE_EXT;")
+			lines.append ("\tframe->EID = 0x%X;" % message.id)
+		else:
+			lines.append ("\tframe->IDE = CAN_IDE_STD;")
+			lines.append ("\tframe->SID = 0x%X;" % message.id)
+		lines.append ("\tframe->RTR = CAN_RTR_DATA;")
+		lines.append ("\tframe->DLC = %d;" % message.dlc)
+		lines.append ("\tframe->data64 [0] = payload;")
+		lines.append ("}")
+
+	return "\n".join (lines)
+
+# Entrypoint -------------------------------------------------------------------------------------------------------------------
+
+def main ():
+	parser = argparse.ArgumentParser (description = "Generates a CAN node from a DBC file.")
+	parser.add_argument ("dbc", help = "The DBC file to generate from.")
+	parser.add_argument ("output", help = "The directory to write the generated files into.")
+	parser.add_argument ("--node", help = "The DBC node to generate. Defaults to the DBC file's name.")
+	parser.add_argument ("--name", help = "The name of the generated files. Defaults to the DBC file's name.")
+	parser.add_argument ("--prefix", help = "The prefix of the generated types and functions. Defaults to the file name in camel case.")
+	args = parser.parse_args ()
+
+	dbcName = os.path.basename (args.dbc)
+	stem = os.path.splitext (dbcName) [0]
+	node = args.node if args.node != None else stem
+	name = args.name if args.name != None else "dbc_" + stem
+	prefix = args.prefix if args.prefix != None else camelCase (name)
+
+	messages = parseDbc (args.dbc)
+
+	rxMessages = []
+	txMessages = []
+	for message in messages:
+		if any (signal.multiplexed for signal in message.signals):
+			print ("Warning: Skipping message '%s', multiplexed signals are not supported." % message.name, file = sys.stderr)
+			continue
+
+		if any (signal.length > 32 for signal in message.signals):
+			print ("Warning: Skipping message '%s', signals longer than 32 bits are not supported." % message.name,
+				file = sys.stderr)
+			continue
+
+		if message.transmitter.lower () == node.lower ():
+			rxMessages.append (message)
+		elif any (node.lower () in [receiver.lower () for receiver in signal.receivers] for signal in message.signals):
+			txMessages.append (message)
+
+	if len (rxMessages) == 0:
+		print ("Error: Node '%s' does not transmit any messages in '%s'." % (node, dbcName), file = sys.stderr)
+		return 1
+
+	if len (rxMessages) > 64:
+		print ("Error: Node '%s' transmits more than 64 messages." % node, file = sys.stderr)
+		return 1
+
+	error = nameFields (rxMessages)
+	for message in txMessages:
+		if error == None:
+			error = nameParameters (message)
+	if error != None:
+		print ("Error: %s" % error, file = sys.stderr)
+		return 1
+
+	os.makedirs (args.output, exist_ok = True)
+	with open (os.path.join (args.output, name + ".h"), "w") as file:
+		file.write (generateHeader (dbcName, name, prefix, rxMessages, txMessages))
+	with open (os.path.join (args.output, name + ".c"), "w") as file:
+		file.write (generateSource (name, prefix, rxMessages, txMessages))
+
+	return 0
+
+if __name__ == "__main__":
+	sys.exit (main ())
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+
+# EEPROM CAN Client ------------------------------------------------------------------------------------------------------------
+#
+# Author: Cole Barach
+# Date Created: 2026.10.16
+#
+# Description: Reads and writes EEPROM images using the bulk commands and streaming sessions of the eeprom_can module (see
+#   src/can/eeprom_can.h). Messages are transported using the Linux kernel's ISO-TP sockets, which require the can-isotp
+#   module (included in mainline kernels since 5.10).
+#
+# Usage:
+#   eeprom_can.py <interface> <command id> <response id> read <address> <count> <file>
+#   eeprom_can.py <interface> <command id> <response id> write <address> <file> [--block-size <bytes>]
+#
+#   The command and response IDs are those of the device's ISO-TP link (rxId and txId, respectively). IDs greater than 0x7FF
+#   are treated as extended IDs.
+
+import argparse
+import socket
+import struct
+import sys
+import zlib
+
+# Protocol ---------------------------------------------------------------------------------------------------------------------
+
+COMMAND_READ	= 0x01
+COMMAND_OPEN	= 0x03
+COMMAND_BLOCK	= 0x04
+COMMAND_COMMIT	= 0x05
+COMMAND_ABORT	= 0x06
+
+STATUS_NAMES = {
+	0x00: "Success",
+	0x01: "Failure",
+	0x02: "CRC-32 mismatch",
+	0x03: "Unexpected sequence number",
+	0x04: "No session open"
+}
+
+# Number of times a block is re-sent before the transfer is aborted.
+BLOCK_RETRY_COUNT = 3
+
+class EepromCanError (Exception):
+	pass
+
+class EepromCanClient:
+	def __init__ (self, interface, commandId, responseId, timeout):
+		def canId (id):
+			return (id | socket.CAN_EFF_FLAG) if id > 0x7FF else id
+
+		self.timeout = timeout
+		self.socket = socket.socket (socket.AF_CAN, socket.SOCK_DGRAM, socket.CAN_ISOTP)
+		self.socket.settimeout (timeout)
+		self.socket.bind ((interface, canId (responseId), canId (commandId)))
+
+	def drain (self):
+		"""Discards any queued responses, ex. the late response to a command that timed out."""
+		self.socket.setblocking (False)
+		try:
+			while True:
+				self.socket.recv (8192)
+		except BlockingIOError:
+			pass
+		finally:
+			self.socket.settimeout (self.timeout)
+
+	def request (self, command, sequence = None):
+		"""Sends a command and receives its response. If a sequence number is specified, responses not echoing it (late
+		responses to previous blocks) are discarded."""
+		self.drain ()
+		self.socket.send (command)
+		while True:
+			response = self.socket.recv (8192)
+			if len (response) < 6 or response [0] != command [0]:
+				raise EepromCanError ("Invalid response to command 0x%02X." % command [0])
+			if sequence == None or struct.unpack_from ("<H", response, 2) [0] == sequence:
+				return response [1], response
+
+	def check (self, status, action):
+		if status != 0:
+			raise EepromCanError ("%s failed: %s." % (action, STATUS_NAMES.get (status, "Unknown status 0x%02X" % status)))
+
+	def read (self, address, count):
+		status, response = self.request (struct.pack ("<BHH", COMMAND_READ, address, count))
+		self.check (status, "Read")
+		return response [6:]
+
+	def write (self, address, image, blockSize):
+		status, _ = self.request (struct.pack ("<BHH", COMMAND_OPEN, address, len (image)))
+		self.check (status, "Opening the session")
+
+		try:
+			for sequence, offset in enumerate (range (0, len (image), blockSize)):
+				block = image [offset : offset + blockSize]
+				command = struct.pack ("<BHI", COMMAND_BLOCK, sequence & 0xFFFF, zlib.crc32 (block)) + block
+
+				# Re-send the block if it was corrupted in transit, or its response was lost. Note the response must echo the
+				# block's sequence number, such that a late response to a previous attempt cannot acknowledge this block.
+				for attempt in range (BLOCK_RETRY_COUNT):
+					try:
+						status, _ = self.request (command, sequence & 0xFFFF)
+					except socket.timeout:
+						status = None
+					if status != 0x02 and status != None:
+						break
+				if status == None:
+					raise EepromCanError ("Block %d timed out." % sequence)
+				self.check (status, "Block %d" % sequence)
+
+			status, response = self.request (struct.pack ("<BI", COMMAND_COMMIT, zlib.crc32 (image)))
+			self.check (status, "Commit (image CRC-32 0x%08X, read back 0x%08X)" % (zlib.crc32 (image),
+				struct.unpack_from ("<I", response, 2) [0]))
+		except:
+			self.socket.send (bytes ([COMMAND_ABORT]))
+			raise
+
+# Entrypoint -------------------------------------------------------------------------------------------------------------------
+
+def main ():
+	parser = argparse.ArgumentParser (description = "Reads and writes EEPROM images over CAN.")
+	parser.add_argument ("interface", help = "The CAN interface to use, ex. can0.")
+	parser.add_argument ("commandId", type = lambda value: int (value, 0), help = "The ID commands are sent with.")
+	parser.add_argument ("responseId", type = lambda value: int (value, 0), help = "The ID responses are received with.")
+	parser.add_argument ("--timeout", type = float, default = 2.0, help = "The response timeout, in seconds.")
+	commands = parser.add_subparsers (dest = "command", required = True)
+
+	read = commands.add_parser ("read", help = "Reads a region of the EEPROM into a file.")
+	read.add_argument ("address", type = lambda value: int (value, 0))
+	read.add_argument ("count", type = lambda value: int (value, 0))
+	read.add_argument ("file")
+
+	write = commands.add_parser ("write", help = "Writes a file into the EEPROM, verifying it.")
+	write.add_argument ("address", type = lambda value: int (value, 0))
+	write.add_argument ("file")
+	write.add_argument ("--block-size", type = int, default = 256,
+		help = "The size of each block, in bytes. Must fit the device's ISO-TP buffer, less the 7 byte block header.")
+
+	args = parser.parse_args ()
+
+	try:
+		client = EepromCanClient (args.interface, args.commandId, args.responseId, args.timeout)
+
+		if args.command == "read":
+			with open (args.file, "wb") as file:
+				file.write (client.read (args.address, args.count))
+		else:
+			with open (args.file, "rb") as file:
+				client.write (args.address, file.read (), args.block_size)
+	except (EepromCanError, OSError) as error:
+		print ("Error: %s" % error, file = sys.stderr)
+		return 1
+
+	return 0
+
+if __name__ == "__main__":
+	sys.exit (main ())